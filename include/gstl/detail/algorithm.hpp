@@ -30,9 +30,20 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 
 #include <gstl/utility>
 #include <gstl/iterator>
+#include <gstl/detail/iterator_unwrap.hpp>
+#include <string.h>
 
 #include <gstl/detail/boost_warnings_off.hpp>
 #include <boost/concept_check.hpp>
+#include <boost/move/move.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/type_traits/remove_pointer.hpp>
+#include <boost/type_traits/has_trivial_assign.hpp>
 #include <gstl/detail/boost_warnings_on.hpp>
 
 namespace gstl
@@ -46,6 +57,74 @@ page 577
 */
 	namespace detail
 	{
+		//////////////////////////////////////////////////////////////////////////
+		//Traits of the raw pointer kernels, see iterator_unwrapper
+		
+		/**
+		   @brief Selects memmove in copy, the same trivially assignable items
+		*/
+		template<class InIt, class OutIt>
+		struct is_memmove_copyable
+			:public boost::mpl::false_
+		{};
+
+		template<class T>
+		struct is_memmove_copyable<T*, T*>
+			:public boost::has_trivial_assign<T>
+		{};
+
+		template<class T>
+		struct is_memmove_copyable<const T*, T*>
+			:public boost::has_trivial_assign<T>
+		{};
+
+		/**
+		   @brief Selects memcmp in equal, the same integral or pointer items
+		   @details Floating point items can't be compared bitwise: -0.0 == 0.0, NaN != NaN
+		*/
+		template<class It1, class It2>
+		struct is_memcmp_comparable
+			:public boost::mpl::false_
+		{};
+
+		template<class T1, class T2>
+		struct is_memcmp_comparable<T1*, T2*>
+			:public boost::mpl::and_<
+				boost::is_same< typename boost::remove_cv<T1>::type, typename boost::remove_cv<T2>::type >,
+				boost::mpl::bool_< boost::is_integral<T1>::value || boost::is_pointer<T1>::value >
+			>
+		{};
+
+		/**
+		   @brief Selects memcmp in lexicographical_compare, memcmp compares unsigned bytes
+		*/
+		template<class It1, class It2>
+		struct is_memcmp_ordered
+			:public boost::mpl::false_
+		{};
+
+		template<class T1, class T2>
+		struct is_memcmp_ordered<T1*, T2*>
+			:public boost::mpl::and_<
+				boost::is_same< typename boost::remove_cv<T1>::type, unsigned char >,
+				boost::is_same< typename boost::remove_cv<T2>::type, unsigned char >
+			>
+		{};
+
+		/**
+		   @brief Selects memchr and memset, byte items and integral value
+		*/
+		template<class It, class T>
+		struct is_byte_range
+			:public boost::mpl::false_
+		{};
+
+		template<class Item, class T>
+		struct is_byte_range<Item*, T>
+			:public boost::mpl::bool_< sizeof( Item ) == 1 
+				&& boost::is_integral<Item>::value && boost::is_integral<T>::value >
+		{};
+
 		template<class RanIt1, class RanIt2, class Pred>
 		RanIt1 find_end( RanIt1 first1, RanIt1 last1,
 			RanIt2 first2, RanIt2 last2, Pred pred,
@@ -244,6 +323,36 @@ page 577
 		@return		An iterator to the first element in the range that matches value.
 					If no element matches, the function returns last.
 	*/
+	namespace detail
+	{
+		template<class InputIterator, class T>
+		InputIterator find( InputIterator first, InputIterator last,
+			const T& value, boost::mpl::false_ /*byte range*/ )
+		{
+			//Type T is EqualityComparable
+			for( ; first != last && !(*first == value); ++first )
+			{}
+			return first;
+		}
+
+		template<class BytePtr, class T>
+		BytePtr find( BytePtr first, BytePtr last,
+			const T& value, boost::mpl::true_ /*byte range*/ )
+		{
+			typedef typename boost::remove_cv<
+				typename boost::remove_pointer<BytePtr>::type >::type item_type;
+
+			item_type item = static_cast<item_type>( value );
+			if( item != value || first == last )
+			{//Value is out of the item range, it can't be found
+				return last;
+			}
+			const void* result = memchr( first, static_cast<unsigned char>( item ),
+				static_cast<size_t>( last - first ) );
+			return result ? first + ( static_cast<const item_type*>( result ) - first ) : last;
+		}
+	}
+
 	template<class InputIterator, class T>
 	InputIterator find(InputIterator first, InputIterator last,
 		const T& value)
@@ -252,10 +361,11 @@ page 577
 		BOOST_CONCEPT_ASSERT(( boost::EqualityComparable<T> ));
 		GSTL_DEBUG_RANGE( first, last );
 
-		//Type T is EqualityComparable
-		for( ; first != last && !(*first == value); ++first )
-		{}
-		return first;
+		typedef typename detail::iterator_unwrapper<InputIterator>::raw_type raw_type;
+		raw_type raw_first = detail::unwrap_iter( first );
+		return detail::rewrap_iter( first, raw_first,
+			detail::find( raw_first, detail::unwrap_iter( last ), value,
+				typename detail::is_byte_range<raw_type, T>::type() ) );
 	}
 
 	/**
@@ -514,11 +624,37 @@ page 577
 		@return true if all the elements in the range [first1,last1)
 				compare equal to those of the range starting at first2, and false otherwise. 
 	*/
+	template <class InputIterator1, class InputIterator2, class BinaryPredicate>
+	bool equal( InputIterator1 first1, InputIterator1 last1,
+		InputIterator2 first2, BinaryPredicate pred );
+
+	namespace detail
+	{
+		template<class InputIterator1, class InputIterator2>
+		bool equal( InputIterator1 first1, InputIterator1 last1,
+			InputIterator2 first2, boost::mpl::false_ /*memcmp comparable*/ )
+		{
+			return gstl::equal( first1, last1, first2, 
+				std::equal_to<GSTL_ITER_VALUE_TYPE( InputIterator1 )>() );
+		}
+
+		template<class T1, class T2>
+		bool equal( T1* first1, T1* last1, T2* first2, boost::mpl::true_ /*memcmp comparable*/ )
+		{
+			return first1 == last1 
+				|| memcmp( first1, first2, static_cast<size_t>( last1 - first1 ) * sizeof( T1 ) ) == 0;
+		}
+	}
+
 	template<class InputIterator1, class InputIterator2>
 	bool equal( InputIterator1 first1, InputIterator1 last1,
 		InputIterator2 first2 )
 	{
-		return gstl::equal( first1, last1, first2, std::equal_to<GSTL_ITER_VALUE_TYPE( InputIterator1 )>() );
+		typedef typename detail::iterator_unwrapper<InputIterator1>::raw_type raw_type1;
+		typedef typename detail::iterator_unwrapper<InputIterator2>::raw_type raw_type2;
+		return detail::equal( detail::unwrap_iter( first1 ), detail::unwrap_iter( last1 ),
+			detail::unwrap_iter( first2 ),
+			typename detail::is_memcmp_comparable<raw_type1, raw_type2>::type() );
 	}
 
 	/**
@@ -636,15 +772,42 @@ page 577
 
 	// 25.2, modifying sequence operations:
 	// 25.2.1, copy:
+	namespace detail
+	{
+		template<class InputIterator, class OutputIterator>
+		OutputIterator copy( InputIterator first, InputIterator last,
+			OutputIterator dest, boost::mpl::false_ /*memmove copyable*/ )
+		{
+			for( ; first != last; ++first, ++dest )
+			{
+				*dest = *first;
+			}
+			return dest;
+		}
+
+		template<class SrcPtr, class T>
+		T* copy( SrcPtr first, SrcPtr last, T* dest, boost::mpl::true_ /*memmove copyable*/ )
+		{
+			size_t count = static_cast<size_t>( last - first );
+			if( count )
+			{
+				memmove( dest, first, count * sizeof( T ) );
+			}
+			return dest + count;
+		}
+	}
+
 	template<class InputIterator, class OutputIterator>
 	OutputIterator copy(InputIterator first, InputIterator last,
 		OutputIterator dest)
 	{
-		for( ; first != last; ++first, ++dest )
-		{
-			*dest = *first;
-		}
-		return dest;
+		typedef typename detail::iterator_unwrapper<InputIterator>::raw_type raw_input_type;
+		typedef typename detail::iterator_unwrapper<OutputIterator>::raw_type raw_output_type;
+
+		raw_output_type raw_dest = detail::unwrap_iter( dest );
+		return detail::rewrap_iter( dest, raw_dest,
+			detail::copy( detail::unwrap_iter( first ), detail::unwrap_iter( last ), raw_dest,
+				typename detail::is_memmove_copyable<raw_input_type, raw_output_type>::type() ) );
 	}
 
 	template<class BidirectionalIterator1, class BidirectionalIterator2>
@@ -664,9 +827,9 @@ page 577
 	{
 		if( &lhs != &rhs )
 		{
-			T tmp = lhs;
-			lhs = rhs;
-			rhs = tmp;
+			T tmp( ::boost::move( lhs ) );
+			lhs = ::boost::move( rhs );
+			rhs = ::boost::move( tmp );
 		}
 	}
 
@@ -716,16 +879,39 @@ page 577
 	OutputIterator replace_copy_if( Iterator first, Iterator last,
 		OutputIterator result, Predicate pred, const T& new_value );
 
-	template<class ForwardIterator, class T>
-	void fill(ForwardIterator first, ForwardIterator last, const T& value)
+	namespace detail
 	{
-		while( first != last )  
+		template<class ForwardIterator, class T>
+		void fill( ForwardIterator first, ForwardIterator last,
+			const T& value, boost::mpl::false_ /*byte range*/ )
 		{
-			*first = value;
-			++first;
+			while( first != last )  
+			{
+				*first = value;
+				++first;
+			}
+		}
+
+		template<class BytePtr, class T>
+		void fill( BytePtr first, BytePtr last, const T& value, boost::mpl::true_ /*byte range*/ )
+		{
+			typedef typename boost::remove_pointer<BytePtr>::type item_type;
+			if( first != last )
+			{
+				memset( first, static_cast<unsigned char>( static_cast<item_type>( value ) ),
+					static_cast<size_t>( last - first ) );
+			}
 		}
 	}
 
+	template<class ForwardIterator, class T>
+	void fill(ForwardIterator first, ForwardIterator last, const T& value)
+	{
+		typedef typename detail::iterator_unwrapper<ForwardIterator>::raw_type raw_type;
+		detail::fill( detail::unwrap_iter( first ), detail::unwrap_iter( last ), value,
+			typename detail::is_byte_range<raw_type, T>::type() );
+	}
+
 	template<class OutputIterator, class Size, class T>
 	void fill_n(OutputIterator first, Size n, const T& value)
 	{
@@ -1024,6 +1210,33 @@ page 577
 	ForwardIterator max_element( ForwardIterator first, ForwardIterator last,
 		Compare comp );
 
+	template<class InputIterator1, class InputIterator2, class Compare>
+	bool lexicographical_compare( InputIterator1 first1, InputIterator1 last1,
+		InputIterator2 first2, InputIterator2 last2,
+		Compare comp );
+
+	namespace detail
+	{
+		template<class InputIterator1, class InputIterator2>
+		bool lexicographical_compare( InputIterator1 first1, InputIterator1 last1,
+			InputIterator2 first2, InputIterator2 last2, boost::mpl::false_ /*memcmp ordered*/ )
+		{
+			return gstl::lexicographical_compare( first1, last1, first2, last2, 
+				std::less<GSTL_ITER_VALUE_TYPE( InputIterator1 )>() );
+		}
+
+		template<class T1, class T2>
+		bool lexicographical_compare( T1* first1, T1* last1,
+			T2* first2, T2* last2, boost::mpl::true_ /*memcmp ordered*/ )
+		{
+			size_t len1 = static_cast<size_t>( last1 - first1 );
+			size_t len2 = static_cast<size_t>( last2 - first2 );
+			size_t len = len1 < len2 ? len1 : len2;
+			int result = len ? memcmp( first1, first2, len ) : 0;
+			return result < 0 || ( result == 0 && len1 < len2 );
+		}
+	}
+
 	template<class InputIterator1, class InputIterator2>
 	bool lexicographical_compare( InputIterator1 first1, InputIterator1 last1,
 		InputIterator2 first2, InputIterator2 last2 )
@@ -1031,8 +1244,13 @@ page 577
 		BOOST_CONCEPT_ASSERT(( boost::LessThanOp< 
 			GSTL_ITER_VALUE_TYPE( InputIterator1 ),
 			GSTL_ITER_VALUE_TYPE( InputIterator2 )> ));
-		return gstl::lexicographical_compare( first1, last1, first2, last2, 
-			std::less<GSTL_ITER_VALUE_TYPE( InputIterator1 )>() );
+
+		typedef typename detail::iterator_unwrapper<InputIterator1>::raw_type raw_type1;
+		typedef typename detail::iterator_unwrapper<InputIterator2>::raw_type raw_type2;
+		return detail::lexicographical_compare( 
+			detail::unwrap_iter( first1 ), detail::unwrap_iter( last1 ),
+			detail::unwrap_iter( first2 ), detail::unwrap_iter( last2 ),
+			typename detail::is_memcmp_ordered<raw_type1, raw_type2>::type() );
 	}
 
 	/**
@@ -1099,4 +1317,7 @@ page 577
 }
 
 //#pragma warning(pop)
+//Definitions of the sorting algorithms declared above
+#include <gstl/detail/sort.hpp>
+
 #endif //GSTL_ALGORITHM_HEADER
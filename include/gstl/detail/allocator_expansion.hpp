@@ -0,0 +1,188 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_ALLOCATOR_EXPANSION_HEADER
+#define GSTL_ALLOCATOR_EXPANSION_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <gstl/detail/assert.hpp>
+
+#include <gstl/detail/boost_warnings_off.hpp>
+#include <boost/mpl/bool.hpp>
+#include <gstl/detail/boost_warnings_on.hpp>
+
+namespace gstl
+{
+	namespace detail
+	{
+		typedef char (&yes_type)[1];
+		typedef char (&no_type)[2];
+
+		/**
+		   @brief Detects bool Alloc::try_expand( pointer ptr, size_type old_n, size_type new_n )
+		*/
+		template<class Alloc>
+		struct has_try_expand
+		{
+			template<class U, bool (U::*)( typename U::pointer, 
+				typename U::size_type, typename U::size_type )>
+			struct check;
+
+			template<class U>
+			static yes_type test( check<U, &U::try_expand>* );
+
+			template<class U>
+			static no_type test( ... );
+
+			enum{ value = sizeof( test<Alloc>( 0 ) ) == sizeof( yes_type ) };
+			typedef boost::mpl::bool_<value> type;
+		};
+
+		/**
+		   @brief Detects pointer Alloc::allocate_at_least( size_type n, size_type& allocated )
+		*/
+		template<class Alloc>
+		struct has_allocate_at_least
+		{
+			template<class U, typename U::pointer (U::*)( typename U::size_type, 
+				typename U::size_type& )>
+			struct check;
+
+			template<class U>
+			static yes_type test( check<U, &U::allocate_at_least>* );
+
+			template<class U>
+			static no_type test( ... );
+
+			enum{ value = sizeof( test<Alloc>( 0 ) ) == sizeof( yes_type ) };
+			typedef boost::mpl::bool_<value> type;
+		};
+
+		/**
+		   @brief Detects pointer Alloc::reallocate( pointer ptr, size_type old_n, size_type new_n )
+		*/
+		template<class Alloc>
+		struct has_reallocate
+		{
+			template<class U, typename U::pointer (U::*)( typename U::pointer,
+				typename U::size_type, typename U::size_type )>
+			struct check;
+
+			template<class U>
+			static yes_type test( check<U, &U::reallocate>* );
+
+			template<class U>
+			static no_type test( ... );
+
+			enum{ value = sizeof( test<Alloc>( 0 ) ) == sizeof( yes_type ) };
+			typedef boost::mpl::bool_<value> type;
+		};
+	}
+
+	/**
+	   @brief Optional allocator extensions used by the dynamic buffers
+	   @details Allocator can provide the following methods, they are detected at compile time:
+		- bool try_expand( pointer ptr, size_type old_n, size_type new_n ) - tries to enlarge
+		the block ptr of old_n items in place, so it can hold new_n items. 
+		Returns false if the block can't be expanded, the block is left untouched in this case.
+		- pointer allocate_at_least( size_type n, size_type& allocated ) - allocates block 
+		of at least n items and stores the real number of items into allocated.
+		- pointer reallocate( pointer ptr, size_type old_n, size_type new_n ) - moves the block
+		ptr of old_n items into the block of new_n items, the content is moved bitwise, 
+		e.g. by remapping of pages. Returns null pointer if the block can't be moved,
+		the block is left untouched in this case. Used only for bitwise relocatable items.
+		
+		Specialize this class for the allocators, which have such functionality 
+		under the different names, e.g. for memory-mgr segment managers.
+	*/
+	template<class Alloc>
+	struct allocator_expansion
+	{
+		typedef typename Alloc::pointer		pointer;
+		typedef typename Alloc::size_type	size_type;
+
+		static bool try_expand( Alloc& alloc, pointer ptr, size_type old_n, size_type new_n )
+		{
+			return try_expand( alloc, ptr, old_n, new_n,
+				typename detail::has_try_expand<Alloc>::type() );
+		}
+
+		static pointer allocate_at_least( Alloc& alloc, size_type n, size_type& allocated )
+		{
+			return allocate_at_least( alloc, n, allocated,
+				typename detail::has_allocate_at_least<Alloc>::type() );
+		}
+
+		static pointer reallocate( Alloc& alloc, pointer ptr, size_type old_n, size_type new_n )
+		{
+			return reallocate( alloc, ptr, old_n, new_n,
+				typename detail::has_reallocate<Alloc>::type() );
+		}
+
+	private:
+		static bool try_expand( Alloc& alloc, pointer ptr, size_type old_n, size_type new_n,
+			boost::mpl::true_ /*has try_expand*/ )
+		{
+			return alloc.try_expand( ptr, old_n, new_n );
+		}
+
+		static bool try_expand( Alloc& /*alloc*/, pointer /*ptr*/, size_type /*old_n*/,
+			size_type /*new_n*/, boost::mpl::false_ /*has try_expand*/ )
+		{
+			return false;
+		}
+
+		static pointer allocate_at_least( Alloc& alloc, size_type n, size_type& allocated,
+			boost::mpl::true_ /*has allocate_at_least*/ )
+		{
+			pointer ptr = alloc.allocate_at_least( n, allocated );
+			GSTL_ASSERT( allocated >= n && "allocator returned too small block" );
+			return ptr;
+		}
+
+		static pointer allocate_at_least( Alloc& alloc, size_type n, size_type& allocated,
+			boost::mpl::false_ /*has allocate_at_least*/ )
+		{
+			pointer ptr = alloc.allocate( n );
+			allocated = n;
+			return ptr;
+		}
+
+		static pointer reallocate( Alloc& alloc, pointer ptr, size_type old_n, size_type new_n,
+			boost::mpl::true_ /*has reallocate*/ )
+		{
+			return alloc.reallocate( ptr, old_n, new_n );
+		}
+
+		static pointer reallocate( Alloc& /*alloc*/, pointer /*ptr*/, size_type /*old_n*/,
+			size_type /*new_n*/, boost::mpl::false_ /*has reallocate*/ )
+		{
+			return pointer();
+		}
+	};
+}
+
+#endif //GSTL_ALLOCATOR_EXPANSION_HEADER
@@ -34,9 +34,12 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 #include <gstl/iterator>
 #include <gstl/allocator>
 #include <gstl/detail/char_traits.hpp>
+#include <gstl/detail/basic_string_view.hpp>
+#include <gstl/detail/string_concat.hpp>
 #include <gstl/detail/dynamic_buffer.hpp>
 #include <gstl/detail/container_helpers.hpp>
 #include <boost/bind.hpp>
+#include <boost/move/move.hpp>
 #include <boost/mpl/or.hpp>
 
 #pragma warning (disable: 4100)
@@ -56,15 +59,22 @@ namespace gstl
 			<
 				class CharT,
 				class Traits,
-				class Alloc
+				class Alloc,
+				class GrowthPolicy
 			>
 		class string_base
-			:public detail::dynamic_buffer<CharT, Alloc, Traits>
+			:public detail::dynamic_buffer<CharT, Alloc, Traits, GrowthPolicy>
 		{
 		public:
-			enum{ min_buff_size = 4 };
+			enum{ min_buff_size = GrowthPolicy::min_capacity };
 
-			typedef detail::dynamic_buffer<CharT, Alloc, Traits>	base_type;
+			/**
+			   @brief Size of the local buffer in characters, including the terminator
+			*/
+			enum{ local_capacity = ( 16 / sizeof( CharT ) ) > 2 ? ( 16 / sizeof( CharT ) ) : 2 };
+
+			typedef string_base												self_type;
+			typedef detail::dynamic_buffer<CharT, Alloc, Traits, GrowthPolicy>	base_type;
 
 			typedef CharT									value_type;
 			typedef Traits									traits_type;
@@ -79,11 +89,23 @@ namespace gstl
 			typedef typename base_type::size_type			size_type;
 			typedef typename base_type::difference_type		difference_type;
 									
+			/**
+			   @brief Constructs empty string in the local buffer, nothing is allocated
+			*/
 			string_base( const allocator_type& alloc = allocator_type() )
 				:base_type( alloc )
 			{
-				reserve( min_buff_size );
-				set_end(0);
+				_reset_to_local();
+			}
+
+			~string_base()
+			{
+				if( is_local() )
+				{
+					//Prevent freeing of the local buffer
+					buffer_ = pointer();
+					reserved_ = 0;
+				}
 			}
 
 			void set_end( size_type n )
@@ -94,9 +116,117 @@ namespace gstl
 			
 			void reset_ptr( pointer new_str, size_type new_size, size_type new_reserved )
 			{
-				base_type::reset_buffer( new_str, new_size, new_reserved );
+				reset_buffer( new_str, new_size, new_reserved );
 				set_end( new_size );
 			}
+
+			/**
+			   @brief Replaces the buffer, frees the old one unless it is the local buffer
+			*/
+			void reset_buffer( pointer new_buffer, size_type new_size, size_type new_reserved )
+			{
+				if( is_local() )
+				{
+					buffer_ = pointer();
+					reserved_ = 0;
+				}
+				base_type::reset_buffer( new_buffer, new_size, new_reserved );
+			}
+
+			/**
+			   @brief Reserves at least requested_capacity characters, the terminator is moved as well
+			*/
+			void reserve( size_type requested_capacity = 0 )
+			{
+				if( requested_capacity >= max_size() )
+				{
+					throw_length_error();
+				}
+				if( requested_capacity > reserved_ && !try_expand( requested_capacity ) )
+				{
+					size_type new_reserved = grown_capacity( requested_capacity );
+					if( !is_local() && base_type::try_reallocate( new_reserved ) )
+					{
+						return;
+					}
+					pointer new_buffer = expansion_type::allocate_at_least( alloc_,
+						new_reserved, new_reserved );
+					traits_type::move( &*new_buffer, get_buffer(), size_ + 1 );
+					reset_buffer( new_buffer, size_, new_reserved );
+				}
+			}
+
+			/**
+			   @brief Expands heap buffer in place, the local buffer can't be expanded
+			*/
+			bool try_expand( size_type requested_capacity )
+			{
+				return requested_capacity <= reserved_
+					|| ( !is_local() && base_type::try_expand( requested_capacity ) );
+			}
+
+			/**
+			   @brief Swaps heap buffers, local strings are copied
+			*/
+			void swap( self_type& rhs )
+			{
+				if( this == &rhs )
+				{
+					return;
+				}
+				if( !is_local() && !rhs.is_local() )
+				{
+					base_type::swap( rhs );
+				}
+				else
+				{
+					self_type tmp( alloc_ );
+					tmp._take( *this );
+					_take( rhs );
+					rhs._take( tmp );
+				}
+			}
+
+			/**
+			   @brief Checks whether the characters are stored inside the object
+			*/
+			bool is_local() const
+			{
+				return get_buffer() == local_;
+			}
+
+		private:
+			string_base( const self_type& );
+			self_type& operator=( const self_type& );
+
+			void _reset_to_local()
+			{
+				buffer_ = pointer( local_ );
+				reserved_ = local_capacity;
+				set_end( 0 );
+			}
+
+			//Moves characters of the src into this empty local string, src is left empty
+			void _take( self_type& src )
+			{
+				GSTL_ASSERT( is_local() && !size_ );
+				alloc_ = src.alloc_;
+				if( src.is_local() )
+				{
+					traits_type::copy( local_, src.local_, src.size_ + 1 );
+					size_ = src.size_;
+					src.set_end( 0 );
+				}
+				else
+				{
+					buffer_ = src.buffer_;
+					size_ = src.size_;
+					reserved_ = src.reserved_;
+					src._reset_to_local();
+				}
+			}
+
+			value_type local_[local_capacity];
 		};
 
 	}
@@ -105,12 +235,13 @@ namespace gstl
 	<
 		class CharT,
 		class Traits = char_traits<CharT>,
-		class Alloc = allocator<CharT>
+		class Alloc = allocator<CharT>,
+		class GrowthPolicy = default_growth_policy
 	>
 	class basic_string
-		:private detail::string_base<CharT, Traits, Alloc>
+		:private detail::string_base<CharT, Traits, Alloc, GrowthPolicy>
 	{
-		typedef detail::string_base<CharT, Traits, Alloc> base_type;
+		typedef detail::string_base<CharT, Traits, Alloc, GrowthPolicy> base_type;
 	public:
 		//////////////////////////////////////////////////////////////////////////
 		// types:
@@ -141,6 +272,9 @@ namespace gstl
 		typedef gstl::reverse_iterator<iterator> reverse_iterator;
 		typedef gstl::reverse_iterator<const_iterator> const_reverse_iterator;
 		static const size_type npos = static_cast<size_type>( -1 );
+
+		typedef gstl::basic_string_view<value_type, traits_type>	string_view_type;
+		typedef typename string_view_type::searcher_type			searcher_type;
 		
 		// 21.3.1 construct/copy/destroy:
 		/**
@@ -177,6 +311,17 @@ namespace gstl
 			assign( str, 0, npos );
 		}
 
+		/**
+		   @brief Move constructor, takes ownership of the str buffer
+		   @details str is left empty
+		*/
+		basic_string( BOOST_RV_REF( basic_string ) str )
+			:base_type( str.get_allocator() )
+		{
+			basic_string& src = str;
+			base_type::swap( src );
+		}
+
 		/**
 		   @brief the same as basic_string(const basic_string& str)
 		*/
@@ -200,6 +345,15 @@ namespace gstl
 			assign( s );
 		}
 
+		/**
+		   @brief Constructs a copy of the characters referred by the view
+		*/
+		explicit basic_string(string_view_type sv, const allocator_type& alloc = allocator_type())
+			:base_type( alloc )
+		{
+			assign( sv.data(), sv.size() );
+		}
+
 		basic_string(size_type n, value_type c, const allocator_type& alloc = allocator_type())
 			:base_type( alloc )
 		{
@@ -223,11 +377,22 @@ namespace gstl
 		~basic_string()
 		{}
 
-		basic_string& operator=(const basic_string& str)
+		basic_string& operator=( BOOST_COPY_ASSIGN_REF( basic_string ) str )
 		{
 			return assign( str );
 		}
 
+		basic_string& operator=( BOOST_RV_REF( basic_string ) str )
+		{
+			basic_string& src = str;
+			if( this != &src )
+			{
+				clear();
+				base_type::swap( src );
+			}
+			return *this;
+		}
+
 		basic_string& operator=(const value_type* s)
 		{
 			return assign( s );
@@ -295,6 +460,22 @@ namespace gstl
 			resize( n, value_type() );
 		}
 
+		/**
+		   @brief Resizes the string without initialization of the new characters
+		   @details Only the terminator is written. Useful when the string is
+			a landing buffer for read() and the new characters are overwritten anyway.
+		   @exception std::length_error if n exceeds max_size()
+		*/
+		void resize_default_init( size_type n )
+		{
+			if( n >= max_size() )
+			{
+				base_type::throw_length_error();
+			}
+			base_type::reserve( n + 1 );
+			base_type::set_end( n );
+		}
+
 		using base_type::get_allocator;
 		using base_type::max_size;
 		using base_type::size;
@@ -328,6 +509,11 @@ namespace gstl
 			return append( 1, c );
 		}
 
+		basic_string& operator+=(string_view_type sv)
+		{
+			return append( sv );
+		}
+
 		basic_string& append(const basic_string& str)
 		{
 			return append( str, 0, npos );
@@ -348,6 +534,11 @@ namespace gstl
 			return *this;
 		}
 
+		basic_string& append(string_view_type sv)
+		{
+			return append( sv.data(), sv.size() );
+		}
+
 		basic_string& append(const value_type* s)
 		{
 			insert( end(), s, s + traits_type::length( s ) );
@@ -390,15 +581,16 @@ namespace gstl
 			GSTL_ASSERT( s != 0 );
 			GSTL_ASSERT( n < npos );
 
-			set_end( 0 );
-			insert( 0, s, n );
-			return *this;
+			//s may point into this string, so the old characters are replaced, not cleared first
+			return replace( begin(), end(), s, s + n );
 		}
 		basic_string& assign(const value_type* s)
 		{
-			set_end( 0 );
-			insert( 0, s );
-			return *this;
+			return assign( s, traits_type::length( s ) );
+		}
+		basic_string& assign(string_view_type sv)
+		{
+			return assign( sv.data(), sv.size() );
 		}
 		basic_string& assign(size_type n, value_type c)
 		{
@@ -410,9 +602,7 @@ namespace gstl
 		template<class InputIterator>
 		basic_string& assign(InputIterator first, InputIterator last)
 		{
-			set_end( 0 );
-			insert( begin(), first, last );
-			return *this;
+			return replace( begin(), end(), first, last );
 		}
 
 		//////////////////////////////////////////////////////////////////////////
@@ -461,6 +651,11 @@ namespace gstl
 			return insert( pos, s, traits_type::length( s ) );
 		}
 
+		basic_string& insert(size_type pos, string_view_type sv)
+		{
+			return insert( pos, sv.data(), sv.size() );
+		}
+
 		basic_string& insert(size_type pos, size_type n, value_type c)
 		{			
 			_verify_pos( pos, *this );
@@ -507,9 +702,8 @@ namespace gstl
 			GSTL_DEBUG_RANGE( first, last );
 			if( first != last )
 			{
-				//TODO: erase chars
-				//size_type rlen = last - first;
-				traits_type::copy( &*first, &*last, end() - last );
+				//The tail is shifted over itself
+				traits_type::move( &*first, &*last, end() - last );
 				set_end( size() - (last - first) );
 			}
 			return last;
@@ -550,6 +744,11 @@ namespace gstl
 			return replace( pos, n1, s, traits_type::length( s ) );
 		}
 
+		basic_string& replace(size_type pos, size_type n1, string_view_type sv)
+		{
+			return replace( pos, n1, sv.data(), sv.size() );
+		}
+
 		basic_string& replace(size_type pos, size_type n1, size_type n2,
 			value_type c)
 		{
@@ -593,13 +792,72 @@ namespace gstl
 			//Length of new str
 			difference_type xlen = gstl::distance( first2, last2 );
 			
-			_do_replace( first, last, xlen, boost::bind( gstl::copy<InputIterator, value_type*>, first2, last2, _1 ),
-				_check_overlap( first2, last2 ) );
+			if( _check_overlap( first2, last2 ) )
+			{//Source is a part of this string
+				_do_replace_inside( first, last, _as_pointer( first2 ), xlen );
+			}
+			else
+			{
+				_do_replace( first, last, xlen, boost::bind( gstl::copy<InputIterator, value_type*>, first2, last2, _1 ) );
+			}
 			return *this;
 		}
 
+		/**
+		   @brief Replaces [i1, i2) by the characters [s, s + xlen) of this string
+		   @details Works in place with traits_type::move, if the new size fits into the capacity.
+			Otherwise the characters are copied into the new buffer, the source stays valid
+			because the old buffer is freed after that.
+		*/
+		iterator _do_replace_inside( iterator i1, iterator i2, const value_type* s, size_type xlen )
+		{
+			GSTL_DEBUG_RANGE( i1, i2 );
+			const size_type removed_size = i2 - i1;
+			const size_type new_size = size() + xlen - removed_size;
+			if( new_size >= max_size() )
+			{
+				throw_length_error();
+			}
+			if( new_size >= reserved_ && !base_type::try_expand( new_size + 1 ) )
+			{
+				return _do_replace( i1, i2, xlen, boost::bind( &traits_type::copy, _1, s, xlen ) );
+			}
+
+			value_type* p = get_buffer() + ( i1 - begin() );
+			value_type* hole_end = p + removed_size;
+			const size_type tail_size = end() - i2;
+			if( xlen != 0 && xlen <= removed_size )
+			{//Shrinking: the source is copied before the tail moves
+				traits_type::move( p, s, xlen );
+			}
+			if( tail_size != 0 && xlen != removed_size )
+			{
+				traits_type::move( p + xlen, hole_end, tail_size );
+			}
+			if( xlen > removed_size )
+			{//Growing: the part of the source after the hole has been shifted with the tail
+				const size_type shift = xlen - removed_size;
+				if( s + xlen <= hole_end )
+				{
+					traits_type::move( p, s, xlen );
+				}
+				else if( s >= hole_end )
+				{
+					traits_type::copy( p, s + shift, xlen );
+				}
+				else
+				{
+					const size_type head_size = hole_end - s;
+					traits_type::move( p, s, head_size );
+					traits_type::copy( p + head_size, hole_end + shift, xlen - head_size );
+				}
+			}
+			set_end( new_size );
+			return iter_helper::build_iter( p + xlen, this );
+		}
+
 		template<class PutNew>
-		iterator _do_replace( iterator i1, iterator i2, difference_type xlen, PutNew put_new_fn, bool overlaped = false )
+		iterator _do_replace( iterator i1, iterator i2, difference_type xlen, PutNew put_new_fn )
 		{
 			GSTL_DEBUG_RANGE( i1, i2 );
 			difference_type pos1 = i1 - begin();
@@ -608,13 +866,16 @@ namespace gstl
 			size_type new_size = size() + xlen - removed_size;
 
 			pointer new_str;
-			if( new_size >= reserved_ || overlaped )
+			size_type new_reserved = reserved_;
+			if( new_size >= max_size() )
+			{
+				throw_length_error();
+			}
+			if( new_size >= reserved_ && !base_type::try_expand( new_size + 1 ) )
 			{//New string will be larger than current
-				if( new_size >= max_size() )
-				{
-					throw_length_error();
-				}
-				new_str = alloc_.allocate( new_size + 1 );
+				new_reserved = base_type::grown_capacity( new_size + 1 );
+				new_str = base_type::expansion_type::allocate_at_least( alloc_,
+					new_reserved, new_reserved );
 				//Copy to the new string [begin, i1) chars 
 				traits_type::move( &*new_str, get_buffer(), pos1 );
 			}
@@ -629,7 +890,7 @@ namespace gstl
 
 			put_new_fn( &*new_i1 );
 
-			reset_ptr( &*new_str, new_size, new_size + 1 );
+			reset_ptr( &*new_str, new_size, new_reserved );
 			return res;
 		}
 
@@ -663,6 +924,11 @@ namespace gstl
 			return find( str.c_str(), pos, str.size() );
 		}
 
+		size_type find (string_view_type sv, size_type pos = 0) const
+		{
+			return find( sv.data(), pos, sv.size() );
+		}
+
 
 		size_type find (const value_type* s, size_type pos = 0) const
 		{
@@ -671,33 +937,17 @@ namespace gstl
 
 		size_type find (const value_type* s, size_type pos, size_type n) const
 		{//Most generic
-			if( n == 0 )
-			{//Null string always matches, if it is inside the string
-				return pos < size_ ? pos : npos;
-			}
- 
- 			size_type sub_size = size_ - pos;
- 			if( pos < size_ && n <= sub_size )
- 			{	
-				//Search for sub string
- 				const value_type* fres_str;
-				const value_type* my_sub_str = get_buffer() + pos;
-				//Truncate search size 
-				sub_size -= n - 1;
- 				while( ( fres_str = traits_type::find( my_sub_str, sub_size, *s ) ) != 0 )
-				{
-					if( traits_type::compare(fres_str, s, n) == 0 )
-					{
-						//Match found
- 						return fres_str - get_buffer();	
-					}
-					sub_size -= fres_str - my_sub_str + 1;
-					my_sub_str = fres_str + 1;
-				}
- 			}
+			return string_view_type( get_buffer(), size_ ).find( s, pos, n );
+		}
 
-			//No match
-			return npos;	
+		/**
+		   @brief Searches for the pattern of the searcher starting at pos
+		   @details Use it to search the same pattern in many strings,
+			the pattern is preprocessed only once
+		*/
+		size_type find (const searcher_type& searcher, size_type pos = 0) const
+		{
+			return string_view_type( get_buffer(), size_ ).find( searcher, pos );
 		}
 
 		size_type find (value_type c, size_type pos = 0) const
@@ -710,35 +960,22 @@ namespace gstl
 			return rfind( str.c_str(), pos, str.size() );
 		}
 
+		size_type rfind(string_view_type sv, size_type pos = npos) const
+		{
+			return rfind( sv.data(), pos, sv.size() );
+		}
+
 		size_type rfind(const value_type* s, size_type pos, size_type n) const
 		{//Most generic
- 			if( n == 0 )
-			{//Null string always matches, if it is inside the string
-				return pos < size_ ? pos : npos;
-			}
-
- 			if( n <= size_ )
- 			{	
-				//Search for sub string in the reverse direction
-				const value_type* fres_str = get_buffer() + (gstl::min)( pos, size_ - n );
-				for( ;; --fres_str )
-				{
- 					if( traits_type::eq( *fres_str, *s )
- 						&& traits_type::compare( fres_str, s, n ) == 0 )
-					{
-						//Match found
-						return fres_str - get_buffer();
-					}
-					if( fres_str == get_buffer() )
-					{
-						//Beginning of the string reached
-						break;
-					}
-				}
- 			}
+			return string_view_type( get_buffer(), size_ ).rfind( s, pos, n );
+		}
 
-			//No match
-			return npos;	
+		/**
+		   @brief Searches backward for the pattern of the searcher starting at or before pos
+		*/
+		size_type rfind(const searcher_type& searcher, size_type pos = npos) const
+		{
+			return string_view_type( get_buffer(), size_ ).rfind( searcher, pos );
 		}
 
 		size_type rfind(const value_type* s, size_type pos = npos) const
@@ -757,25 +994,15 @@ namespace gstl
 			return find_first_of( str.c_str(), pos, str.size() );
 		}
 
+		size_type find_first_of(string_view_type sv, size_type pos = 0) const
+		{
+			return find_first_of( sv.data(), pos, sv.size() );
+		}
+
 		size_type find_first_of(const value_type* s,
 			size_type pos, size_type n) const
 		{
- 			if( n > 0 && pos < size_ )
- 			{	
-				//Search for the first occurrence of any character from s in *this
- 				const value_type *const my_end = get_buffer() + size_;
- 				for( const value_type *curr_pos = get_buffer() + pos; curr_pos < my_end; ++curr_pos )
-				{
-					if( traits_type::find( s, n, *curr_pos ) != 0 )
-					{
-						//Match found
-						return curr_pos - get_buffer();
-					}
-				}
- 			}
-
-			//No match
-			return npos;
+			return string_view_type( get_buffer(), size_ ).find_first_of( s, pos, n );
 		}
 
 		size_type find_first_of(const value_type* s, size_type pos = 0) const
@@ -794,30 +1021,15 @@ namespace gstl
 			return find_last_of( str.c_str(), pos, str.size() );
 		}
 
+		size_type find_last_of (string_view_type sv, size_type pos = npos) const
+		{
+			return find_last_of( sv.data(), pos, sv.size() );
+		}
+
 		size_type find_last_of (const value_type* s,
 			size_type pos, size_type n) const
 		{
-			if( n > 0 && size_ )
-			{
-				//Search for the last occurrence of any character from s in *this
-				const value_type *curr_pos = get_buffer() + (gstl::min)( pos, size_ - 1 );
-				for( ;; --curr_pos )
-				{
-					if( traits_type::find( s, n, *curr_pos ) != 0 )
-					{
-						//Match found
-						return curr_pos - get_buffer();
-					}
- 					if( curr_pos == get_buffer() )
-					{
-						//Beginning of the string reached
-						break;
-					}
-				}
-			}
-
-			//no match
-			return npos;
+			return string_view_type( get_buffer(), size_ ).find_last_of( s, pos, n );
 		}
 
 		size_type find_last_of (const value_type* s, size_type pos = npos) const
@@ -836,26 +1048,15 @@ namespace gstl
 			return find_first_not_of( str.c_str(), pos, str.size() );
 		}
 
+		size_type find_first_not_of(string_view_type sv, size_type pos = 0) const
+		{
+			return find_first_not_of( sv.data(), pos, sv.size() );
+		}
+
 		size_type find_first_not_of(const value_type* s, size_type pos,
 			size_type n) const
 		{
-			if( n > 0 && pos < size_ )
-			{
-				//Search for the first occurrence of any character 
-				//in *this not from s
- 				const value_type *const my_end = get_buffer() + size_;
- 				for( const value_type *curr_pos = get_buffer() + pos; curr_pos < my_end; ++curr_pos )
-				{
-					if( traits_type::find(s, n, *curr_pos) == 0 )
-					{
-						//Match found
-						return curr_pos - get_buffer();
-					}
-				}
- 			}
-
-			//No match
-			return npos;
+			return string_view_type( get_buffer(), size_ ).find_first_not_of( s, pos, n );
 		}
 
 		size_type find_first_not_of(const value_type* s, size_type pos = 0) const
@@ -874,31 +1075,15 @@ namespace gstl
 			return find_last_not_of( str.c_str(), pos, str.size() );
 		}
 
+		size_type find_last_not_of (string_view_type sv, size_type pos = npos) const
+		{
+			return find_last_not_of( sv.data(), pos, sv.size() );
+		}
+
 		size_type find_last_not_of (const value_type* s, size_type pos,
 			size_type n) const
 		{
-			if( n > 0 && size_ )
-			{
-				//Search for the last occurrence of any character 
-				//in *this not from s
-				const value_type *curr_pos = get_buffer() + (gstl::min)( pos, size_ - 1 );
- 				for( ;; --curr_pos )
-				{
-					if( traits_type::find( s, n, *curr_pos ) == 0 )
-					{
-						//Match found
-						return curr_pos - get_buffer();
-					}
- 					if( curr_pos == get_buffer() )
-					{
-						//Beginning of the string reached
-						break;
-					}
-				}
-			}
-
-			//No match
-			return npos;
+			return string_view_type( get_buffer(), size_ ).find_last_not_of( s, pos, n );
 		}
 
 		size_type find_last_not_of (const value_type* s,
@@ -918,6 +1103,24 @@ namespace gstl
 			return basic_string( *this, pos, n, alloc_ ) ;
 		}
 
+		/**
+		   @brief The same as substr, but returns a view of the characters instead of a copy
+		   @details The view is invalidated by any modification of the string
+		*/
+		string_view_type substr_view(size_type pos = 0, size_type n = npos) const
+		{
+			size_type rlen = _validate_pos_and_off( pos, *this, n );
+			return string_view_type( get_buffer() + pos, rlen );
+		}
+
+		/**
+		   @brief Returns view of the whole string
+		*/
+		operator string_view_type() const
+		{
+			return string_view_type( get_buffer(), size_ );
+		}
+
 		int compare(const basic_string& str) const
 		{
 			return compare( 0, size(), str, 0, str.size() );
@@ -937,6 +1140,16 @@ namespace gstl
 			return compare( pos1, n1, str.c_str() + pos2, n2 );
 		}
 
+		int compare(string_view_type sv) const
+		{
+			return compare( 0, size(), sv.data(), sv.size() );
+		}
+
+		int compare(size_type pos1, size_type n1, string_view_type sv) const
+		{
+			return compare( pos1, n1, sv.data(), sv.size() );
+		}
+
 		int compare(const value_type* s) const
 		{
 			return compare( 0, size(), s );
@@ -974,6 +1187,8 @@ namespace gstl
 		}
 
 	private:
+		BOOST_COPYABLE_AND_MOVABLE( basic_string )
+
 		void _verify_pos( size_type pos, const basic_string& str ) const
 		{
 			if( pos > str.size() )
@@ -1044,196 +1259,414 @@ namespace gstl
 			difference_type d = p - get_buffer();
 			return d >= 0 && d < static_cast<difference_type>( size_ );
 		}
+
+		//Only the ranges, for which _check_overlap can return true, are converted
+		template<class InputIterator>
+		static const value_type* _as_pointer( InputIterator )
+		{
+			GSTL_ASSERT( !"source range is not contiguous" );
+			return 0;
+		}
+
+		static const value_type* _as_pointer( const value_type* p )
+		{
+			return p;
+		}
+
+		static const value_type* _as_pointer( value_type* p )
+		{
+			return p;
+		}
+
+		static const value_type* _as_pointer( iterator it )
+		{
+			return &*it;
+		}
+
+		static const value_type* _as_pointer( const_iterator it )
+		{
+			return &*it;
+		}
 	};
 
 
-	template<class value_type, class traits, class allocator_type>
-	basic_string<value_type, traits, allocator_type>
-		operator+(const basic_string<value_type,traits,allocator_type>& lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+	//////////////////////////////////////////////////////////////////////////
+	// 21.3.7.1 operator+:
+	// The result is built by basic_string_concat, so its buffer is allocated once.
+	// The overloads, which take the string by rvalue reference, append to it in place
+	// and return it moved. Longer chains and assignments, which should reuse the capacity
+	// of the destination, are cheaper with basic_string_concat::assign_to and append_to.
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{
-		return basic_string<value_type,traits,allocator_type>( lhs ) += rhs;
+		return basic_string_concat< basic_string<value_type, traits, allocator_type, growth_policy> >( lhs )( rhs )
+			.str( lhs.get_allocator() );
 	}
 
-	template<class value_type, class traits, class allocator_type>
-	basic_string<value_type,traits,allocator_type>
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
 		operator+(const value_type* lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{
-		return basic_string<value_type,traits,allocator_type>( lhs ) += rhs;
+		return basic_string_concat< basic_string<value_type, traits, allocator_type, growth_policy> >( lhs )( rhs )
+			.str( rhs.get_allocator() );
 	}
 
-	template<class value_type, class traits, class allocator_type>
-	basic_string<value_type,traits,allocator_type>
-		operator+(value_type lhs, const basic_string<value_type,traits,allocator_type>& rhs)
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(value_type lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{
-		return basic_string<value_type,traits,allocator_type>( lhs ) += rhs;
+		return basic_string_concat< basic_string<value_type, traits, allocator_type, growth_policy> >( lhs )( rhs )
+			.str( rhs.get_allocator() );
 	}
 
-	template<class value_type, class traits, class allocator_type>
-	basic_string<value_type,traits,allocator_type>
-		operator+(const basic_string<value_type,traits,allocator_type>& lhs,
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
 		const value_type* rhs)
 	{
-		return basic_string<value_type,traits,allocator_type>( lhs ) += rhs;
+		return basic_string_concat< basic_string<value_type, traits, allocator_type, growth_policy> >( lhs )( rhs )
+			.str( lhs.get_allocator() );
 	}
 
-	template<class value_type, class traits, class allocator_type>
-	basic_string<value_type,traits,allocator_type>
-		operator+(const basic_string<value_type,traits,allocator_type>& lhs, value_type rhs)
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		value_type rhs)
 	{
-		return basic_string<value_type,traits,allocator_type>( lhs ) += rhs;
+		return basic_string_concat< basic_string<value_type, traits, allocator_type, growth_policy> >( lhs )( rhs )
+			.str( lhs.get_allocator() );
 	}
-	
-	template<class value_type, class traits, class allocator_type >
-	bool operator==(const basic_string<value_type, traits, allocator_type>& lhs,
-		const basic_string<value_type, traits, allocator_type>& rhs)
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(BOOST_RV_REF_BEG basic_string<value_type, traits, allocator_type, growth_policy> BOOST_RV_REF_END lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
+	{
+		return ::boost::move( lhs.append( rhs ) );
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		BOOST_RV_REF_BEG basic_string<value_type, traits, allocator_type, growth_policy> BOOST_RV_REF_END rhs)
+	{
+		return ::boost::move( rhs.insert( 0, lhs ) );
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(BOOST_RV_REF_BEG basic_string<value_type, traits, allocator_type, growth_policy> BOOST_RV_REF_END lhs,
+		BOOST_RV_REF_BEG basic_string<value_type, traits, allocator_type, growth_policy> BOOST_RV_REF_END rhs)
+	{
+		return ::boost::move( lhs.append( rhs ) );
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(const value_type* lhs,
+		BOOST_RV_REF_BEG basic_string<value_type, traits, allocator_type, growth_policy> BOOST_RV_REF_END rhs)
+	{
+		return ::boost::move( rhs.insert( 0, lhs ) );
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(value_type lhs,
+		BOOST_RV_REF_BEG basic_string<value_type, traits, allocator_type, growth_policy> BOOST_RV_REF_END rhs)
+	{
+		rhs.insert( rhs.begin(), lhs );
+		return ::boost::move( rhs );
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(BOOST_RV_REF_BEG basic_string<value_type, traits, allocator_type, growth_policy> BOOST_RV_REF_END lhs,
+		const value_type* rhs)
+	{
+		return ::boost::move( lhs.append( rhs ) );
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(BOOST_RV_REF_BEG basic_string<value_type, traits, allocator_type, growth_policy> BOOST_RV_REF_END lhs,
+		value_type rhs)
+	{
+		return ::boost::move( lhs.append( 1, rhs ) );
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator==(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{
 		return lhs.compare( rhs ) == 0;
 	}
 
-	template<class value_type, class traits, class allocator_type>
+	template<class value_type, class traits, class allocator_type, class growth_policy>
 	bool operator==(const value_type* lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{
 		return rhs.compare( lhs ) == 0;
 	}
 
-	template<class value_type, class traits, class allocator_type>
-	bool operator==(const basic_string<value_type,traits,allocator_type>& lhs,
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator==(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
 		const value_type* rhs)
 	{
 		return lhs.compare( rhs ) == 0;
 	}
 	
 	//////////////////////////////////////////////////////////////////////////
-	template<class value_type, class traits, class allocator_type>
-	bool operator!=(const basic_string<value_type,traits,allocator_type>& lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator!=(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{
 		return rel_ops::operator !=( lhs, rhs );
 	}
 
-	template<class value_type, class traits, class allocator_type>
+	template<class value_type, class traits, class allocator_type, class growth_policy>
 	bool operator!=(const value_type* lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{
 		return rel_ops::operator !=( lhs, rhs );
 	}
 
-	template<class value_type, class traits, class allocator_type>
-	bool operator!=(const basic_string<value_type,traits,allocator_type>& lhs,
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator!=(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
 		const value_type* rhs)
 	{
 		return rel_ops::operator !=( lhs, rhs );
 	}
 
 	//////////////////////////////////////////////////////////////////////////
-	template<class value_type, class traits, class allocator_type>
-	bool operator< (const basic_string<value_type,traits,allocator_type>& lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator< (const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{
 		return lhs.compare( rhs ) < 0;
 	}
 
-	template<class value_type, class traits, class allocator_type>
-	bool operator< (const basic_string<value_type,traits,allocator_type>& lhs,
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator< (const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
 		const value_type* rhs)
 	{
 		return lhs.compare( rhs ) < 0;
 	}
 
-	template<class value_type, class traits, class allocator_type>
+	template<class value_type, class traits, class allocator_type, class growth_policy>
 	bool operator< (const value_type* lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{//Params are in back order
 		return rhs.compare( lhs ) > 0;
 	}
 
 	//////////////////////////////////////////////////////////////////////////
-	template<class value_type, class traits, class allocator_type>
-	bool operator> (const basic_string<value_type,traits,allocator_type>& lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator> (const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{
 		return lhs.compare( rhs ) > 0;
 	}
 
-	template<class value_type, class traits, class allocator_type>
-	bool operator> (const basic_string<value_type,traits,allocator_type>& lhs,
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator> (const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
 		const value_type* rhs)
 	{
 		return lhs.compare( rhs ) > 0;
 	}
 
 
-	template<class value_type, class traits, class allocator_type>
+	template<class value_type, class traits, class allocator_type, class growth_policy>
 	bool operator> (const value_type* lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{//Params are in back order
 		return rhs.compare( lhs ) < 0;
 	}
 
 	//////////////////////////////////////////////////////////////////////////
-	template<class value_type, class traits, class allocator_type>
-	bool operator<=(const basic_string<value_type,traits,allocator_type>& lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator<=(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{
 		return lhs.compare( rhs ) <= 0;
 	}
 
 
-	template<class value_type, class traits, class allocator_type>
-	bool operator<=(const basic_string<value_type,traits,allocator_type>& lhs,
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator<=(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
 		const value_type* rhs)
 	{
 		return lhs.compare( rhs ) <= 0;
 	}
 
-	template<class value_type, class traits, class allocator_type>
+	template<class value_type, class traits, class allocator_type, class growth_policy>
 	bool operator<=(const value_type* lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{//Params are in back order
 		return rhs.compare( lhs ) >= 0;
 	}
 
 	//////////////////////////////////////////////////////////////////////////
-	template<class value_type, class traits, class allocator_type>
-	bool operator>=(const basic_string<value_type,traits,allocator_type>& lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator>=(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{
 		return lhs.compare( rhs ) >= 0;
 	}
 
 
-	template<class value_type, class traits, class allocator_type>
-	bool operator>=(const basic_string<value_type,traits,allocator_type>& lhs,
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator>=(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
 		const value_type* rhs)
 	{
 		return lhs.compare( rhs ) >= 0;
 	}
 
-	template<class value_type, class traits, class allocator_type>
+	template<class value_type, class traits, class allocator_type, class growth_policy>
 	bool operator>=(const value_type* lhs,
-		const basic_string<value_type,traits,allocator_type>& rhs)
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{//Params are in back order
 		return rhs.compare( lhs ) <= 0;
 	}
 
 	
 
+	//////////////////////////////////////////////////////////////////////////
+	// basic_string_view interoperability:
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		basic_string_view<value_type, traits> rhs)
+	{
+		return basic_string_concat< basic_string<value_type, traits, allocator_type, growth_policy> >( lhs )( rhs )
+			.str( lhs.get_allocator() );
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(basic_string_view<value_type, traits> lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
+	{
+		return basic_string_concat< basic_string<value_type, traits, allocator_type, growth_policy> >( lhs )( rhs )
+			.str( rhs.get_allocator() );
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(BOOST_RV_REF_BEG basic_string<value_type, traits, allocator_type, growth_policy> BOOST_RV_REF_END lhs,
+		basic_string_view<value_type, traits> rhs)
+	{
+		return ::boost::move( lhs.append( rhs ) );
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	basic_string<value_type, traits, allocator_type, growth_policy>
+		operator+(basic_string_view<value_type, traits> lhs,
+		BOOST_RV_REF_BEG basic_string<value_type, traits, allocator_type, growth_policy> BOOST_RV_REF_END rhs)
+	{
+		return ::boost::move( rhs.insert( 0, lhs ) );
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator==(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		basic_string_view<value_type, traits> rhs)
+	{
+		return lhs.compare( rhs ) == 0;
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator==(basic_string_view<value_type, traits> lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
+	{
+		return -rhs.compare( lhs ) == 0;
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator!=(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		basic_string_view<value_type, traits> rhs)
+	{
+		return lhs.compare( rhs ) != 0;
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator!=(basic_string_view<value_type, traits> lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
+	{
+		return -rhs.compare( lhs ) != 0;
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator< (const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		basic_string_view<value_type, traits> rhs)
+	{
+		return lhs.compare( rhs ) < 0;
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator< (basic_string_view<value_type, traits> lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
+	{
+		return -rhs.compare( lhs ) < 0;
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator> (const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		basic_string_view<value_type, traits> rhs)
+	{
+		return lhs.compare( rhs ) > 0;
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator> (basic_string_view<value_type, traits> lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
+	{
+		return -rhs.compare( lhs ) > 0;
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator<=(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		basic_string_view<value_type, traits> rhs)
+	{
+		return lhs.compare( rhs ) <= 0;
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator<=(basic_string_view<value_type, traits> lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
+	{
+		return -rhs.compare( lhs ) <= 0;
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator>=(const basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		basic_string_view<value_type, traits> rhs)
+	{
+		return lhs.compare( rhs ) >= 0;
+	}
+
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	bool operator>=(basic_string_view<value_type, traits> lhs,
+		const basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
+	{
+		return -rhs.compare( lhs ) >= 0;
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 	// 21.3.7.8:
-	template<class value_type, class traits, class allocator_type>
-	void swap(basic_string<value_type,traits,allocator_type>& lhs,
-		basic_string<value_type,traits,allocator_type>& rhs)
+	template<class value_type, class traits, class allocator_type, class growth_policy>
+	void swap(basic_string<value_type, traits, allocator_type, growth_policy>& lhs,
+		basic_string<value_type, traits, allocator_type, growth_policy>& rhs)
 	{
 		lhs.swap( rhs );
 	}
 
-	template<class value_type, class traits, class stream_traits, class allocator_type>
+	template<class value_type, class traits, class stream_traits, class allocator_type, class growth_policy>
 	std::basic_istream<value_type, stream_traits>&
 		operator>>( std::basic_istream<value_type, stream_traits>& is,
-		basic_string<value_type, traits, allocator_type>& str )
+		basic_string<value_type, traits, allocator_type, growth_policy>& str )
 	{
 		std::basic_string<value_type, traits, allocator_type> tmp;
 		is >> tmp;
@@ -1242,29 +1675,32 @@ namespace gstl
 	}
 	
 
-	template<class value_type, class traits, class stream_traits, class allocator_type>
+	template<class value_type, class traits, class stream_traits, class allocator_type, class growth_policy>
 	std::basic_ostream<value_type, stream_traits>&
 		operator<<( std::basic_ostream<value_type, stream_traits>& os,
-		const basic_string<value_type,traits,allocator_type>& str )
+		const basic_string<value_type, traits, allocator_type, growth_policy>& str )
 	{
 		return os << str.c_str();
 	}
 
 	//////////////////////////////////////////////////////////////////////////
-	template<class value_type, class traits, class allocator_type>
+	template<class value_type, class traits, class allocator_type, class growth_policy>
 	std::basic_istream<value_type,traits>&
 		getline( std::basic_istream<value_type,traits>& is,
-		basic_string<value_type,traits,allocator_type>& str,
+		basic_string<value_type, traits, allocator_type, growth_policy>& str,
 		value_type delim );
 
-	template<class value_type, class traits, class allocator_type>
+	template<class value_type, class traits, class allocator_type, class growth_policy>
 	std::basic_istream<value_type,traits>&
 		getline( std::basic_istream<value_type,traits>& is,
-		basic_string<value_type,traits,allocator_type>& str );
+		basic_string<value_type, traits, allocator_type, growth_policy>& str );
 	
 
 	typedef basic_string<char, char_traits<char>, allocator<char> > string;
 	typedef basic_string<wchar_t, char_traits<wchar_t>, allocator<wchar_t> > wstring;
+
+	typedef basic_string_concat<string> string_concat;
+	typedef basic_string_concat<wstring> wstring_concat;
 }
 
 
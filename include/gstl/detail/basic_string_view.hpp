@@ -0,0 +1,589 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_BASIC_STRING_VIEW_HEADER
+#define GSTL_BASIC_STRING_VIEW_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <stddef.h>
+#include <stdexcept>
+#include <iosfwd>
+#include <gstl/algorithm>
+#include <gstl/utility>
+#include <gstl/iterator>
+#include <gstl/detail/assert.hpp>
+#include <gstl/detail/char_traits.hpp>
+#include <gstl/detail/string_searcher.hpp>
+#include <gstl/detail/char_set.hpp>
+
+namespace gstl
+{
+	/**
+	   @brief Non-owning reference to a constant contiguous sequence of characters
+	   @details The view is a pair of the raw pointer and the size, so it does not depend
+		on the allocator of the string it refers to. It is valid while the referred
+		characters are alive and are not moved, e.g. while the string is not reallocated.
+		The search functions keep the semantics of the gstl::basic_string ones,
+		basic_string forwards its searches here.
+	*/
+	template<class CharT, class Traits = gstl::char_traits<CharT> >
+	class basic_string_view
+	{
+	public:
+		typedef Traits									traits_type;
+		typedef CharT									value_type;
+		typedef const CharT*							pointer;
+		typedef const CharT*							const_pointer;
+		typedef const CharT&							reference;
+		typedef const CharT&							const_reference;
+		typedef const CharT*							const_iterator;
+		typedef const_iterator							iterator;
+		typedef gstl::reverse_iterator<const_iterator>	const_reverse_iterator;
+		typedef const_reverse_iterator					reverse_iterator;
+		typedef size_t									size_type;
+		typedef ptrdiff_t								difference_type;
+
+		typedef gstl::string_searcher<value_type, traits_type>	searcher_type;
+
+		static const size_type npos = static_cast<size_type>( -1 );
+
+		basic_string_view()
+			:data_( 0 )
+			,size_( 0 )
+		{}
+
+		basic_string_view( const value_type* s, size_type n )
+			:data_( s )
+			,size_( n )
+		{
+			GSTL_ASSERT( ( s != 0 || n == 0 ) && "s is null" );
+		}
+
+		basic_string_view( const value_type* s )
+			:data_( s )
+			,size_( traits_type::length( s ) )
+		{}
+
+		const_iterator begin() const
+		{
+			return data_;
+		}
+
+		const_iterator end() const
+		{
+			return data_ + size_;
+		}
+
+		const_reverse_iterator rbegin() const
+		{
+			return const_reverse_iterator( end() );
+		}
+
+		const_reverse_iterator rend() const
+		{
+			return const_reverse_iterator( begin() );
+		}
+
+		size_type size() const
+		{
+			return size_;
+		}
+
+		size_type length() const
+		{
+			return size_;
+		}
+
+		size_type max_size() const
+		{
+			return npos / sizeof( value_type );
+		}
+
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+
+		const_reference operator[]( size_type pos ) const
+		{
+			GSTL_ASSERT( pos < size_ && "invalid position" );
+			return data_[pos];
+		}
+
+		const_reference at( size_type pos ) const
+		{
+			if( pos >= size_ )
+			{
+				_throw_out_of_range();
+			}
+			return data_[pos];
+		}
+
+		const_reference front() const
+		{
+			GSTL_ASSERT( size_ != 0 && "view is empty" );
+			return data_[0];
+		}
+
+		const_reference back() const
+		{
+			GSTL_ASSERT( size_ != 0 && "view is empty" );
+			return data_[size_ - 1];
+		}
+
+		const_pointer data() const
+		{
+			return data_;
+		}
+
+		void remove_prefix( size_type n )
+		{
+			GSTL_ASSERT( n <= size_ && "invalid size" );
+			data_ += n;
+			size_ -= n;
+		}
+
+		void remove_suffix( size_type n )
+		{
+			GSTL_ASSERT( n <= size_ && "invalid size" );
+			size_ -= n;
+		}
+
+		void swap( basic_string_view& other )
+		{
+			gstl::swap( data_, other.data_ );
+			gstl::swap( size_, other.size_ );
+		}
+
+		size_type copy( value_type* s, size_type n, size_type pos = 0 ) const
+		{
+			const size_type rlen = _validate_pos_and_off( pos, n );
+			if( rlen != 0 )
+			{
+				traits_type::copy( s, data_ + pos, rlen );
+			}
+			return rlen;
+		}
+
+		/**
+		   @brief Returns view of [pos, pos + rlen), rlen is the smaller of n and size() - pos
+		   @details Throws out_of_range if pos > size()
+		*/
+		basic_string_view substr( size_type pos = 0, size_type n = npos ) const
+		{
+			const size_type rlen = _validate_pos_and_off( pos, n );
+			return basic_string_view( data_ + pos, rlen );
+		}
+
+		int compare( basic_string_view sv ) const
+		{
+			//Default constructed view has null data, which is never passed to the traits
+			const size_type rlen = (gstl::min)( size_, sv.size_ );
+			if( rlen != 0 )
+			{
+				const int cmp_res = traits_type::compare( data_, sv.data_, rlen );
+				if( cmp_res != 0 )
+				{
+					return cmp_res;
+				}
+			}
+			return size_ < sv.size_ ? -1 : ( size_ > sv.size_ ? 1 : 0 );
+		}
+
+		int compare( size_type pos1, size_type n1, basic_string_view sv ) const
+		{
+			return substr( pos1, n1 ).compare( sv );
+		}
+
+		int compare( size_type pos1, size_type n1, basic_string_view sv,
+			size_type pos2, size_type n2 ) const
+		{
+			return substr( pos1, n1 ).compare( sv.substr( pos2, n2 ) );
+		}
+
+		int compare( const value_type* s ) const
+		{
+			return compare( basic_string_view( s ) );
+		}
+
+		int compare( size_type pos1, size_type n1, const value_type* s, size_type n2 ) const
+		{
+			return substr( pos1, n1 ).compare( basic_string_view( s, n2 ) );
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		size_type find( basic_string_view sv, size_type pos = 0 ) const
+		{
+			return find( sv.data_, pos, sv.size_ );
+		}
+
+		size_type find( value_type c, size_type pos = 0 ) const
+		{
+			return find( &c, pos, 1 );
+		}
+
+		size_type find( const value_type* s, size_type pos, size_type n ) const
+		{
+			if( n == 0 )
+			{//Null string always matches, if it is inside the string
+				return pos < size_ ? pos : npos;
+			}
+
+			if( pos < size_ && n <= size_ - pos )
+			{
+				const value_type* first = data_ + pos;
+				const value_type* last = data_ + size_;
+				const value_type* fres;
+				if( search_type::is_long( n )
+					&& static_cast<size_type>( last - first ) >= min_searcher_text_size )
+				{
+					fres = searcher_type( s, n ).find( first, last );
+				}
+				else
+				{
+					fres = search_type::find_short( first, last, s, n );
+				}
+				if( fres != 0 )
+				{
+					//Match found
+					return fres - data_;
+				}
+			}
+
+			//No match
+			return npos;
+		}
+
+		size_type find( const value_type* s, size_type pos = 0 ) const
+		{
+			return find( s, pos, traits_type::length( s ) );
+		}
+
+		/**
+		   @brief Searches for the pattern of the searcher starting at pos
+		   @details Use it to search the same pattern in many strings,
+			the pattern is preprocessed only once
+		*/
+		size_type find( const searcher_type& searcher, size_type pos = 0 ) const
+		{
+			if( pos >= size_ )
+			{
+				return npos;
+			}
+			const value_type* fres = searcher.find( data_ + pos, data_ + size_ );
+			return fres != 0 ? fres - data_ : npos;
+		}
+
+		size_type rfind( basic_string_view sv, size_type pos = npos ) const
+		{
+			return rfind( sv.data_, pos, sv.size_ );
+		}
+
+		size_type rfind( value_type c, size_type pos = npos ) const
+		{
+			return rfind( &c, pos, 1 );
+		}
+
+		size_type rfind( const value_type* s, size_type pos, size_type n ) const
+		{
+			if( n == 0 )
+			{//Null string always matches, if it is inside the string
+				return pos < size_ ? pos : npos;
+			}
+
+			if( n <= size_ )
+			{
+				//Search for sub string in the reverse direction
+				const value_type* last = data_ + (gstl::min)( pos, size_ - n ) + n;
+				const value_type* fres;
+				if( search_type::is_long( n )
+					&& static_cast<size_type>( last - data_ ) >= min_searcher_text_size )
+				{
+					fres = searcher_type( s, n ).rfind( data_, last );
+				}
+				else
+				{
+					fres = search_type::rfind_short( data_, last, s, n );
+				}
+				if( fres != 0 )
+				{
+					//Match found
+					return fres - data_;
+				}
+			}
+
+			//No match
+			return npos;
+		}
+
+		size_type rfind( const value_type* s, size_type pos = npos ) const
+		{
+			return rfind( s, pos, traits_type::length( s ) );
+		}
+
+		/**
+		   @brief Searches backward for the pattern of the searcher starting at or before pos
+		*/
+		size_type rfind( const searcher_type& searcher, size_type pos = npos ) const
+		{
+			const size_type n = searcher.pattern_size();
+			if( n == 0 )
+			{//Null string always matches, if it is inside the string
+				return pos < size_ ? pos : npos;
+			}
+			if( n > size_ )
+			{
+				return npos;
+			}
+			const value_type* last = data_ + (gstl::min)( pos, size_ - n ) + n;
+			const value_type* fres = searcher.rfind( data_, last );
+			return fres != 0 ? fres - data_ : npos;
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		size_type find_first_of( basic_string_view sv, size_type pos = 0 ) const
+		{
+			return find_first_of( sv.data_, pos, sv.size_ );
+		}
+
+		size_type find_first_of( value_type c, size_type pos = 0 ) const
+		{
+			return find_first_of( &c, pos, 1 );
+		}
+
+		size_type find_first_of( const value_type* s, size_type pos, size_type n ) const
+		{
+			return _find_first( s, pos, n, true );
+		}
+
+		size_type find_first_of( const value_type* s, size_type pos = 0 ) const
+		{
+			return find_first_of( s, pos, traits_type::length( s ) );
+		}
+
+		size_type find_last_of( basic_string_view sv, size_type pos = npos ) const
+		{
+			return find_last_of( sv.data_, pos, sv.size_ );
+		}
+
+		size_type find_last_of( value_type c, size_type pos = npos ) const
+		{
+			return find_last_of( &c, pos, 1 );
+		}
+
+		size_type find_last_of( const value_type* s, size_type pos, size_type n ) const
+		{
+			return _find_last( s, pos, n, true );
+		}
+
+		size_type find_last_of( const value_type* s, size_type pos = npos ) const
+		{
+			return find_last_of( s, pos, traits_type::length( s ) );
+		}
+
+		size_type find_first_not_of( basic_string_view sv, size_type pos = 0 ) const
+		{
+			return find_first_not_of( sv.data_, pos, sv.size_ );
+		}
+
+		size_type find_first_not_of( value_type c, size_type pos = 0 ) const
+		{
+			return find_first_not_of( &c, pos, 1 );
+		}
+
+		size_type find_first_not_of( const value_type* s, size_type pos, size_type n ) const
+		{
+			return _find_first( s, pos, n, false );
+		}
+
+		size_type find_first_not_of( const value_type* s, size_type pos = 0 ) const
+		{
+			return find_first_not_of( s, pos, traits_type::length( s ) );
+		}
+
+		size_type find_last_not_of( basic_string_view sv, size_type pos = npos ) const
+		{
+			return find_last_not_of( sv.data_, pos, sv.size_ );
+		}
+
+		size_type find_last_not_of( value_type c, size_type pos = npos ) const
+		{
+			return find_last_not_of( &c, pos, 1 );
+		}
+
+		size_type find_last_not_of( const value_type* s, size_type pos, size_type n ) const
+		{
+			return _find_last( s, pos, n, false );
+		}
+
+		size_type find_last_not_of( const value_type* s, size_type pos = npos ) const
+		{
+			return find_last_not_of( s, pos, traits_type::length( s ) );
+		}
+
+	private:
+		typedef detail::substring_search<traits_type>	search_type;
+		typedef detail::char_set_search<traits_type>	set_search_type;
+
+		/**
+		   @brief Shorter texts are searched for the long patterns without building the shift tables
+		*/
+		enum{ min_searcher_text_size = 256 };
+
+		size_type _find_first( const value_type* s, size_type pos, size_type n, bool in_set ) const
+		{
+			if( n > 0 && pos < size_ )
+			{
+				const value_type* fres = set_search_type::find_first( data_ + pos,
+					data_ + size_, s, n, in_set );
+				if( fres != 0 )
+				{
+					//Match found
+					return fres - data_;
+				}
+			}
+
+			//No match
+			return npos;
+		}
+
+		size_type _find_last( const value_type* s, size_type pos, size_type n, bool in_set ) const
+		{
+			if( n > 0 && size_ )
+			{
+				const value_type* fres = set_search_type::find_last( data_,
+					data_ + (gstl::min)( pos, size_ - 1 ) + 1, s, n, in_set );
+				if( fres != 0 )
+				{
+					//Match found
+					return fres - data_;
+				}
+			}
+
+			//No match
+			return npos;
+		}
+
+		size_type _validate_pos_and_off( size_type pos, size_type n ) const
+		{
+			if( pos > size_ )
+			{
+				_throw_out_of_range();
+			}
+			return (gstl::min)( n, size_ - pos );
+		}
+
+		void _throw_out_of_range() const
+		{
+			throw std::out_of_range( "basic_string_view: invalid position" );
+		}
+
+		const value_type* data_;
+		size_type size_;
+	};
+
+	template<class CharT, class Traits>
+	const typename basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::npos;
+
+	//////////////////////////////////////////////////////////////////////////
+	template<class CharT, class Traits>
+	bool operator==( basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs )
+	{
+		return lhs.size() == rhs.size() && lhs.compare( rhs ) == 0;
+	}
+
+	template<class CharT, class Traits>
+	bool operator==( basic_string_view<CharT, Traits> lhs, const CharT* rhs )
+	{
+		return lhs.compare( rhs ) == 0;
+	}
+
+	template<class CharT, class Traits>
+	bool operator==( const CharT* lhs, basic_string_view<CharT, Traits> rhs )
+	{
+		return rhs.compare( lhs ) == 0;
+	}
+
+	template<class CharT, class Traits>
+	bool operator!=( basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs )
+	{
+		return !( lhs == rhs );
+	}
+
+	template<class CharT, class Traits>
+	bool operator!=( basic_string_view<CharT, Traits> lhs, const CharT* rhs )
+	{
+		return !( lhs == rhs );
+	}
+
+	template<class CharT, class Traits>
+	bool operator!=( const CharT* lhs, basic_string_view<CharT, Traits> rhs )
+	{
+		return !( lhs == rhs );
+	}
+
+	template<class CharT, class Traits>
+	bool operator< ( basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs )
+	{
+		return lhs.compare( rhs ) < 0;
+	}
+
+	template<class CharT, class Traits>
+	bool operator> ( basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs )
+	{
+		return lhs.compare( rhs ) > 0;
+	}
+
+	template<class CharT, class Traits>
+	bool operator<=( basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs )
+	{
+		return lhs.compare( rhs ) <= 0;
+	}
+
+	template<class CharT, class Traits>
+	bool operator>=( basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs )
+	{
+		return lhs.compare( rhs ) >= 0;
+	}
+
+	template<class CharT, class Traits>
+	void swap( basic_string_view<CharT, Traits>& lhs, basic_string_view<CharT, Traits>& rhs )
+	{
+		lhs.swap( rhs );
+	}
+
+	template<class CharT, class Traits, class StreamTraits>
+	std::basic_ostream<CharT, StreamTraits>&
+		operator<<( std::basic_ostream<CharT, StreamTraits>& os, basic_string_view<CharT, Traits> sv )
+	{
+		return os.write( sv.data(), static_cast<std::streamsize>( sv.size() ) );
+	}
+
+	typedef basic_string_view<char>		string_view;
+	typedef basic_string_view<wchar_t>	wstring_view;
+}
+
+#endif //GSTL_BASIC_STRING_VIEW_HEADER
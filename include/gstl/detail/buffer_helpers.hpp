@@ -29,6 +29,18 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 #endif
 
 #include <gstl/detail/assert.hpp>
+#include <string.h>
+#include <new>
+
+#include <gstl/detail/boost_warnings_off.hpp>
+#include <boost/move/move.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_assign.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <gstl/detail/boost_warnings_on.hpp>
 
 namespace gstl
 {
@@ -91,12 +103,40 @@ namespace gstl
 			return check_overlap( buf1, buf1 + n, buf2, buf2 + n );
 		}
 
+		/**
+		   @brief Type trait, selects bitwise copying of the items
+		   @details Items of the same type with trivial assignment operator
+			can be moved with memmove instead of per-item assignments
+		*/
+		template<class DstItem, class SrcItem>
+		struct is_bitwise_movable
+			:public boost::mpl::and_< boost::is_same<DstItem, SrcItem>,
+				boost::has_trivial_assign<DstItem> >
+		{};
+
+		/**
+		   @brief Type trait, selects bitwise relocation of the items
+		   @details Relocation of such items is a plain memcpy,
+			there is no need to call constructors and destructors
+		*/
+		template<class T>
+		struct is_bitwise_relocatable
+			:public boost::mpl::and_< boost::has_trivial_copy<T>,
+				boost::has_trivial_destructor<T> >
+		{};
+
 		template<class DstItem, class SrcItem, class SizeType>
-		static inline DstItem* move( DstItem* dst, const SrcItem* src, SizeType n )
+		static inline DstItem* move( DstItem* dst, const SrcItem* src, SizeType n,
+			boost::mpl::true_ /*bitwise movable*/ )
 		{
-			GSTL_ASSERT( dst != 0 && "dst is null" );
-			GSTL_ASSERT( src != 0 && "src is null" );
+			memmove( dst, src, static_cast<size_t>( n ) * sizeof( DstItem ) );
+			return dst;
+		}
 
+		template<class DstItem, class SrcItem, class SizeType>
+		static inline DstItem* move( DstItem* dst, const SrcItem* src, SizeType n,
+			boost::mpl::false_ /*bitwise movable*/ )
+		{
 			typedef DstItem*		dst_pointer_type;
 			typedef const SrcItem*	src_pointer_type;
 			
@@ -121,6 +161,188 @@ namespace gstl
 			}
 			return dst_begin;
 		}
+
+		/**
+		   @brief Assigns n items of src to the items of dst
+		   @details Copies correctly even where the ranges overlap.
+			Both ranges must contain constructed items.
+			Items of trivially assignable types are copied with single memmove.
+		   @return dst pointer.
+		*/
+		template<class DstItem, class SrcItem, class SizeType>
+		static inline DstItem* move( DstItem* dst, const SrcItem* src, SizeType n )
+		{
+			GSTL_ASSERT( dst != 0 && "dst is null" );
+			GSTL_ASSERT( src != 0 && "src is null" );
+
+			return detail::move( dst, src, n,
+				typename is_bitwise_movable<DstItem, SrcItem>::type() );
+		}
+
+		template<class T, class SizeType>
+		static inline T* move_backward( T* dst, T* src, SizeType n,
+			boost::mpl::true_ /*bitwise movable*/ )
+		{
+			memmove( dst, src, static_cast<size_t>( n ) * sizeof( T ) );
+			return dst;
+		}
+
+		template<class T, class SizeType>
+		static inline T* move_backward( T* dst, T* src, SizeType n,
+			boost::mpl::false_ /*bitwise movable*/ )
+		{
+			while( n-- )
+			{
+				dst[n] = ::boost::move( src[n] );
+			}
+			return dst;
+		}
+
+		/**
+		   @brief Move-assigns n items of src to dst starting from the last item
+		   @details Shifts items towards the end of a buffer, so dst must not precede src.
+			Both ranges must contain constructed items.
+			Items of trivially assignable types are moved with single memmove.
+		   @return dst pointer.
+		*/
+		template<class T, class SizeType>
+		static inline T* move_backward( T* dst, T* src, SizeType n )
+		{
+			GSTL_ASSERT( dst != 0 && "dst is null" );
+			GSTL_ASSERT( src != 0 && "src is null" );
+			GSTL_ASSERT( dst >= src && "items can be shifted only to the end" );
+
+			return detail::move_backward( dst, src, n,
+				typename is_bitwise_movable<T, T>::type() );
+		}
+
+		template<class T, class SizeType>
+		static inline T* move_forward( T* dst, T* src, SizeType n,
+			boost::mpl::true_ /*bitwise movable*/ )
+		{
+			memmove( dst, src, static_cast<size_t>( n ) * sizeof( T ) );
+			return dst;
+		}
+
+		template<class T, class SizeType>
+		static inline T* move_forward( T* dst, T* src, SizeType n,
+			boost::mpl::false_ /*bitwise movable*/ )
+		{
+			for( SizeType i = 0; i < n; ++i )
+			{
+				dst[i] = ::boost::move( src[i] );
+			}
+			return dst;
+		}
+
+		/**
+		   @brief Move-assigns n items of src to dst starting from the first item
+		   @details Shifts items towards the beginning of a buffer, so dst must not follow src.
+			Both ranges must contain constructed items.
+			Items of trivially assignable types are moved with single memmove.
+		   @return dst pointer.
+		*/
+		template<class T, class SizeType>
+		static inline T* move_forward( T* dst, T* src, SizeType n )
+		{
+			GSTL_ASSERT( dst != 0 && "dst is null" );
+			GSTL_ASSERT( src != 0 && "src is null" );
+			GSTL_ASSERT( dst <= src && "items can be shifted only to the beginning" );
+
+			return detail::move_forward( dst, src, n,
+				typename is_bitwise_movable<T, T>::type() );
+		}
+
+		template<class T, class SizeType>
+		static inline T* uninitialized_move( T* dst, T* src, SizeType n,
+			boost::mpl::true_ /*bitwise relocatable*/ )
+		{
+			memcpy( dst, src, static_cast<size_t>( n ) * sizeof( T ) );
+			return dst;
+		}
+
+		template<class T, class SizeType>
+		static inline T* uninitialized_move( T* dst, T* src, SizeType n,
+			boost::mpl::false_ /*bitwise relocatable*/ )
+		{
+			T* curr = dst;
+			try
+			{
+				for( SizeType i = 0; i < n; ++i, ++curr )
+				{
+					::new( static_cast<void*>( curr ) ) T( ::boost::move( src[i] ) );
+				}
+			}
+			catch(...)
+			{
+				while( curr != dst )
+				{
+					(--curr)->~T();
+				}
+				throw;
+			}
+			return dst;
+		}
+
+		/**
+		   @brief Move-constructs n items from src in uninitialized memory at dst
+		   @details Source items are left alive in the moved-from state.
+			Trivially copyable types are copied with single memcpy.
+			Ranges must not overlap.
+		   @exception If construction of any item throws, items constructed at dst
+			are destroyed and the exception is rethrown.
+		   @return dst pointer.
+		*/
+		template<class T, class SizeType>
+		static inline T* uninitialized_move( T* dst, T* src, SizeType n )
+		{
+			GSTL_ASSERT( dst != 0 && "dst is null" );
+			GSTL_ASSERT( src != 0 && "src is null" );
+			GSTL_ASSERT( check_overlap( dst, src, n ) == 0 && "buffers overlap" );
+
+			return detail::uninitialized_move( dst, src, n,
+				typename is_bitwise_relocatable<T>::type() );
+		}
+
+		template<class T, class SizeType>
+		static inline T* relocate( T* dst, T* src, SizeType n,
+			boost::mpl::true_ /*bitwise relocatable*/ )
+		{
+			memcpy( dst, src, static_cast<size_t>( n ) * sizeof( T ) );
+			return dst;
+		}
+
+		template<class T, class SizeType>
+		static inline T* relocate( T* dst, T* src, SizeType n,
+			boost::mpl::false_ /*bitwise relocatable*/ )
+		{
+			detail::uninitialized_move( dst, src, n, boost::mpl::false_() );
+			for( SizeType i = 0; i < n; ++i )
+			{
+				src[i].~T();
+			}
+			return dst;
+		}
+
+		/**
+		   @brief Relocates n items from src into uninitialized memory at dst
+		   @details Move-constructs items at dst from the items at src and destroys
+			the source items. Trivially copyable types are relocated with single memcpy.
+			Ranges must not overlap.
+		   @exception If construction of any item throws, items constructed at dst
+			are destroyed, source items are left alive and the exception is rethrown.
+		   @return dst pointer.
+		*/
+		template<class T, class SizeType>
+		static inline T* relocate( T* dst, T* src, SizeType n )
+		{
+			GSTL_ASSERT( dst != 0 && "dst is null" );
+			GSTL_ASSERT( src != 0 && "src is null" );
+			GSTL_ASSERT( check_overlap( dst, src, n ) == 0 && "buffers overlap" );
+
+			return detail::relocate( dst, src, n,
+				typename is_bitwise_relocatable<T>::type() );
+		}
 	}
 }
 
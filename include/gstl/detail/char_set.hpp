@@ -0,0 +1,174 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_CHAR_SET_HEADER
+#define GSTL_CHAR_SET_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <gstl/detail/types.hpp>
+#include <gstl/detail/assert.hpp>
+#include <gstl/detail/char_traits.hpp>
+
+#include <gstl/detail/boost_warnings_off.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <gstl/detail/boost_warnings_on.hpp>
+
+namespace gstl
+{
+	namespace detail
+	{
+		/**
+		   @brief 256-bit membership bitmap of a character set
+		   @details Characters are indexed by their low byte, so the bitmap is exact
+			for the single byte characters and is a filter for the wider ones:
+			a clear bit means that the character is not in the set.
+		*/
+		template<class Traits>
+		class char_bitmap
+		{
+		public:
+			typedef typename Traits::char_type	value_type;
+			typedef typename Traits::size_type	size_type;
+
+			enum{ is_exact = sizeof( value_type ) == 1 };
+
+			char_bitmap( const value_type* s, size_type n )
+				:set_( s )
+				,size_( n )
+			{
+				for( size_type i = 0; i < words_count; ++i )
+				{
+					bits_[i] = 0;
+				}
+				for( size_type i = 0; i < n; ++i )
+				{
+					const size_type idx = index( s[i] );
+					bits_[idx / word_bits] |= boost::uint32_t( 1 ) << ( idx % word_bits );
+				}
+			}
+
+			bool contains( const value_type& c ) const
+			{
+				const size_type idx = index( c );
+				const bool bit = ( ( bits_[idx / word_bits] >> ( idx % word_bits ) ) & 1 ) != 0;
+				return bit && ( is_exact || Traits::find( set_, size_, c ) != 0 );
+			}
+
+		private:
+			enum{ word_bits = 32, words_count = 256 / word_bits };
+
+			static inline size_type index( const value_type& c )
+			{
+				return static_cast<size_type>( Traits::to_int_type( c ) ) & 0xff;
+			}
+
+			const value_type* set_;
+			size_type size_;
+			boost::uint32_t bits_[words_count];
+		};
+
+		/**
+		   @brief Search for the characters, which are (or are not) in the given set
+		   @details With gstl::char_traits the set is converted to char_bitmap once per call,
+			so the text is scanned with a table lookup per character instead of
+			traits_type::find over the whole set. Custom traits may compare characters
+			in their own way (e.g. case insensitive), so they are searched by traits_type::find.
+		*/
+		template<class Traits>
+		struct char_set_search
+		{
+			typedef typename Traits::char_type	value_type;
+			typedef typename Traits::size_type	size_type;
+
+			enum{ use_bitmap = boost::is_same< Traits, gstl::char_traits<value_type> >::value };
+
+			/**
+			   @brief Returns first character in [first, last), whose membership in s[0, n)
+				is equal to in_set, or 0
+			*/
+			static const value_type* find_first( const value_type* first, const value_type* last,
+				const value_type* s, size_type n, bool in_set )
+			{
+				if( n == 1 && in_set )
+				{
+					return Traits::find( first, last - first, *s );
+				}
+				if( use_bitmap && n > 1 )
+				{
+					const char_bitmap<Traits> set( s, n );
+					for( ; first != last; ++first )
+					{
+						if( set.contains( *first ) == in_set )
+						{
+							return first;
+						}
+					}
+					return 0;
+				}
+				for( ; first != last; ++first )
+				{
+					if( ( Traits::find( s, n, *first ) != 0 ) == in_set )
+					{
+						return first;
+					}
+				}
+				return 0;
+			}
+
+			/**
+			   @brief Returns last character in [first, last), whose membership in s[0, n)
+				is equal to in_set, or 0
+			*/
+			static const value_type* find_last( const value_type* first, const value_type* last,
+				const value_type* s, size_type n, bool in_set )
+			{
+				if( use_bitmap && n > 1 )
+				{
+					const char_bitmap<Traits> set( s, n );
+					while( last != first )
+					{
+						if( set.contains( *--last ) == in_set )
+						{
+							return last;
+						}
+					}
+					return 0;
+				}
+				while( last != first )
+				{
+					if( ( Traits::find( s, n, *--last ) != 0 ) == in_set )
+					{
+						return last;
+					}
+				}
+				return 0;
+			}
+		};
+	}
+}
+
+#endif //GSTL_CHAR_SET_HEADER
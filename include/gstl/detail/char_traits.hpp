@@ -32,6 +32,8 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 #include <gstl/detail/assert.hpp>
 #include <gstl/detail/buffer_helpers.hpp>
 #include <stdio.h>
+#include <string.h>
+#include <wchar.h>
 
 namespace gstl
 {
@@ -40,206 +42,331 @@ namespace gstl
 	typedef std::streampos	streampos;
 	typedef std::mbstate_t	mbstate_t;
 
-	//implementation 
-	template<class T>
-	struct char_traits
+	namespace detail
 	{
-		typedef T			char_type;
-		typedef int			int_type;
-		typedef streamoff	off_type;
-		typedef streampos	pos_type;
-		typedef mbstate_t	state_type;
-
-		typedef gstl::detail::portable_size_t size_type;
-		
 		/**
-		   @brief assigns c = d
+		   @brief Generic implementation of the character traits, see 21.1.1
+		   @details Works for any character type by the per-character loops
 		*/
-		static inline void assign( char_type& c, const char_type& d )
+		template<class T>
+		struct generic_char_traits
 		{
-			c = d;
-		}
+			typedef T			char_type;
+			typedef int			int_type;
+			typedef streamoff	off_type;
+			typedef streampos	pos_type;
+			typedef mbstate_t	state_type;
+
+			typedef gstl::detail::portable_size_t size_type;
 		
-		/**
-			@brief yields: whether c is to be treated as equal to d.
-		*/
-		static inline bool eq( const char_type& c, const char_type& d )
-		{
-			return c == d;
-		}
+			/**
+			   @brief assigns c = d
+			*/
+			static inline void assign( char_type& c, const char_type& d )
+			{
+				c = d;
+			}
 		
-		/**
-			@brief yields: whether c is to be treated as less than to d
-		*/
-		static inline bool lt( const char_type& c, const char_type& d )
-		{
-			return c < d;
-		}
+			/**
+				@brief yields: whether c is to be treated as equal to d.
+			*/
+			static inline bool eq( const char_type& c, const char_type& d )
+			{
+				return c == d;
+			}
+		
+			/**
+				@brief yields: whether c is to be treated as less than to d
+			*/
+			static inline bool lt( const char_type& c, const char_type& d )
+			{
+				return c < d;
+			}
 
-		/**
-			@brief yields: 0 if for each i in [0,n),
-				X::eq(p[i],q[i]) is true; else, a negative
-				value if, for some j in [0,n),
-				X::lt(p[j],q[j]) is true and for each i in
-				[0,j) X::eq(p[i],q[i]) is true; else a positive values
-		*/
-		static inline int compare( const char_type* s1, const char_type* s2, size_type n )
-		{
-			GSTL_ASSERT( s1 != 0 && "s1 is null" );
-			GSTL_ASSERT( s2 != 0 && "s2 is null" );
+			/**
+				@brief yields: 0 if for each i in [0,n),
+					X::eq(p[i],q[i]) is true; else, a negative
+					value if, for some j in [0,n),
+					X::lt(p[j],q[j]) is true and for each i in
+					[0,j) X::eq(p[i],q[i]) is true; else a positive values
+			*/
+			static inline int compare( const char_type* s1, const char_type* s2, size_type n )
+			{
+				GSTL_ASSERT( s1 != 0 && "s1 is null" );
+				GSTL_ASSERT( s2 != 0 && "s2 is null" );
 
-			//GSTL_ASSERT( n <= length( s1 ) + 1 && "n exceeds length of the first string (s1)" );
-			//GSTL_ASSERT( n <= length( s2 ) + 1 && "n exceeds length of the second string (s2)" );
+				//GSTL_ASSERT( n <= length( s1 ) + 1 && "n exceeds length of the first string (s1)" );
+				//GSTL_ASSERT( n <= length( s2 ) + 1 && "n exceeds length of the second string (s2)" );
 
-			while( n-- )
-			{
-				if( !eq( *s1, *s2 ) )
+				while( n-- )
 				{
-					if( lt( *s1, *s2 ) )
+					if( !eq( *s1, *s2 ) )
 					{
-						return -1;
+						if( lt( *s1, *s2 ) )
+						{
+							return -1;
+						}
+						else
+						{
+							return 1;
+						}
 					}
-					else
+					++s1;
+					++s2;
+				}
+				return 0;
+			}
+
+			/**
+				@brief yields: the smallest i such that 
+					X::eq(p[i], charT()) is true.
+			*/
+			static inline size_type length( const char_type* s )
+			{
+				GSTL_ASSERT( s != 0 && "s is null" );
+				size_type len = 0;
+				while( !eq( *s, char_type() ) )
+				{
+					++s;
+					++len;
+				}
+				return len;
+			}
+
+			/**
+				@brief yields: the smallest q in [p,p+n) such that
+					X::eq(*q,c) is true, zero otherwise
+			*/
+			static inline const char_type* find( const char_type* s, size_type n, const char_type& a )
+			{
+				GSTL_ASSERT( s != 0 && "s is null" );
+				//GSTL_ASSERT( n <= length( s ) + 1 && "n exceeds length of the string" );
+				while( n-- )
+				{
+					if( eq( *s, a ) )
 					{
-						return 1;
+						return s;
 					}
+					++s;
+				}
+				return 0;
+			}
+
+			/**
+				@brief Moves n chars of the src string into dst
+			
+				@detail For each i in [0,n), performs X::assign(drc[i],dst[i]). 
+						Copies correctly even where the ranges [p, p+n) and [s, s+n) overlap. 
+				@return dst pointer.
+			*/
+			static inline char_type* move( char_type* dst, const char_type* src, size_type n )
+			{
+				return detail::move( dst, src, n );
+			}
+
+			/**
+				@brief pre: p not in [s,s+n). yields: s. for each i in
+					[0,n), performs X::assign(s[i],p[i]).
+			*/
+			static inline char_type* copy( char_type* s1, const char_type* s2, size_type n )
+			{
+				return move( s1, s2, n );
+			}
+
+			/**
+				@brief for each i in [0,n), performs
+					X::assign(s[i],c). yields:s.
+			*/
+			static inline char_type* assign( char_type* s, size_type n, char_type a )
+			{
+				GSTL_ASSERT( s != 0 && "s is null" );
+
+				char_type* str = s;
+				while( n-- )
+				{
+					assign( *s++, a );
+				}
+				return str;
+			}
+
+			/**
+				@brief yields: e if X::eq_int_type(e,X::eof()) is
+					false, otherwise a value f such that
+					X::eq_int_type(f,X::eof())is false.
+			*/
+			static inline int_type not_eof( const int_type& c )
+			{
+				if( eq_int_type( c, eof() ) )
+				{
+					return ~eof();
+				}
+				else
+				{
+					return c;
 				}
-				++s1;
-				++s2;
 			}
-			return 0;
+
+			/**
+				@brief yields: if for some c,
+					X::eq_int_type(e,X::to_int_type(c))
+					is true, c; else some unspecified value.
+			*/
+			static inline char_type to_char_type( const int_type& c )
+			{
+				return static_cast<char_type>( c );
+			}
+
+			/**
+				@brief yields: some value e, constrained by the definitions
+					of to_char_type and eq_int_type
+			*/
+			static inline int_type to_int_type( const char_type& c )
+			{
+				return c;
+			}
+
+			/**
+				@brief yields: for all c and d, X::eq(c,d) is equal to
+					X::eq_int_type(X::to_int_type(c),
+					X::to_int_type(d)); otherwise, yields true if
+					e and f are both copies of X::eof(); otherwise,
+					yields false if one of e and f are copies of
+					X::eof() and the other is not; otherwise the value
+					is unspecified.
+			*/
+			static inline bool eq_int_type( const int_type& c1, const int_type& c2 )
+			{
+				return c1 == c2;
+			}
+
+			/**
+				@brief yields: a value e such that
+					X::eq_int_type(e,X::to_int_type(c))
+					is false for all values c. 
+			*/
+			static inline int_type eof()
+			{
+				return to_int_type( EOF );
+			}
+		};
+	}
+
+	template<class T>
+	struct char_traits
+		:public detail::generic_char_traits<T>
+	{
+	};
+
+	/**
+	   @brief Character traits for char, based on the C library functions
+	   @details strlen, memchr, memcmp, memcpy/memmove and memset are vectorized
+		and dispatched for the current CPU by the C runtime, so they are used
+		instead of the per-character loops. Characters are compared as unsigned char,
+		the same way as memcmp does.
+	*/
+	template<>
+	struct char_traits<char>
+		:public detail::generic_char_traits<char>
+	{
+		typedef detail::generic_char_traits<char>	base_type;
+
+		using base_type::assign;
+
+		static inline bool lt( const char_type& c, const char_type& d )
+		{
+			return static_cast<unsigned char>( c ) < static_cast<unsigned char>( d );
+		}
+
+		static inline int compare( const char_type* s1, const char_type* s2, size_type n )
+		{
+			GSTL_ASSERT( s1 != 0 && "s1 is null" );
+			GSTL_ASSERT( s2 != 0 && "s2 is null" );
+			return memcmp( s1, s2, static_cast<size_t>( n ) );
 		}
 
-		/**
-			@brief yields: the smallest i such that 
-				X::eq(p[i], charT()) is true.
-		*/
 		static inline size_type length( const char_type* s )
 		{
 			GSTL_ASSERT( s != 0 && "s is null" );
-			size_type len = 0;
-			while( !eq( *s, char_type() ) )
-			{
-				++s;
-				++len;
-			}
-			return len;
+			return strlen( s );
 		}
 
-		/**
-			@brief yields: the smallest q in [p,p+n) such that
-				X::eq(*q,c) is true, zero otherwise
-		*/
 		static inline const char_type* find( const char_type* s, size_type n, const char_type& a )
 		{
 			GSTL_ASSERT( s != 0 && "s is null" );
-			//GSTL_ASSERT( n <= length( s ) + 1 && "n exceeds length of the string" );
-			while( n-- )
-			{
-				if( eq( *s, a ) )
-				{
-					return s;
-				}
-				++s;
-			}
-			return 0;
+			return static_cast<const char_type*>( memchr( s, static_cast<unsigned char>( a ),
+				static_cast<size_t>( n ) ) );
 		}
 
-		/**
-			@brief Moves n chars of the src string into dst
-			
-			@detail For each i in [0,n), performs X::assign(drc[i],dst[i]). 
-					Copies correctly even where the ranges [p, p+n) and [s, s+n) overlap. 
-			@return dst pointer.
-		*/
 		static inline char_type* move( char_type* dst, const char_type* src, size_type n )
 		{
-			return detail::move( dst, src, n );
+			return static_cast<char_type*>( memmove( dst, src, static_cast<size_t>( n ) ) );
 		}
 
-		/**
-			@brief pre: p not in [s,s+n). yields: s. for each i in
-				[0,n), performs X::assign(s[i],p[i]).
-		*/
 		static inline char_type* copy( char_type* s1, const char_type* s2, size_type n )
 		{
-			return move( s1, s2, n );
+			return static_cast<char_type*>( memcpy( s1, s2, static_cast<size_t>( n ) ) );
 		}
 
-		/**
-			@brief for each i in [0,n), performs
-				X::assign(s[i],c). yields:s.
-		*/
 		static inline char_type* assign( char_type* s, size_type n, char_type a )
 		{
 			GSTL_ASSERT( s != 0 && "s is null" );
-
-			char_type* str = s;
-			while( n-- )
-			{
-				assign( *s++, a );
-			}
-			return str;
+			return static_cast<char_type*>( memset( s, static_cast<unsigned char>( a ),
+				static_cast<size_t>( n ) ) );
 		}
 
 		/**
-			@brief yields: e if X::eq_int_type(e,X::eof()) is
-				false, otherwise a value f such that
-				X::eq_int_type(f,X::eof())is false.
+		   @brief Characters are converted as unsigned char, so they never match eof()
 		*/
-		static inline int_type not_eof( const int_type& c )
+		static inline int_type to_int_type( const char_type& c )
 		{
-			if( eq_int_type( c, eof() ) )
-			{
-				return ~eof();
-			}
-			else
-			{
-				return c;
-			}
+			return static_cast<unsigned char>( c );
 		}
+	};
 
-		/**
-			@brief yields: if for some c,
-				X::eq_int_type(e,X::to_int_type(c))
-				is true, c; else some unspecified value.
-		*/
-		static inline char_type to_char_type( const int_type& c )
+	/**
+	   @brief Character traits for wchar_t, based on the C library wide character functions
+	*/
+	template<>
+	struct char_traits<wchar_t>
+		:public detail::generic_char_traits<wchar_t>
+	{
+		typedef detail::generic_char_traits<wchar_t>	base_type;
+
+		using base_type::assign;
+
+		static inline int compare( const char_type* s1, const char_type* s2, size_type n )
 		{
-			return static_cast<char_type>( c );
+			GSTL_ASSERT( s1 != 0 && "s1 is null" );
+			GSTL_ASSERT( s2 != 0 && "s2 is null" );
+			return wmemcmp( s1, s2, static_cast<size_t>( n ) );
 		}
 
-		/**
-			@brief yields: some value e, constrained by the definitions
-				of to_char_type and eq_int_type
-		*/
-		static inline int_type to_int_type( const char_type& c )
+		static inline size_type length( const char_type* s )
 		{
-			return c;
+			GSTL_ASSERT( s != 0 && "s is null" );
+			return wcslen( s );
 		}
 
-		/**
-			@brief yields: for all c and d, X::eq(c,d) is equal to
-				X::eq_int_type(X::to_int_type(c),
-				X::to_int_type(d)); otherwise, yields true if
-				e and f are both copies of X::eof(); otherwise,
-				yields false if one of e and f are copies of
-				X::eof() and the other is not; otherwise the value
-				is unspecified.
-		*/
-		static inline bool eq_int_type( const int_type& c1, const int_type& c2 )
+		static inline const char_type* find( const char_type* s, size_type n, const char_type& a )
 		{
-			return c1 == c2;
+			GSTL_ASSERT( s != 0 && "s is null" );
+			return wmemchr( s, a, static_cast<size_t>( n ) );
 		}
 
-		/**
-			@brief yields: a value e such that
-				X::eq_int_type(e,X::to_int_type(c))
-				is false for all values c. 
-		*/
-		static inline int_type eof()
+		static inline char_type* move( char_type* dst, const char_type* src, size_type n )
 		{
-			return to_int_type( EOF );
+			return wmemmove( dst, src, static_cast<size_t>( n ) );
+		}
+
+		static inline char_type* copy( char_type* s1, const char_type* s2, size_type n )
+		{
+			return wmemcpy( s1, s2, static_cast<size_t>( n ) );
+		}
+
+		static inline char_type* assign( char_type* s, size_type n, char_type a )
+		{
+			GSTL_ASSERT( s != 0 && "s is null" );
+			return wmemset( s, a, static_cast<size_t>( n ) );
 		}
 	};
 }
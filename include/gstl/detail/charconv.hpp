@@ -0,0 +1,936 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_CHARCONV_HEADER
+#define GSTL_CHARCONV_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <locale.h>
+#include <limits>
+#include <gstl/detail/assert.hpp>
+
+#include <gstl/detail/boost_warnings_off.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_signed.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+#include <gstl/detail/boost_warnings_on.hpp>
+
+namespace gstl
+{
+	/**
+	   @brief Error codes of to_chars/from_chars, the same as the std::errc values used by std::to_chars
+	*/
+	enum chars_errc
+	{
+		chars_ok = 0,
+		chars_invalid_argument,
+		chars_value_too_large
+	};
+
+	struct to_chars_result
+	{
+		char* ptr;
+		chars_errc ec;
+	};
+
+	struct from_chars_result
+	{
+		const char* ptr;
+		chars_errc ec;
+	};
+
+	namespace detail
+	{
+		namespace charconv
+		{
+			typedef boost::uint64_t uint64;
+			typedef boost::uint32_t uint32;
+
+			inline to_chars_result make_to_result( char* ptr, chars_errc ec )
+			{
+				to_chars_result result = { ptr, ec };
+				return result;
+			}
+
+			inline from_chars_result make_from_result( const char* ptr, chars_errc ec )
+			{
+				from_chars_result result = { ptr, ec };
+				return result;
+			}
+
+			/**
+			   @brief Pairs of decimal digits for 0..99
+			*/
+			inline const char* digit_pairs()
+			{
+				static const char pairs[] =
+					"00010203040506070809"
+					"10111213141516171819"
+					"20212223242526272829"
+					"30313233343536373839"
+					"40414243444546474849"
+					"50515253545556575859"
+					"60616263646566676869"
+					"70717273747576777879"
+					"80818283848586878889"
+					"90919293949596979899";
+				return pairs;
+			}
+
+			inline int decimal_digits_count( uint64 v )
+			{
+				int count = 1;
+				for( ;; )
+				{
+					if( v < 10 ) return count;
+					if( v < 100 ) return count + 1;
+					if( v < 1000 ) return count + 2;
+					if( v < 10000 ) return count + 3;
+					v /= 10000;
+					count += 4;
+				}
+			}
+
+			/**
+			   @brief Writes exactly count decimal digits of v ending at last, two digits per step
+			*/
+			inline void write_decimal( char* last, uint64 v )
+			{
+				const char* pairs = digit_pairs();
+				while( v >= 100 )
+				{
+					const unsigned idx = static_cast<unsigned>( v % 100 ) * 2;
+					v /= 100;
+					*--last = pairs[idx + 1];
+					*--last = pairs[idx];
+				}
+				if( v >= 10 )
+				{
+					const unsigned idx = static_cast<unsigned>( v ) * 2;
+					*--last = pairs[idx + 1];
+					*--last = pairs[idx];
+				}
+				else
+				{
+					*--last = static_cast<char>( '0' + v );
+				}
+			}
+
+			inline to_chars_result unsigned_to_chars( char* first, char* last, uint64 v, int base )
+			{
+				GSTL_ASSERT( base >= 2 && base <= 36 && "invalid base" );
+				if( base == 10 )
+				{
+					const int count = decimal_digits_count( v );
+					if( last - first < count )
+					{
+						return make_to_result( last, chars_value_too_large );
+					}
+					write_decimal( first + count, v );
+					return make_to_result( first + count, chars_ok );
+				}
+
+				static const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+				char buf[64];
+				char* p = buf + sizeof( buf );
+				do
+				{
+					*--p = digits[v % base];
+					v /= base;
+				}
+				while( v != 0 );
+				const ptrdiff_t count = buf + sizeof( buf ) - p;
+				if( last - first < count )
+				{
+					return make_to_result( last, chars_value_too_large );
+				}
+				memcpy( first, p, count );
+				return make_to_result( first + count, chars_ok );
+			}
+
+			inline int digit_value( char c )
+			{
+				if( c >= '0' && c <= '9' ) return c - '0';
+				if( c >= 'a' && c <= 'z' ) return c - 'a' + 10;
+				if( c >= 'A' && c <= 'Z' ) return c - 'A' + 10;
+				return 36;
+			}
+
+			/**
+			   @brief Parses the digits, value_too_large is reported when the value exceeds max
+			*/
+			inline from_chars_result parse_unsigned( const char* first, const char* last,
+				uint64& value, uint64 max, int base )
+			{
+				GSTL_ASSERT( base >= 2 && base <= 36 && "invalid base" );
+				const char* p = first;
+				uint64 v = 0;
+				bool overflow = false;
+				for( ; p != last; ++p )
+				{
+					const int d = digit_value( *p );
+					if( d >= base )
+					{
+						break;
+					}
+					if( v > ( max - d ) / base )
+					{
+						overflow = true;
+					}
+					else
+					{
+						v = v * base + d;
+					}
+				}
+				if( p == first )
+				{
+					return make_from_result( first, chars_invalid_argument );
+				}
+				value = v;
+				return make_from_result( p, overflow ? chars_value_too_large : chars_ok );
+			}
+
+			//////////////////////////////////////////////////////////////////////////
+			// Grisu2 round-trip, usually shortest formatting of the binary floating point numbers,
+			// see F. Loitsch "Printing Floating-Point Numbers Quickly and Accurately with Integers"
+
+			/**
+			   @brief Floating point number f * 2^e with 64-bit significand
+			*/
+			struct diyfp
+			{
+				uint64 f;
+				int e;
+
+				diyfp( uint64 f_, int e_ )
+					:f( f_ )
+					,e( e_ )
+				{}
+
+				static diyfp sub( const diyfp& x, const diyfp& y )
+				{
+					GSTL_ASSERT( x.e == y.e && x.f >= y.f );
+					return diyfp( x.f - y.f, x.e );
+				}
+
+				/**
+				   @brief Returns x * y rounded to 64 bits
+				*/
+				static diyfp mul( const diyfp& x, const diyfp& y )
+				{
+					const uint64 u_lo = x.f & 0xFFFFFFFFu;
+					const uint64 u_hi = x.f >> 32;
+					const uint64 v_lo = y.f & 0xFFFFFFFFu;
+					const uint64 v_hi = y.f >> 32;
+
+					const uint64 p0 = u_lo * v_lo;
+					const uint64 p1 = u_lo * v_hi;
+					const uint64 p2 = u_hi * v_lo;
+					const uint64 p3 = u_hi * v_hi;
+
+					uint64 q = ( p0 >> 32 ) + ( p1 & 0xFFFFFFFFu ) + ( p2 & 0xFFFFFFFFu );
+					q += uint64( 1 ) << 31;
+
+					return diyfp( p3 + ( p2 >> 32 ) + ( p1 >> 32 ) + ( q >> 32 ), x.e + y.e + 64 );
+				}
+
+				static diyfp normalize( diyfp x )
+				{
+					GSTL_ASSERT( x.f != 0 );
+					while( ( x.f >> 63 ) == 0 )
+					{
+						x.f <<= 1;
+						--x.e;
+					}
+					return x;
+				}
+
+				static diyfp normalize_to( const diyfp& x, int target_exponent )
+				{
+					const int delta = x.e - target_exponent;
+					GSTL_ASSERT( delta >= 0 );
+					return diyfp( x.f << delta, target_exponent );
+				}
+			};
+
+			struct boundaries
+			{
+				diyfp w;
+				diyfp minus;
+				diyfp plus;
+			};
+
+			template<class FloatType>
+			struct float_bits;
+
+			template<>
+			struct float_bits<double>
+			{
+				typedef uint64 type;
+			};
+
+			template<>
+			struct float_bits<float>
+			{
+				typedef uint32 type;
+			};
+
+			/**
+			   @brief Computes the boundaries m- and m+ of the positive finite value,
+				all three numbers have the same exponent
+			*/
+			template<class FloatType>
+			inline boundaries compute_boundaries( FloatType value )
+			{
+				typedef typename float_bits<FloatType>::type bits_type;
+				BOOST_STATIC_ASSERT( sizeof( bits_type ) == sizeof( FloatType ) );
+
+				const int precision = std::numeric_limits<FloatType>::digits; //including the hidden bit
+				const int bias = std::numeric_limits<FloatType>::max_exponent - 1 + ( precision - 1 );
+				const int min_exp = 1 - bias;
+				const uint64 hidden_bit = uint64( 1 ) << ( precision - 1 );
+
+				bits_type bits;
+				memcpy( &bits, &value, sizeof( bits ) );
+				const uint64 e = uint64( bits ) >> ( precision - 1 );
+				const uint64 f = uint64( bits ) & ( hidden_bit - 1 );
+
+				const diyfp v = e == 0
+					? diyfp( f, min_exp )
+					: diyfp( f + hidden_bit, static_cast<int>( e ) - bias );
+
+				//The lower boundary is closer, if the significand is a power of two
+				const bool lower_boundary_is_closer = f == 0 && e > 1;
+				const diyfp m_plus( 2 * v.f + 1, v.e - 1 );
+				const diyfp m_minus = lower_boundary_is_closer
+					? diyfp( 4 * v.f - 1, v.e - 2 )
+					: diyfp( 2 * v.f - 1, v.e - 1 );
+
+				const diyfp w_plus = diyfp::normalize( m_plus );
+				boundaries result = { diyfp::normalize( v ), diyfp::normalize_to( m_minus, w_plus.e ), w_plus };
+				return result;
+			}
+
+			enum
+			{
+				grisu_alpha = -60,
+				grisu_gamma = -32,
+				cached_powers_min_dec_exp = -300,
+				cached_powers_dec_step = 8
+			};
+
+			struct cached_power
+			{
+				uint64 f;
+				int e;
+				int k;
+			};
+
+			/**
+			   @brief Returns c = 10^k normalized to 64 bits, such that
+				alpha <= e_c + e + 64 <= gamma
+			*/
+			inline cached_power get_cached_power( int e )
+			{
+				static const cached_power powers[] =
+				{
+				{ 0xAB70FE17C79AC6CAULL, -1060,  -300 },
+				{ 0xFF77B1FCBEBCDC4FULL, -1034,  -292 },
+				{ 0xBE5691EF416BD60CULL, -1007,  -284 },
+				{ 0x8DD01FAD907FFC3CULL,  -980,  -276 },
+				{ 0xD3515C2831559A83ULL,  -954,  -268 },
+				{ 0x9D71AC8FADA6C9B5ULL,  -927,  -260 },
+				{ 0xEA9C227723EE8BCBULL,  -901,  -252 },
+				{ 0xAECC49914078536DULL,  -874,  -244 },
+				{ 0x823C12795DB6CE57ULL,  -847,  -236 },
+				{ 0xC21094364DFB5637ULL,  -821,  -228 },
+				{ 0x9096EA6F3848984FULL,  -794,  -220 },
+				{ 0xD77485CB25823AC7ULL,  -768,  -212 },
+				{ 0xA086CFCD97BF97F4ULL,  -741,  -204 },
+				{ 0xEF340A98172AACE5ULL,  -715,  -196 },
+				{ 0xB23867FB2A35B28EULL,  -688,  -188 },
+				{ 0x84C8D4DFD2C63F3BULL,  -661,  -180 },
+				{ 0xC5DD44271AD3CDBAULL,  -635,  -172 },
+				{ 0x936B9FCEBB25C996ULL,  -608,  -164 },
+				{ 0xDBAC6C247D62A584ULL,  -582,  -156 },
+				{ 0xA3AB66580D5FDAF6ULL,  -555,  -148 },
+				{ 0xF3E2F893DEC3F126ULL,  -529,  -140 },
+				{ 0xB5B5ADA8AAFF80B8ULL,  -502,  -132 },
+				{ 0x87625F056C7C4A8BULL,  -475,  -124 },
+				{ 0xC9BCFF6034C13053ULL,  -449,  -116 },
+				{ 0x964E858C91BA2655ULL,  -422,  -108 },
+				{ 0xDFF9772470297EBDULL,  -396,  -100 },
+				{ 0xA6DFBD9FB8E5B88FULL,  -369,   -92 },
+				{ 0xF8A95FCF88747D94ULL,  -343,   -84 },
+				{ 0xB94470938FA89BCFULL,  -316,   -76 },
+				{ 0x8A08F0F8BF0F156BULL,  -289,   -68 },
+				{ 0xCDB02555653131B6ULL,  -263,   -60 },
+				{ 0x993FE2C6D07B7FACULL,  -236,   -52 },
+				{ 0xE45C10C42A2B3B06ULL,  -210,   -44 },
+				{ 0xAA242499697392D3ULL,  -183,   -36 },
+				{ 0xFD87B5F28300CA0EULL,  -157,   -28 },
+				{ 0xBCE5086492111AEBULL,  -130,   -20 },
+				{ 0x8CBCCC096F5088CCULL,  -103,   -12 },
+				{ 0xD1B71758E219652CULL,   -77,    -4 },
+				{ 0x9C40000000000000ULL,   -50,     4 },
+				{ 0xE8D4A51000000000ULL,   -24,    12 },
+				{ 0xAD78EBC5AC620000ULL,     3,    20 },
+				{ 0x813F3978F8940984ULL,    30,    28 },
+				{ 0xC097CE7BC90715B3ULL,    56,    36 },
+				{ 0x8F7E32CE7BEA5C70ULL,    83,    44 },
+				{ 0xD5D238A4ABE98068ULL,   109,    52 },
+				{ 0x9F4F2726179A2245ULL,   136,    60 },
+				{ 0xED63A231D4C4FB27ULL,   162,    68 },
+				{ 0xB0DE65388CC8ADA8ULL,   189,    76 },
+				{ 0x83C7088E1AAB65DBULL,   216,    84 },
+				{ 0xC45D1DF942711D9AULL,   242,    92 },
+				{ 0x924D692CA61BE758ULL,   269,   100 },
+				{ 0xDA01EE641A708DEAULL,   295,   108 },
+				{ 0xA26DA3999AEF774AULL,   322,   116 },
+				{ 0xF209787BB47D6B85ULL,   348,   124 },
+				{ 0xB454E4A179DD1877ULL,   375,   132 },
+				{ 0x865B86925B9BC5C2ULL,   402,   140 },
+				{ 0xC83553C5C8965D3DULL,   428,   148 },
+				{ 0x952AB45CFA97A0B3ULL,   455,   156 },
+				{ 0xDE469FBD99A05FE3ULL,   481,   164 },
+				{ 0xA59BC234DB398C25ULL,   508,   172 },
+				{ 0xF6C69A72A3989F5CULL,   534,   180 },
+				{ 0xB7DCBF5354E9BECEULL,   561,   188 },
+				{ 0x88FCF317F22241E2ULL,   588,   196 },
+				{ 0xCC20CE9BD35C78A5ULL,   614,   204 },
+				{ 0x98165AF37B2153DFULL,   641,   212 },
+				{ 0xE2A0B5DC971F303AULL,   667,   220 },
+				{ 0xA8D9D1535CE3B396ULL,   694,   228 },
+				{ 0xFB9B7CD9A4A7443CULL,   720,   236 },
+				{ 0xBB764C4CA7A44410ULL,   747,   244 },
+				{ 0x8BAB8EEFB6409C1AULL,   774,   252 },
+				{ 0xD01FEF10A657842CULL,   800,   260 },
+				{ 0x9B10A4E5E9913129ULL,   827,   268 },
+				{ 0xE7109BFBA19C0C9DULL,   853,   276 },
+				{ 0xAC2820D9623BF429ULL,   880,   284 },
+				{ 0x80444B5E7AA7CF85ULL,   907,   292 },
+				{ 0xBF21E44003ACDD2DULL,   933,   300 },
+				{ 0x8E679C2F5E44FF8FULL,   960,   308 },
+				{ 0xD433179D9C8CB841ULL,   986,   316 },
+				{ 0x9E19DB92B4E31BA9ULL,  1013,   324 },
+				};
+
+				const int f = grisu_alpha - e - 1;
+				const int k = ( f * 78913 ) / ( 1 << 18 ) + ( f > 0 ? 1 : 0 );
+				const int index = ( -cached_powers_min_dec_exp + k + ( cached_powers_dec_step - 1 ) )
+					/ cached_powers_dec_step;
+				GSTL_ASSERT( index >= 0 && index < static_cast<int>( sizeof( powers ) / sizeof( powers[0] ) ) );
+				const cached_power cached = powers[index];
+				GSTL_ASSERT( grisu_alpha <= cached.e + e + 64 && cached.e + e + 64 <= grisu_gamma );
+				return cached;
+			}
+
+			/**
+			   @brief Returns the number of digits of n and the largest power of ten <= n
+			*/
+			inline int find_largest_pow10( uint32 n, uint32& pow10 )
+			{
+				static const uint32 powers[] = { 1u, 10u, 100u, 1000u, 10000u, 100000u,
+					1000000u, 10000000u, 100000000u, 1000000000u };
+				int k = 10;
+				while( k > 1 && n < powers[k - 1] )
+				{
+					--k;
+				}
+				pow10 = powers[k - 1];
+				return k;
+			}
+
+			inline void grisu2_round( char* buf, int len, uint64 dist, uint64 delta,
+				uint64 rest, uint64 ten_k )
+			{
+				//Moves the last digit closer to w, while it stays inside the [M-, M+] range
+				while( rest < dist && delta - rest >= ten_k
+					&& ( rest + ten_k < dist || dist - rest > rest + ten_k - dist ) )
+				{
+					--buf[len - 1];
+					rest += ten_k;
+				}
+			}
+
+			/**
+			   @brief Generates the shortest digits of the number in [M-, M+] closest to w
+			*/
+			inline void grisu2_digit_gen( char* buffer, int& length, int& decimal_exponent,
+				const diyfp& m_minus, const diyfp& w, const diyfp& m_plus )
+			{
+				uint64 delta = diyfp::sub( m_plus, m_minus ).f;
+				uint64 dist = diyfp::sub( m_plus, w ).f;
+
+				const diyfp one( uint64( 1 ) << -m_plus.e, m_plus.e );
+
+				uint32 p1 = static_cast<uint32>( m_plus.f >> -one.e );
+				uint64 p2 = m_plus.f & ( one.f - 1 );
+
+				uint32 pow10;
+				int n = find_largest_pow10( p1, pow10 );
+
+				//Integral part
+				while( n > 0 )
+				{
+					const uint32 d = p1 / pow10;
+					p1 %= pow10;
+					buffer[length++] = static_cast<char>( '0' + d );
+					--n;
+
+					const uint64 rest = ( uint64( p1 ) << -one.e ) + p2;
+					if( rest <= delta )
+					{
+						decimal_exponent += n;
+						grisu2_round( buffer, length, dist, delta, rest, uint64( pow10 ) << -one.e );
+						return;
+					}
+					pow10 /= 10;
+				}
+
+				//Fractional part
+				int m = 0;
+				for( ;; )
+				{
+					p2 *= 10;
+					const uint64 d = p2 >> -one.e;
+					p2 &= one.f - 1;
+					buffer[length++] = static_cast<char>( '0' + d );
+					++m;
+
+					delta *= 10;
+					dist *= 10;
+					if( p2 <= delta )
+					{
+						break;
+					}
+				}
+				decimal_exponent -= m;
+				grisu2_round( buffer, length, dist, delta, p2, one.f );
+			}
+
+			/**
+			   @brief Writes round-trip, usually shortest digits of the positive finite value,
+				value == digits * 10^decimal_exponent
+			*/
+			template<class FloatType>
+			inline void grisu2( char* buffer, int& length, int& decimal_exponent, FloatType value )
+			{
+				const boundaries w = compute_boundaries( value );
+				const cached_power cached = get_cached_power( w.plus.e );
+				const diyfp c_minus_k( cached.f, cached.e );
+
+				const diyfp vw = diyfp::mul( w.w, c_minus_k );
+				const diyfp w_minus = diyfp::mul( w.minus, c_minus_k );
+				const diyfp w_plus = diyfp::mul( w.plus, c_minus_k );
+
+				//Shrink the range by 1 ulp to compensate the errors of the multiplication
+				const diyfp m_minus( w_minus.f + 1, w_minus.e );
+				const diyfp m_plus( w_plus.f - 1, w_plus.e );
+
+				length = 0;
+				decimal_exponent = -cached.k;
+				grisu2_digit_gen( buffer, length, decimal_exponent, m_minus, vw, m_plus );
+			}
+
+			/**
+			   @brief Formats digits * 10^exp in the shorter of the fixed and the scientific
+				notations, the fixed one is preferred on tie (the same as std::to_chars)
+			*/
+			inline char* format_shortest( char* out, const char* digits, int len, int exp )
+			{
+				const int point = len + exp; //position of the decimal point
+				const int sci_exp = point - 1;
+				const int abs_sci_exp = sci_exp < 0 ? -sci_exp : sci_exp;
+				const int sci_len = len + ( len > 1 ? 1 : 0 ) + 2 + ( abs_sci_exp >= 100 ? 3 : 2 );
+				const int fixed_len = point >= len ? point
+					: ( point > 0 ? len + 1 : 2 - point + len );
+
+				if( fixed_len <= sci_len )
+				{
+					if( point >= len )
+					{//digits000
+						memcpy( out, digits, len );
+						memset( out + len, '0', point - len );
+						return out + point;
+					}
+					if( point > 0 )
+					{//dig.its
+						memcpy( out, digits, point );
+						out[point] = '.';
+						memcpy( out + point + 1, digits + point, len - point );
+						return out + len + 1;
+					}
+					//0.000digits
+					out[0] = '0';
+					out[1] = '.';
+					memset( out + 2, '0', -point );
+					memcpy( out + 2 - point, digits, len );
+					return out + 2 - point + len;
+				}
+
+				//d.igitse+XX
+				*out++ = digits[0];
+				if( len > 1 )
+				{
+					*out++ = '.';
+					memcpy( out, digits + 1, len - 1 );
+					out += len - 1;
+				}
+				*out++ = 'e';
+				*out++ = sci_exp < 0 ? '-' : '+';
+				const int count = abs_sci_exp >= 100 ? 3 : 2;
+				write_decimal( out + count, static_cast<uint64>( abs_sci_exp ) );
+				if( abs_sci_exp < 10 )
+				{
+					out[0] = '0';
+				}
+				return out + count;
+			}
+
+			template<class FloatType>
+			inline to_chars_result float_to_chars( char* first, char* last, FloatType value )
+			{
+				//sign, 17 digits, "0." and 5 leading zeros, or exponent
+				char buf[32];
+				char* out = buf;
+				typename float_bits<FloatType>::type bits;
+				memcpy( &bits, &value, sizeof( bits ) );
+				if( ( bits >> ( sizeof( bits ) * 8 - 1 ) ) != 0 )
+				{
+					*out++ = '-';
+					value = -value;
+				}
+				if( value != value )
+				{
+					memcpy( out, "nan", 3 );
+					out += 3;
+				}
+				else
+				{
+					if( value == 0 )
+					{
+						*out++ = '0';
+					}
+					else if( value > ( std::numeric_limits<FloatType>::max )() )
+					{
+						memcpy( out, "inf", 3 );
+						out += 3;
+					}
+					else
+					{
+						char digits[20];
+						int len, exp;
+						grisu2( digits, len, exp, value );
+						out = format_shortest( out, digits, len, exp );
+					}
+				}
+				const ptrdiff_t size = out - buf;
+				if( last - first < size )
+				{
+					return make_to_result( last, chars_value_too_large );
+				}
+				memcpy( first, buf, size );
+				return make_to_result( first + size, chars_ok );
+			}
+
+			inline bool match_word( const char*& p, const char* last, const char* word )
+			{
+				const char* q = p;
+				for( ; *word != 0; ++word, ++q )
+				{
+					if( q == last || ( *q | 0x20 ) != *word )
+					{
+						return false;
+					}
+				}
+				p = q;
+				return true;
+			}
+
+			/**
+			   @brief Parses [-]digits[.digits][(e|E)[+|-]digits], inf, infinity or nan
+			   @details Numbers with up to 19 significant digits and the decimal exponent
+				in [-22, 22] are converted exactly by one multiplication or division
+				(Clinger's fast path), other numbers are converted by strtod.
+			*/
+			inline from_chars_result parse_double( const char* first, const char* last, double& value )
+			{
+				const char* p = first;
+				const bool negative = p != last && *p == '-';
+				if( negative )
+				{
+					++p;
+				}
+
+				if( p != last && ( *p == 'i' || *p == 'I' || *p == 'n' || *p == 'N' ) )
+				{
+					if( match_word( p, last, "inf" ) )
+					{
+						match_word( p, last, "inity" );
+						value = negative ? -std::numeric_limits<double>::infinity()
+							: std::numeric_limits<double>::infinity();
+						return make_from_result( p, chars_ok );
+					}
+					if( match_word( p, last, "nan" ) )
+					{
+						value = std::numeric_limits<double>::quiet_NaN();
+						return make_from_result( p, chars_ok );
+					}
+					return make_from_result( first, chars_invalid_argument );
+				}
+
+				const char* digits_begin = p;
+				uint64 mantissa = 0;
+				int significant = 0;
+				int exp10 = 0;
+				bool any_digit = false;
+				for( ; p != last && *p >= '0' && *p <= '9'; ++p )
+				{
+					any_digit = true;
+					if( significant < 19 )
+					{
+						mantissa = mantissa * 10 + ( *p - '0' );
+						if( mantissa != 0 )
+						{
+							++significant;
+						}
+					}
+					else
+					{
+						++exp10;
+						++significant;
+					}
+				}
+				if( p != last && *p == '.' )
+				{
+					++p;
+					for( ; p != last && *p >= '0' && *p <= '9'; ++p )
+					{
+						any_digit = true;
+						if( significant < 19 )
+						{
+							mantissa = mantissa * 10 + ( *p - '0' );
+							--exp10;
+							if( mantissa != 0 )
+							{
+								++significant;
+							}
+						}
+						else
+						{
+							++significant;
+						}
+					}
+				}
+				if( !any_digit )
+				{
+					return make_from_result( first, chars_invalid_argument );
+				}
+				const char* digits_end = p;
+
+				if( p != last && ( *p == 'e' || *p == 'E' ) )
+				{
+					const char* q = p + 1;
+					const bool exp_negative = q != last && *q == '-';
+					if( q != last && ( *q == '-' || *q == '+' ) )
+					{
+						++q;
+					}
+					if( q != last && *q >= '0' && *q <= '9' )
+					{
+						int e = 0;
+						for( ; q != last && *q >= '0' && *q <= '9'; ++q )
+						{
+							if( e < 100000 )
+							{
+								e = e * 10 + ( *q - '0' );
+							}
+						}
+						exp10 += exp_negative ? -e : e;
+						p = q;
+					}
+				}
+
+				static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+					1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+				double result;
+				if( significant <= 19 && mantissa <= ( uint64( 1 ) << 53 )
+					&& exp10 >= -22 && exp10 <= 22 )
+				{
+					result = static_cast<double>( mantissa );
+					result = exp10 < 0 ? result / powers[-exp10] : result * powers[exp10];
+				}
+				else if( mantissa == 0 )
+				{
+					result = 0;
+				}
+				else
+				{
+					//Slow path: strtod of the copy, the decimal point is replaced by the one of the C locale
+					const ptrdiff_t size = p - digits_begin;
+					char local_buf[128];
+					char* buf = size < static_cast<ptrdiff_t>( sizeof( local_buf ) )
+						? local_buf : static_cast<char*>( malloc( size + 1 ) );
+					if( buf == 0 )
+					{
+						return make_from_result( first, chars_value_too_large );
+					}
+					memcpy( buf, digits_begin, size );
+					buf[size] = 0;
+					const char decimal_point = *localeconv()->decimal_point;
+					if( decimal_point != '.' )
+					{
+						char* point = static_cast<char*>( memchr( buf, '.', digits_end - digits_begin ) );
+						if( point != 0 )
+						{
+							*point = decimal_point;
+						}
+					}
+					result = strtod( buf, 0 );
+					if( buf != local_buf )
+					{
+						free( buf );
+					}
+				}
+
+				if( result > ( std::numeric_limits<double>::max )() )
+				{
+					return make_from_result( p, chars_value_too_large );
+				}
+				value = negative ? -result : result;
+				return make_from_result( p, chars_ok );
+			}
+		}
+	}
+
+	/**
+	   @brief Writes the integer value in the given base to [first, last)
+	   @details Decimal digits are written two at a time from the table of the digit pairs.
+		On success returns the end of the written characters, otherwise returns last
+		and chars_value_too_large.
+	*/
+	template<class Int>
+	inline typename boost::enable_if< boost::is_integral<Int>, to_chars_result >::type
+		to_chars( char* first, char* last, Int value, int base = 10 )
+	{
+		typedef typename boost::make_unsigned<Int>::type unsigned_type;
+		unsigned_type magnitude = static_cast<unsigned_type>( value );
+		if( boost::is_signed<Int>::value && value < 0 )
+		{
+			if( first == last )
+			{
+				return detail::charconv::make_to_result( last, chars_value_too_large );
+			}
+			*first++ = '-';
+			magnitude = static_cast<unsigned_type>( 0 - magnitude );
+		}
+		return detail::charconv::unsigned_to_chars( first, last, magnitude, base );
+	}
+
+	/**
+	   @brief Writes the round-trip, usually shortest (Grisu2) representation of value
+	   @details The result is parsed back to the same value. Grisu2 may emit a digit more
+		than the shortest form for a few values. The notation is chosen as by std::to_chars:
+		the shorter of the fixed and the scientific ones. Does not depend on the locale.
+	*/
+	inline to_chars_result to_chars( char* first, char* last, double value )
+	{
+		return detail::charconv::float_to_chars( first, last, value );
+	}
+
+	inline to_chars_result to_chars( char* first, char* last, float value )
+	{
+		return detail::charconv::float_to_chars( first, last, value );
+	}
+
+	/**
+	   @brief Parses the integer in the given base from [first, last)
+	   @details Accepts optional '-' for the signed types and the digits, no whitespaces
+		and no prefixes. On error value is not modified.
+	*/
+	template<class Int>
+	inline typename boost::enable_if< boost::is_integral<Int>, from_chars_result >::type
+		from_chars( const char* first, const char* last, Int& value, int base = 10 )
+	{
+		typedef typename boost::make_unsigned<Int>::type unsigned_type;
+		const bool negative = boost::is_signed<Int>::value && first != last && *first == '-';
+		const unsigned_type max_positive = static_cast<unsigned_type>( ( std::numeric_limits<Int>::max )() );
+		const boost::uint64_t max = negative ? boost::uint64_t( max_positive ) + 1 : max_positive;
+
+		boost::uint64_t magnitude = 0;
+		from_chars_result result = detail::charconv::parse_unsigned( negative ? first + 1 : first,
+			last, magnitude, max, base );
+		if( result.ec == chars_invalid_argument )
+		{
+			result.ptr = first;
+		}
+		else if( result.ec == chars_ok )
+		{
+			const unsigned_type u = static_cast<unsigned_type>( magnitude );
+			value = static_cast<Int>( negative ? static_cast<unsigned_type>( 0 - u ) : u );
+		}
+		return result;
+	}
+
+	/**
+	   @brief Parses the floating point number from [first, last)
+	   @details Accepts [-]digits[.digits][(e|E)[+|-]digits], inf, infinity and nan,
+		independently from the locale. Result is correctly rounded.
+	*/
+	inline from_chars_result from_chars( const char* first, const char* last, double& value )
+	{
+		return detail::charconv::parse_double( first, last, value );
+	}
+
+	inline from_chars_result from_chars( const char* first, const char* last, float& value )
+	{
+		double d;
+		from_chars_result result = detail::charconv::parse_double( first, last, d );
+		if( result.ec == chars_ok )
+		{
+			const double abs_d = d < 0 ? -d : d;
+			if( abs_d > ( std::numeric_limits<float>::max )()
+				&& abs_d <= ( std::numeric_limits<double>::max )() )
+			{//finite double out of the float range
+				result.ec = chars_value_too_large;
+			}
+			else
+			{
+				value = static_cast<float>( d );
+			}
+		}
+		return result;
+	}
+}
+
+#endif //GSTL_CHARCONV_HEADER
@@ -0,0 +1,133 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_CONSTRUCT_ARGS_HEADER
+#define GSTL_CONSTRUCT_ARGS_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <new>
+
+#include <gstl/detail/boost_warnings_off.hpp>
+#include <boost/move/move.hpp>
+#include <boost/preprocessor/cat.hpp>
+#include <boost/preprocessor/control/expr_if.hpp>
+#include <boost/preprocessor/iteration/local.hpp>
+#include <boost/preprocessor/punctuation/comma_if.hpp>
+#include <boost/preprocessor/repetition/enum.hpp>
+#include <boost/preprocessor/repetition/enum_params.hpp>
+#include <boost/preprocessor/repetition/repeat.hpp>
+#include <gstl/detail/boost_warnings_on.hpp>
+
+/**
+   @brief Maximum number of arguments accepted by emplace-like methods
+*/
+#ifndef GSTL_MAX_CONSTRUCT_ARGS
+#	define GSTL_MAX_CONSTRUCT_ARGS 5
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+//Helpers for declaration of the functions with 0..GSTL_MAX_CONSTRUCT_ARGS
+//forwarded arguments, see BOOST_PP_LOCAL_ITERATE
+#define GSTL_PP_TEMPLATE_HEAD( n )\
+	BOOST_PP_EXPR_IF( n, template< ) BOOST_PP_ENUM_PARAMS( n, class P ) BOOST_PP_EXPR_IF( n, > )
+
+#define GSTL_PP_FWD_PARAM( z, n, data )\
+	BOOST_FWD_REF( BOOST_PP_CAT( P, n ) ) BOOST_PP_CAT( p, n )
+
+#define GSTL_PP_FWD_ARG( z, n, data )\
+	::boost::forward< BOOST_PP_CAT( P, n ) >( BOOST_PP_CAT( p, n ) )
+
+#define GSTL_PP_FWD_PARAMS( n ) BOOST_PP_ENUM( n, GSTL_PP_FWD_PARAM, ~ )
+#define GSTL_PP_FWD_ARGS( n ) BOOST_PP_ENUM( n, GSTL_PP_FWD_ARG, ~ )
+
+#define GSTL_PP_CONSTRUCT_ARGS_TYPE( n )\
+	::gstl::detail::BOOST_PP_CAT( construct_args, n )\
+	BOOST_PP_EXPR_IF( n, < ) BOOST_PP_ENUM_PARAMS( n, P ) BOOST_PP_EXPR_IF( n, > )
+
+/**
+   @brief Packs forwarded arguments of the emplace-like method into the object,
+	which can construct value of any type in place, see detail::construct_args
+*/
+#define GSTL_PP_CONSTRUCT_ARGS( n )\
+	::gstl::detail::make_construct_args( GSTL_PP_FWD_ARGS( n ) )
+
+#define GSTL_PP_ARGS_MEMBER( z, n, data )\
+	BOOST_FWD_REF( BOOST_PP_CAT( P, n ) ) BOOST_PP_CAT( m, n );
+
+#define GSTL_PP_ARGS_MEMBER_INIT( z, n, data )\
+	BOOST_PP_CAT( m, n )( ::boost::forward< BOOST_PP_CAT( P, n ) >( BOOST_PP_CAT( p, n ) ) )
+
+#define GSTL_PP_ARGS_MEMBER_FWD( z, n, data )\
+	::boost::forward< BOOST_PP_CAT( P, n ) >( BOOST_PP_CAT( m, n ) )
+
+namespace gstl
+{
+	namespace detail
+	{
+		/**
+		   @brief Constructs object of type T at p from the forwarded value
+		*/
+		template<class T, class V>
+		static inline void construct( T* p, BOOST_FWD_REF( V ) v )
+		{
+			::new( static_cast<void*>( p ) ) T( ::boost::forward<V>( v ) );
+		}
+
+		/**
+		   @brief construct_argsN classes
+		   @details Hold references to the arguments passed to emplace-like method
+			and construct object of any type in place from them. This lets containers
+			implement emplacement once, independently of the number of arguments.
+			Objects must not outlive the full expression they were created in.
+		*/
+#define BOOST_PP_LOCAL_MACRO( n )\
+		GSTL_PP_TEMPLATE_HEAD( n )\
+		struct BOOST_PP_CAT( construct_args, n )\
+		{\
+			BOOST_PP_REPEAT( n, GSTL_PP_ARGS_MEMBER, ~ )\
+			\
+			explicit BOOST_PP_CAT( construct_args, n )( GSTL_PP_FWD_PARAMS( n ) )\
+				BOOST_PP_EXPR_IF( n, : ) BOOST_PP_ENUM( n, GSTL_PP_ARGS_MEMBER_INIT, ~ )\
+			{}\
+			\
+			template<class T>\
+			void construct( T* p ) const\
+			{\
+				::new( static_cast<void*>( p ) ) T( BOOST_PP_ENUM( n, GSTL_PP_ARGS_MEMBER_FWD, ~ ) );\
+			}\
+		};\
+		\
+		GSTL_PP_TEMPLATE_HEAD( n )\
+		inline GSTL_PP_CONSTRUCT_ARGS_TYPE( n ) make_construct_args( GSTL_PP_FWD_PARAMS( n ) )\
+		{\
+			return GSTL_PP_CONSTRUCT_ARGS_TYPE( n )( GSTL_PP_FWD_ARGS( n ) );\
+		}
+#define BOOST_PP_LOCAL_LIMITS ( 0, GSTL_MAX_CONSTRUCT_ARGS )
+#include BOOST_PP_LOCAL_ITERATE()
+	}
+}
+
+#endif //GSTL_CONSTRUCT_ARGS_HEADER
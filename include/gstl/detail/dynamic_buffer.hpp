@@ -31,6 +31,8 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 #include <gstl/allocator>
 #include <gstl/algorithm>
 #include <gstl/detail/buffer_helpers.hpp>
+#include <gstl/detail/growth_policy.hpp>
+#include <gstl/detail/allocator_expansion.hpp>
 #include <gstl/detail/sequence_iterator.hpp>
 
 
@@ -41,10 +43,14 @@ namespace gstl
 		template<class T>
 		struct default_sequence_traits
 		{
+			/**
+			   @brief Moves size items from the src buffer into uninitialized dst buffer
+			   @details Source items are destroyed, see detail::relocate
+			*/
 			template<class SizeType>
-			static inline const T* move( T* dst, const T* src, SizeType size )
+			static inline T* move( T* dst, T* src, SizeType size )
 			{	
-				return detail::move( dst, src, size );
+				return detail::relocate( dst, src, size );
 			}
 		};
 
@@ -52,12 +58,13 @@ namespace gstl
 		<
 			class T,
 			class Alloc,
-			class Traits = default_sequence_traits<T>
+			class Traits = default_sequence_traits<T>,
+			class GrowthPolicy = default_growth_policy
 		>
 		class dynamic_buffer
 		{
 		public:
-			enum{ min_buff_size = 4 };
+			enum{ min_buff_size = GrowthPolicy::min_capacity };
 
 			typedef dynamic_buffer							self_type;
 			typedef typename Alloc::template rebind<T>::other	allocator_type;
@@ -72,6 +79,12 @@ namespace gstl
 			typedef typename allocator_type::difference_type	difference_type;
 
 			typedef Traits										traits_type;
+			typedef GrowthPolicy								growth_policy_type;
+			typedef allocator_expansion<allocator_type>			expansion_type;
+
+			//Items can be moved by allocator's reallocate()
+			typedef boost::mpl::and_< detail::is_bitwise_relocatable<value_type>,
+				detail::has_reallocate<allocator_type> >		can_reallocate;
 
 			pointer	buffer_;
 			size_type		size_;
@@ -98,12 +111,16 @@ namespace gstl
 				{
 					throw_length_error();
 				}
-				if( requested_capacity > reserved_ )
+				if( requested_capacity > reserved_ && !try_expand( requested_capacity ) )
 				{
-					size_type new_reserved = reserved_ + reserved_/2;
-					new_reserved = (gstl::max)(requested_capacity, new_reserved);
+					size_type new_reserved = grown_capacity( requested_capacity );
+					if( try_reallocate( new_reserved ) )
+					{
+						return;
+					}
 
-					pointer new_buffer = alloc_.allocate( new_reserved );
+					pointer new_buffer = expansion_type::allocate_at_least( alloc_,
+						new_reserved, new_reserved );
 					
 					if( !! buffer_ )
 					{
@@ -118,6 +135,70 @@ namespace gstl
 				reserve( n + 1 );
 			}
 
+			/**
+			   @brief Tries to enlarge the current buffer in place, see allocator_expansion
+			   @details At first tries to expand buffer to the capacity calculated by the growth policy,
+				then to the requested capacity. Items are not moved in any case.
+			   @return true if capacity is not less than requested_capacity
+			*/
+			bool try_expand( size_type requested_capacity )
+			{
+				if( requested_capacity <= reserved_ )
+				{
+					return true;
+				}
+				if( ! buffer_ || requested_capacity >= max_size() )
+				{
+					return false;
+				}
+				size_type new_reserved = grown_capacity( requested_capacity );
+				if( expansion_type::try_expand( alloc_, buffer_, reserved_, new_reserved ) )
+				{
+					reserved_ = new_reserved;
+					return true;
+				}
+				if( new_reserved != requested_capacity
+					&& expansion_type::try_expand( alloc_, buffer_, reserved_, requested_capacity ) )
+				{
+					reserved_ = requested_capacity;
+					return true;
+				}
+				return false;
+			}
+
+			/**
+			   @brief Tries to move the buffer by the allocator, see allocator_expansion
+			   @details Possible only for bitwise relocatable items and the allocators
+				with reallocate(), e.g. mmap_allocator remaps pages instead of copying.
+			   @return true if the buffer holds new_reserved items now
+			*/
+			bool try_reallocate( size_type new_reserved )
+			{
+				if( ! can_reallocate::value || ! buffer_ || new_reserved >= max_size() )
+				{
+					return false;
+				}
+				pointer new_buffer = expansion_type::reallocate( alloc_, buffer_, reserved_, new_reserved );
+				if( ! new_buffer )
+				{
+					return false;
+				}
+				buffer_ = new_buffer;
+				reserved_ = new_reserved;
+				return true;
+			}
+
+			/**
+			   @brief Calculates capacity of the new buffer by the growth policy
+			   @return capacity not less than requested and not greater than max_size()
+			*/
+			size_type grown_capacity( size_type requested_capacity ) const
+			{
+				size_type new_reserved = growth_policy_type::new_capacity( alloc_,
+					reserved_, requested_capacity );
+				return (gstl::min)( (gstl::max)( requested_capacity, new_reserved ), max_size() );
+			}
+
 			value_type* get_buffer()
 			{
 				return &*buffer_;
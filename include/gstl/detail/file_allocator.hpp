@@ -0,0 +1,416 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_FILE_ALLOCATOR_HEADER
+#define GSTL_FILE_ALLOCATOR_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#if defined(_WIN32)
+#	error "gstl::file_allocator requires POSIX mmap"
+#endif
+
+#include <gstl/detail/assert.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <new>
+#include <stdexcept>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace gstl
+{
+	namespace detail
+	{
+		/**
+		   @brief File mapped at the fixed address, holds the items of one container
+		   @details File layout is the header page followed by the items.
+			Address space for reserve_bytes of items is reserved on open,
+			so growth extends the file and maps it in place, the items never move.
+			The header keeps the number of items, see file_backed.
+		*/
+		class mapped_file
+			:private boost::noncopyable
+		{
+		public:
+			struct header
+			{
+				char			magic[8];
+				boost::uint64_t	item_size;
+				boost::uint64_t	size;
+			};
+
+			static size_t default_reservation()
+			{
+				return static_cast<size_t>( 1 ) << ( sizeof( void* ) >= 8 ? 36 : 30 );
+			}
+
+			/**
+			   @brief Opens or creates the file
+			   @exception std::runtime_error if the file can't be opened or has the wrong format
+			*/
+			mapped_file( const char* path, size_t item_size, size_t reserve_bytes )
+				:fd_( -1 ),
+				base_( 0 ),
+				reserved_( 0 ),
+				mapped_( 0 ),
+				in_use_( false )
+			{
+				page_size_ = static_cast<size_t>( ::sysconf( _SC_PAGESIZE ) );
+				fd_ = ::open( path, O_RDWR | O_CREAT, 0644 );
+				if( fd_ < 0 )
+				{
+					throw std::runtime_error( "can't open file" );
+				}
+				try
+				{
+					_open( item_size, reserve_bytes );
+				}
+				catch(...)
+				{
+					_close();
+					throw;
+				}
+			}
+
+			~mapped_file()
+			{
+				sync();
+				_close();
+			}
+
+			char* data() const
+			{
+				return base_ + page_size_;
+			}
+
+			size_t data_capacity() const
+			{
+				return mapped_ - page_size_;
+			}
+
+			size_t max_data_size() const
+			{
+				return reserved_ - page_size_;
+			}
+
+			/**
+			   @brief Stored number of items
+			*/
+			size_t stored_size() const
+			{
+				return static_cast<size_t>( _header().size );
+			}
+
+			void store_size( size_t size )
+			{
+				_header().size = size;
+			}
+
+			/**
+			   @brief Extends the file, so it holds at least bytes of items
+			   @return false if bytes exceed the reserved address space or the file can't be extended
+			*/
+			bool grow( size_t bytes )
+			{
+				if( bytes <= data_capacity() )
+				{
+					return true;
+				}
+				if( bytes > max_data_size() )
+				{
+					return false;
+				}
+				size_t new_mapped = _round( page_size_ + bytes );
+				if( ::ftruncate( fd_, static_cast<off_t>( new_mapped ) ) != 0 )
+				{
+					return false;
+				}
+				return _map( new_mapped );
+			}
+
+			/**
+			   @brief Returns the items block, there is only one block per file
+			   @exception std::bad_alloc if the block is in use or the file can't be extended
+			*/
+			char* acquire( size_t bytes )
+			{
+				if( in_use_ || !grow( bytes ) )
+				{
+					throw std::bad_alloc();
+				}
+				in_use_ = true;
+				return data();
+			}
+
+			void release( const void* ptr )
+			{
+				GSTL_ASSERT( ptr == data() && in_use_ && "block doesn't belong to the file" );
+				in_use_ = false;
+			}
+
+			void sync()
+			{
+				if( base_ )
+				{
+					::msync( base_, mapped_, MS_SYNC );
+				}
+			}
+
+		private:
+			void _open( size_t item_size, size_t reserve_bytes )
+			{
+				struct stat info;
+				if( ::fstat( fd_, &info ) != 0 )
+				{
+					throw std::runtime_error( "can't get file size" );
+				}
+				size_t file_size = static_cast<size_t>( info.st_size );
+				bool created = file_size == 0;
+				if( created )
+				{
+					file_size = page_size_;
+					if( ::ftruncate( fd_, static_cast<off_t>( file_size ) ) != 0 )
+					{
+						throw std::runtime_error( "can't extend file" );
+					}
+				}
+
+				reserved_ = _round( page_size_ + ( reserve_bytes > file_size ? reserve_bytes : file_size ) );
+				void* base = ::mmap( 0, reserved_, PROT_NONE,
+					MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+				if( base == MAP_FAILED )
+				{
+					throw std::runtime_error( "can't reserve address space" );
+				}
+				base_ = static_cast<char*>( base );
+				if( !_map( _round( file_size ) ) )
+				{
+					throw std::runtime_error( "can't map file" );
+				}
+
+				header& head = _header();
+				if( created )
+				{
+					memcpy( head.magic, magic(), sizeof( head.magic ) );
+					head.item_size = item_size;
+					head.size = 0;
+				}
+				else if( memcmp( head.magic, magic(), sizeof( head.magic ) ) != 0
+					|| head.item_size != item_size
+					|| head.size > data_capacity() / item_size )
+				{
+					throw std::runtime_error( "invalid file format" );
+				}
+			}
+
+			void _close()
+			{
+				if( base_ )
+				{
+					::munmap( base_, reserved_ );
+					base_ = 0;
+				}
+				if( fd_ >= 0 )
+				{
+					::close( fd_ );
+					fd_ = -1;
+				}
+			}
+
+			//Maps the first bytes of the file over the reserved space
+			bool _map( size_t bytes )
+			{
+				void* ptr = ::mmap( base_, bytes, PROT_READ | PROT_WRITE,
+					MAP_SHARED | MAP_FIXED, fd_, 0 );
+				if( ptr == MAP_FAILED )
+				{
+					return false;
+				}
+				mapped_ = bytes;
+				return true;
+			}
+
+			size_t _round( size_t bytes ) const
+			{
+				return ( bytes + page_size_ - 1 ) / page_size_ * page_size_;
+			}
+
+			header& _header() const
+			{
+				return *reinterpret_cast<header*>( base_ );
+			}
+
+			static const char* magic()
+			{
+				return "GSTLFILE";
+			}
+
+			int		fd_;
+			char*	base_;
+			size_t	page_size_;
+			size_t	reserved_;
+			size_t	mapped_;
+			bool	in_use_;
+		};
+	}
+
+	/**
+	   @brief Allocator, which places the container items into the mapped file
+	   @details The file holds one block, which is expanded in place by try_expand 
+		(see allocator_expansion), so vector and basic_string grow without copying.
+		The second allocation is not possible while the block is in use,
+		see file_backed for the supported container operations.
+		Use it through file_backed, which restores the container on reopen.
+	*/
+	template< class T >
+	class file_allocator
+	{
+	public:
+		typedef T									value_type;
+
+		typedef file_allocator< value_type >		self_type;
+
+		typedef value_type*			pointer;
+		typedef const value_type* 	const_pointer;
+		typedef value_type&			reference;
+		typedef const value_type&	const_reference;
+		
+		typedef size_t								size_type;
+		typedef ptrdiff_t							difference_type;
+
+		typedef boost::shared_ptr<detail::mapped_file>	file_pointer;
+
+		template<class Other>
+		struct rebind
+		{
+			typedef file_allocator< Other > other;
+		};
+
+		explicit file_allocator( const file_pointer& file )
+			:file_( file )
+		{
+		}
+
+		template<class Other>
+		file_allocator( const file_allocator<Other>& rhs )
+			:file_( rhs.file() )
+		{
+		}
+
+		pointer address( reference val ) const
+		{	
+			return pointer(&val);
+		}
+
+		const_pointer address( const_reference val ) const
+		{	
+			return const_pointer(&val);
+		}
+
+		/**
+		   @exception std::bad_alloc if the file block is already allocated
+		*/
+		pointer allocate( size_type count, const void* /*hint*/ = 0 )
+		{
+			if( count > max_size() )
+			{
+				throw std::bad_alloc();
+			}
+			return reinterpret_cast<pointer>( file_->acquire( count * sizeof( value_type ) ) );
+		}
+
+		/**
+		   @brief Allocates the file block, reports all items, which fit the file
+		*/
+		pointer allocate_at_least( size_type count, size_type& allocated )
+		{
+			pointer ptr = allocate( count );
+			allocated = file_->data_capacity() / sizeof( value_type );
+			return ptr;
+		}
+
+		void deallocate( pointer ptr, size_type /*count*/ )
+		{
+			if( ptr )
+			{
+				file_->release( ptr );
+			}
+		}
+
+		/**
+		   @brief Extends the file, the block never moves
+		*/
+		bool try_expand( pointer ptr, size_type /*old_count*/, size_type new_count )
+		{
+			return ptr == reinterpret_cast<pointer>( file_->data() )
+				&& new_count <= max_size()
+				&& file_->grow( new_count * sizeof( value_type ) );
+		}
+
+		void construct( pointer ptr, const_reference val )
+		{	
+			::new (ptr) value_type(val);
+		}
+
+		void destroy( pointer ptr )
+		{	
+			ptr;//VS 2008 warning
+			ptr->~value_type();
+		}
+
+		size_type max_size() const 
+		{	
+			size_type count = file_->max_data_size() / sizeof(value_type);
+			return (0 < count ? count : 1);
+		}
+
+		const file_pointer& file() const
+		{
+			return file_;
+		}
+
+	private:
+		file_pointer	file_;
+	};
+
+	template<class T, class U>
+	inline bool operator==( const file_allocator<T>& lhs, const file_allocator<U>& rhs )
+	{
+		return lhs.file() == rhs.file();
+	}
+
+	template<class T, class U>
+	inline bool operator!=( const file_allocator<T>& lhs, const file_allocator<U>& rhs )
+	{
+		return !( lhs == rhs );
+	}
+}
+
+#endif //GSTL_FILE_ALLOCATOR_HEADER
@@ -0,0 +1,175 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_FILE_BACKED_HEADER
+#define GSTL_FILE_BACKED_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <gstl/detail/file_allocator.hpp>
+#include <gstl/detail/buffer_helpers.hpp>
+#include <gstl/detail/vector.hpp>
+#include <gstl/detail/basic_string.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <string.h>
+
+namespace gstl
+{
+	namespace detail
+	{
+		/**
+		   @brief Opens the file for file_backed
+		   @details Used as the first base of file_backed, so the file is mapped
+			before the container is constructed. The first stored item is saved aside,
+			as moving of the empty basic_string into the file writes the terminator over it.
+		*/
+		template<class T>
+		class file_storage
+		{
+		public:
+			typedef boost::shared_ptr<mapped_file>	file_pointer;
+
+			file_storage( const char* path, size_t reserve_bytes )
+				:file_( boost::make_shared<mapped_file>( path, sizeof( T ), reserve_bytes ) )
+			{
+				if( file_->stored_size() )
+				{
+					memcpy( first_item_.address(), file_->data(), sizeof( T ) );
+				}
+			}
+
+			const file_pointer& file() const
+			{
+				return file_;
+			}
+
+			void restore_first_item( T* dst ) const
+			{
+				memcpy( dst, first_item_.address(), sizeof( T ) );
+			}
+
+		private:
+			file_pointer file_;
+			boost::aligned_storage< sizeof( T ), boost::alignment_of<T>::value > first_item_;
+		};
+	}
+
+	/**
+	   @brief Container, which lives in the memory mapped file
+	   @details Container must use file_allocator, see file_vector and file_string.
+		Opening the existing file gives back the stored items without
+		any deserialization, growth extends the file in place.
+		The number of items is written into the file by sync() and
+		the destructor. Items must be bitwise relocatable and must not refer 
+		to the memory outside of the file.
+
+		The file holds a single block of items, which grows in place, so all the operations
+		on the container itself are supported: push_back, emplace, insert of any iterator
+		category, append, replace (the self-overlapping one as well), erase, resize and reserve.
+		Operations, which need the second block of the same allocator, throw std::bad_alloc:
+		growth past reserve_bytes and the copies, which take the container allocator
+		(copy construction, substr or operator+ of the strings longer than the local buffer).
+		Copy the items into a container with another allocator instead.
+	*/
+	template<class Container>
+	class file_backed
+		:private detail::file_storage<typename Container::value_type>,
+		public Container
+	{
+		typedef detail::file_storage<typename Container::value_type>	storage_type;
+	public:
+		typedef Container								container_type;
+		typedef file_backed								self_type;
+
+		typedef typename container_type::value_type		value_type;
+		typedef typename container_type::allocator_type	allocator_type;
+		typedef typename container_type::size_type		size_type;
+
+		BOOST_STATIC_ASSERT( detail::is_bitwise_relocatable<value_type>::value );
+
+		/**
+		   @brief Opens or creates the file
+		   @param reserve_bytes address space reserved for the items, the file can't grow past it
+		   @exception std::runtime_error if the file can't be opened or has the wrong format
+		*/
+		explicit file_backed( const char* path,
+			size_t reserve_bytes = detail::mapped_file::default_reservation() )
+			:storage_type( path, reserve_bytes ),
+			container_type( allocator_type( storage_type::file() ) )
+		{
+			//basic_string starts in its local buffer, move it into the file block
+			container_type::reserve( container_type::capacity() + 1 );
+
+			size_type stored = storage_type::file()->stored_size();
+			if( stored )
+			{
+				//The file block is taken as is, the items are not touched
+				container_type::resize_default_init( stored );
+				storage_type::restore_first_item( &*container_type::begin() );
+			}
+		}
+
+		~file_backed()
+		{
+			sync();
+		}
+
+		/**
+		   @brief Stores the number of items and flushes the file
+		*/
+		void sync()
+		{
+			storage_type::file()->store_size( container_type::size() );
+			storage_type::file()->sync();
+		}
+
+	private:
+		file_backed( const self_type& );
+		self_type& operator=( const self_type& );
+	};
+
+	/**
+	   @brief Declares file backed vector, file_vector<T>::type
+	*/
+	template<class T>
+	struct file_vector
+	{
+		typedef file_backed< vector<T, file_allocator<T> > > type;
+	};
+
+	/**
+	   @brief Declares file backed string, file_string<CharT>::type
+	*/
+	template<class CharT, class Traits = char_traits<CharT> >
+	struct file_string
+	{
+		typedef file_backed< basic_string<CharT, Traits, file_allocator<CharT> > > type;
+	};
+}
+
+#endif //GSTL_FILE_BACKED_HEADER
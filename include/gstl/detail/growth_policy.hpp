@@ -0,0 +1,200 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_GROWTH_POLICY_HEADER
+#define GSTL_GROWTH_POLICY_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <stddef.h>
+
+/**
+   @brief Page size used by page_rounded_growth policy
+*/
+#ifndef GSTL_PAGE_SIZE
+#	define GSTL_PAGE_SIZE 4096
+#endif
+
+/**
+   @brief Page size used by huge_page_rounded_growth policy
+*/
+#ifndef GSTL_HUGE_PAGE_SIZE
+#	define GSTL_HUGE_PAGE_SIZE ( 2 * 1024 * 1024 )
+#endif
+
+namespace gstl
+{
+	/**
+	   @brief Growth policy, multiplies current capacity by Num/Den
+	   @details Growth policy calculates capacity of the dynamic buffer
+		(vector, basic_string) when it's reserved or it has to be reallocated.
+		Every policy provides:
+		- min_capacity - minimal capacity of the buffers, which reserve memory on construction;
+		- new_capacity( alloc, current, requested ) - returns capacity for the new buffer,
+		the result must not be less than the requested capacity.
+	   @tparam Num numerator of the growth factor
+	   @tparam Den denominator of the growth factor
+	   @tparam MinCapacity minimal capacity of the buffer
+	*/
+	template<size_t Num, size_t Den, size_t MinCapacity = 4>
+	struct proportional_growth
+	{
+		enum{ min_capacity = MinCapacity };
+
+		template<class Alloc>
+		static typename Alloc::size_type new_capacity( const Alloc& /*alloc*/,
+			typename Alloc::size_type current, typename Alloc::size_type requested )
+		{
+			typedef typename Alloc::size_type size_type;
+			size_type grown = current + current / Den * ( Num - Den );
+			if( grown < current )
+			{//Overflow
+				return requested;
+			}
+			return grown < requested ? requested : grown;
+		}
+	};
+
+	/**
+	   @brief Growth policy, capacity grows by 1.5 times
+	*/
+	struct one_and_half_growth
+		:public proportional_growth<3, 2>
+	{};
+
+	/**
+	   @brief Growth policy, capacity grows twice
+	*/
+	struct double_growth
+		:public proportional_growth<2, 1>
+	{};
+
+	/**
+	   @brief Growth policy, capacity grows by Increment items
+	*/
+	template<size_t Increment, size_t MinCapacity = 4>
+	struct fixed_growth
+	{
+		enum{ min_capacity = MinCapacity };
+
+		template<class Alloc>
+		static typename Alloc::size_type new_capacity( const Alloc& /*alloc*/,
+			typename Alloc::size_type current, typename Alloc::size_type requested )
+		{
+			typedef typename Alloc::size_type size_type;
+			size_type grown = current + Increment;
+			if( grown < current )
+			{//Overflow
+				return requested;
+			}
+			return grown < requested ? requested : grown;
+		}
+	};
+
+	/**
+	   @brief Growth policy, rounds the buffer size in bytes up to the BlockSize
+	   @details Capacity is calculated by the BasePolicy and then is enlarged to use
+		the whole memory block, so there are no unused tail bytes in the allocation.
+	*/
+	template<size_t BlockSize, class BasePolicy = one_and_half_growth>
+	struct rounded_growth
+	{
+		enum{ min_capacity = BasePolicy::min_capacity };
+
+		template<class Alloc>
+		static typename Alloc::size_type new_capacity( const Alloc& alloc,
+			typename Alloc::size_type current, typename Alloc::size_type requested )
+		{
+			typedef typename Alloc::size_type size_type;
+			size_type capacity = BasePolicy::new_capacity( alloc, current, requested );
+			return round_capacity( capacity, static_cast<size_type>( sizeof( typename Alloc::value_type ) ),
+				static_cast<size_type>( BlockSize ) );
+		}
+
+		template<class SizeType>
+		static SizeType round_capacity( SizeType capacity, SizeType item_size, SizeType block_size )
+		{
+			if( capacity > ( SizeType(-1) - block_size ) / item_size )
+			{//Overflow, there is no way to allocate such buffer anyway
+				return capacity;
+			}
+			SizeType bytes = capacity * item_size;
+			bytes = ( bytes + block_size - 1 ) / block_size * block_size;
+			return bytes / item_size;
+		}
+	};
+
+	/**
+	   @brief Growth policy, buffers occupy whole memory pages
+	   @see GSTL_PAGE_SIZE
+	*/
+	template<class BasePolicy = one_and_half_growth>
+	struct page_rounded_growth
+		:public rounded_growth<GSTL_PAGE_SIZE, BasePolicy>
+	{};
+
+	/**
+	   @brief Growth policy, buffers occupy whole huge memory pages
+	   @see GSTL_HUGE_PAGE_SIZE
+	*/
+	template<class BasePolicy = one_and_half_growth>
+	struct huge_page_rounded_growth
+		:public rounded_growth<GSTL_HUGE_PAGE_SIZE, BasePolicy>
+	{};
+
+	/**
+	   @brief Allocation granularity of the allocator in bytes
+	   @details Allocators always return blocks of size multiple of this value.
+		Specialize it for the custom allocators, e.g. for memory-mgr allocators 
+		it's the chunk size of the memory manager.
+	*/
+	template<class Alloc>
+	struct allocator_block_size
+	{
+		enum{ value = 2 * sizeof( void* ) };
+	};
+
+	/**
+	   @brief Growth policy, rounds buffer size up to the real size of the allocator block
+	   @see allocator_block_size
+	*/
+	template<class BasePolicy = one_and_half_growth>
+	struct allocator_rounded_growth
+	{
+		enum{ min_capacity = BasePolicy::min_capacity };
+
+		template<class Alloc>
+		static typename Alloc::size_type new_capacity( const Alloc& alloc,
+			typename Alloc::size_type current, typename Alloc::size_type requested )
+		{
+			typedef rounded_growth<allocator_block_size<Alloc>::value, BasePolicy> rounded_type;
+			return rounded_type::new_capacity( alloc, current, requested );
+		}
+	};
+
+	typedef one_and_half_growth default_growth_policy;
+}
+
+#endif //GSTL_GROWTH_POLICY_HEADER
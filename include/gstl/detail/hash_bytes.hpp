@@ -0,0 +1,174 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_HASH_BYTES_HEADER
+#define GSTL_HASH_BYTES_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <stddef.h>
+#include <string.h>
+
+#include <gstl/detail/boost_warnings_off.hpp>
+#include <boost/cstdint.hpp>
+#include <gstl/detail/boost_warnings_on.hpp>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#	include <intrin.h>
+#	pragma intrinsic(_umul128)
+#endif
+
+namespace gstl
+{
+	namespace detail
+	{
+		namespace hash_impl
+		{
+			typedef boost::uint64_t uint64;
+			typedef boost::uint32_t uint32;
+
+			static const uint64 secret0 = 0xa0761d6478bd642fULL;
+			static const uint64 secret1 = 0xe7037ed1a0b428dbULL;
+			static const uint64 secret2 = 0x8ebc6af09c88c6e3ULL;
+			static const uint64 secret3 = 0x589965cc75374cc3ULL;
+
+			/**
+			   @brief Replaces a and b by the low and the high halves of the 128-bit product a * b
+			*/
+			inline void mum( uint64& a, uint64& b )
+			{
+#if defined(__SIZEOF_INT128__)
+				__extension__ typedef unsigned __int128 uint128;
+				const uint128 r = static_cast<uint128>( a ) * b;
+				a = static_cast<uint64>( r );
+				b = static_cast<uint64>( r >> 64 );
+#elif defined(_MSC_VER) && defined(_M_X64)
+				a = _umul128( a, b, &b );
+#else
+				const uint64 ha = a >> 32, hb = b >> 32;
+				const uint64 la = static_cast<uint32>( a ), lb = static_cast<uint32>( b );
+				const uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+				const uint64 t = rl + ( rm0 << 32 );
+				uint64 c = t < rl;
+				const uint64 lo = t + ( rm1 << 32 );
+				c += lo < t;
+				a = lo;
+				b = rh + ( rm0 >> 32 ) + ( rm1 >> 32 ) + c;
+#endif
+			}
+
+			inline uint64 mix( uint64 a, uint64 b )
+			{
+				mum( a, b );
+				return a ^ b;
+			}
+
+			inline uint64 read8( const unsigned char* p )
+			{
+				uint64 v;
+				memcpy( &v, p, sizeof( v ) );
+				return v;
+			}
+
+			inline uint64 read4( const unsigned char* p )
+			{
+				uint32 v;
+				memcpy( &v, p, sizeof( v ) );
+				return v;
+			}
+
+			inline uint64 read3( const unsigned char* p, size_t k )
+			{
+				return ( static_cast<uint64>( p[0] ) << 16 )
+					| ( static_cast<uint64>( p[k >> 1] ) << 8 ) | p[k - 1];
+			}
+		}
+
+		/**
+		   @brief Hashes len bytes at key
+		   @details wyhash: the input is consumed 8 bytes at a time and the words are mixed
+			by 64x64->128 bit multiplications, short keys are hashed without loops.
+			The result depends only on the bytes and the seed, so it is the same in all
+			processes, which share the data (e.g. maps in the shared memory).
+		*/
+		inline boost::uint64_t hash_bytes( const void* key, size_t len, boost::uint64_t seed = 0 )
+		{
+			using namespace hash_impl;
+			const unsigned char* p = static_cast<const unsigned char*>( key );
+			seed ^= mix( seed ^ secret0, secret1 );
+			uint64 a, b;
+			if( len <= 16 )
+			{
+				if( len >= 4 )
+				{
+					const size_t shift = ( len >> 3 ) << 2;
+					a = ( read4( p ) << 32 ) | read4( p + shift );
+					b = ( read4( p + len - 4 ) << 32 ) | read4( p + len - 4 - shift );
+				}
+				else if( len > 0 )
+				{
+					a = read3( p, len );
+					b = 0;
+				}
+				else
+				{
+					a = b = 0;
+				}
+			}
+			else
+			{
+				size_t i = len;
+				if( i > 48 )
+				{
+					uint64 see1 = seed, see2 = seed;
+					do
+					{
+						seed = mix( read8( p ) ^ secret1, read8( p + 8 ) ^ seed );
+						see1 = mix( read8( p + 16 ) ^ secret2, read8( p + 24 ) ^ see1 );
+						see2 = mix( read8( p + 32 ) ^ secret3, read8( p + 40 ) ^ see2 );
+						p += 48;
+						i -= 48;
+					}
+					while( i > 48 );
+					seed ^= see1 ^ see2;
+				}
+				while( i > 16 )
+				{
+					seed = mix( read8( p ) ^ secret1, read8( p + 8 ) ^ seed );
+					i -= 16;
+					p += 16;
+				}
+				a = read8( p + i - 16 );
+				b = read8( p + i - 8 );
+			}
+			a ^= secret1;
+			b ^= seed;
+			mum( a, b );
+			return mix( a ^ secret0 ^ len, b ^ secret1 );
+		}
+	}
+}
+
+#endif //GSTL_HASH_BYTES_HEADER
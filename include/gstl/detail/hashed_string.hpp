@@ -0,0 +1,260 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_HASHED_STRING_HEADER
+#define GSTL_HASHED_STRING_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <cstddef>
+#include <gstl/utility>
+
+namespace gstl
+{
+	/**
+	   @brief String, which caches its hash
+	   @details The hash is computed on the first request and is kept until the string
+		is modified. The string is read through the const accessors, all modifiers go
+		through the wrapper and drop the cached hash. Comparison checks the hashes
+		first, when both of them are known.
+	*/
+	template<class StringT>
+	class hashed_string
+	{
+	public:
+		typedef StringT									string_type;
+		typedef typename string_type::value_type		value_type;
+		typedef typename string_type::traits_type		traits_type;
+		typedef typename string_type::allocator_type	allocator_type;
+		typedef typename string_type::size_type			size_type;
+		typedef typename string_type::string_view_type	string_view_type;
+		typedef typename string_type::const_iterator	const_iterator;
+
+		explicit hashed_string( const allocator_type& alloc = allocator_type() )
+			:str_( alloc )
+			,hash_( 0 )
+			,has_hash_( false )
+		{}
+
+		hashed_string( const string_type& str )
+			:str_( str )
+			,hash_( 0 )
+			,has_hash_( false )
+		{}
+
+		hashed_string( const value_type* s, const allocator_type& alloc = allocator_type() )
+			:str_( s, alloc )
+			,hash_( 0 )
+			,has_hash_( false )
+		{}
+
+		explicit hashed_string( string_view_type sv, const allocator_type& alloc = allocator_type() )
+			:str_( sv, alloc )
+			,hash_( 0 )
+			,has_hash_( false )
+		{}
+
+		hashed_string& operator=( const string_type& str )
+		{
+			str_ = str;
+			has_hash_ = false;
+			return *this;
+		}
+
+		hashed_string& operator=( const value_type* s )
+		{
+			str_ = s;
+			has_hash_ = false;
+			return *this;
+		}
+
+		/**
+		   @brief Returns hash of the string, it is computed only once after each modification
+		*/
+		std::size_t hash() const
+		{
+			if( !has_hash_ )
+			{
+				hash_ = hash_value( str_ );
+				has_hash_ = true;
+			}
+			return hash_;
+		}
+
+		bool has_cached_hash() const
+		{
+			return has_hash_;
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		const string_type& str() const
+		{
+			return str_;
+		}
+
+		operator const string_type&() const
+		{
+			return str_;
+		}
+
+		operator string_view_type() const
+		{
+			return str_;
+		}
+
+		const value_type* c_str() const
+		{
+			return str_.c_str();
+		}
+
+		const value_type* data() const
+		{
+			return str_.data();
+		}
+
+		size_type size() const
+		{
+			return str_.size();
+		}
+
+		size_type length() const
+		{
+			return str_.length();
+		}
+
+		bool empty() const
+		{
+			return str_.empty();
+		}
+
+		const_iterator begin() const
+		{
+			return str_.begin();
+		}
+
+		const_iterator end() const
+		{
+			return str_.end();
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		hashed_string& assign( string_view_type sv )
+		{
+			str_.assign( sv );
+			has_hash_ = false;
+			return *this;
+		}
+
+		hashed_string& append( string_view_type sv )
+		{
+			str_.append( sv );
+			has_hash_ = false;
+			return *this;
+		}
+
+		hashed_string& operator+=( string_view_type sv )
+		{
+			return append( sv );
+		}
+
+		hashed_string& operator+=( value_type c )
+		{
+			push_back( c );
+			return *this;
+		}
+
+		void push_back( value_type c )
+		{
+			str_.push_back( c );
+			has_hash_ = false;
+		}
+
+		void resize( size_type n, value_type c = value_type() )
+		{
+			str_.resize( n, c );
+			has_hash_ = false;
+		}
+
+		void clear()
+		{
+			str_.clear();
+			has_hash_ = false;
+		}
+
+		void swap( hashed_string& other )
+		{
+			str_.swap( other.str_ );
+			gstl::swap( hash_, other.hash_ );
+			gstl::swap( has_hash_, other.has_hash_ );
+		}
+
+		void swap( string_type& str )
+		{
+			str_.swap( str );
+			has_hash_ = false;
+		}
+
+	private:
+		string_type str_;
+		mutable std::size_t hash_;
+		mutable bool has_hash_;
+	};
+
+	template<class StringT>
+	inline std::size_t hash_value( const hashed_string<StringT>& str )
+	{
+		return str.hash();
+	}
+
+	template<class StringT>
+	inline bool operator==( const hashed_string<StringT>& lhs, const hashed_string<StringT>& rhs )
+	{
+		if( lhs.has_cached_hash() && rhs.has_cached_hash() && lhs.hash() != rhs.hash() )
+		{
+			return false;
+		}
+		return lhs.str() == rhs.str();
+	}
+
+	template<class StringT>
+	inline bool operator!=( const hashed_string<StringT>& lhs, const hashed_string<StringT>& rhs )
+	{
+		return !( lhs == rhs );
+	}
+
+	template<class StringT>
+	inline bool operator<( const hashed_string<StringT>& lhs, const hashed_string<StringT>& rhs )
+	{
+		return lhs.str() < rhs.str();
+	}
+
+	template<class StringT>
+	inline void swap( hashed_string<StringT>& lhs, hashed_string<StringT>& rhs )
+	{
+		lhs.swap( rhs );
+	}
+}
+
+#endif //GSTL_HASHED_STRING_HEADER
@@ -0,0 +1,120 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_ITERATOR_UNWRAP_HEADER
+#define GSTL_ITERATOR_UNWRAP_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <gstl/detail/boost_warnings_off.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+#include <gstl/detail/boost_warnings_on.hpp>
+
+namespace gstl
+{
+	namespace detail
+	{
+		template <class PtrT, class ContainerT>
+		class sequence_iterator;
+
+		/**
+		   @brief Unwrapping protocol of the contiguous iterators
+		   @details Algorithms unwrap iterators to raw pointers, run pointer
+			specialized kernels (memmove, memchr etc.) and rewrap the result back.
+			Iterators, which are not contiguous, are passed as is.
+			Specialize this class for the custom contiguous iterators:
+			- raw_type - type of the unwrapped iterator;
+			- unwrap( it ) - returns raw iterator;
+			- rewrap( orig, raw_orig, raw ) - returns iterator, which corresponds to the raw one,
+			orig is any valid iterator of the same sequence and raw_orig is the unwrapped orig.
+		*/
+		template<class Iterator>
+		struct iterator_unwrapper
+		{
+			typedef Iterator raw_type;
+
+			static raw_type unwrap( const Iterator& it )
+			{
+				return it;
+			}
+
+			static Iterator rewrap( const Iterator& /*orig*/, const raw_type& /*raw_orig*/,
+				const raw_type& raw )
+			{
+				return raw;
+			}
+		};
+
+		/**
+		   @brief Unwraps iterators of vector and basic_string, including
+			the ones built on top of offset pointers
+		*/
+		template <class PtrT, class ContainerT>
+		struct iterator_unwrapper< sequence_iterator<PtrT, ContainerT> >
+		{
+			typedef sequence_iterator<PtrT, ContainerT>		iterator_type;
+			typedef typename boost::remove_reference<
+				typename iterator_type::reference >::type*	raw_type;
+
+			static raw_type unwrap( const iterator_type& it )
+			{
+				return to_raw( it.base() );
+			}
+
+			static iterator_type rewrap( const iterator_type& orig, raw_type raw_orig, raw_type raw )
+			{
+				return orig + ( raw - raw_orig );
+			}
+
+		private:
+			static raw_type to_raw( raw_type ptr )
+			{
+				return ptr;
+			}
+
+			template<class SmartPtrT>
+			static raw_type to_raw( const SmartPtrT& ptr )
+			{
+				return !ptr ? raw_type() : &*ptr;
+			}
+		};
+
+		template<class Iterator>
+		inline typename iterator_unwrapper<Iterator>::raw_type unwrap_iter( const Iterator& it )
+		{
+			return iterator_unwrapper<Iterator>::unwrap( it );
+		}
+
+		template<class Iterator>
+		inline Iterator rewrap_iter( const Iterator& orig,
+			const typename iterator_unwrapper<Iterator>::raw_type& raw_orig,
+			const typename iterator_unwrapper<Iterator>::raw_type& raw )
+		{
+			return iterator_unwrapper<Iterator>::rewrap( orig, raw_orig, raw );
+		}
+	}
+}
+
+#endif //GSTL_ITERATOR_UNWRAP_HEADER
@@ -34,6 +34,8 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 #include <gstl/detail/container_helpers.hpp>
 #include <gstl/detail/list_iterator.hpp>
 #include <gstl/detail/fill_iterator.hpp>
+#include <gstl/detail/construct_args.hpp>
+#include <boost/move/move.hpp>
 
 namespace gstl
 {
@@ -112,7 +114,18 @@ namespace gstl
 		list( const self_type& x )
 			:base_type( x.get_allocator() )
 		{
-			*this = x;
+			assign( x.begin(), x.end() );
+		}
+
+		/**
+		   @brief Move constructor, takes ownership of the x nodes
+		   @details x is left empty, no items are copied or moved
+		*/
+		list( BOOST_RV_REF( self_type ) x )
+			:base_type( x.get_allocator() )
+		{
+			self_type& src = x;
+			base_type::swap( src );
 		}
 
 		~list()
@@ -120,12 +133,23 @@ namespace gstl
 			clear();			
 		}
 
-		self_type& operator=(const self_type& x)
+		self_type& operator=( BOOST_COPY_ASSIGN_REF( self_type ) x )
 		{
 			assign( x.begin(), x.end() );
 			return *this;
 		}
 
+		self_type& operator=( BOOST_RV_REF( self_type ) x )
+		{
+			self_type& src = x;
+			if( this != &src )
+			{
+				clear();
+				base_type::swap( src );
+			}
+			return *this;
+		}
+
 		template <class InputIterator>
 		void assign( InputIterator first, InputIterator last )
 		{
@@ -233,7 +257,12 @@ namespace gstl
 		// 23.2.2.3 modifiers:
 		void push_front( const value_type& x )
 		{
-			detail::container::push_front( this, x );
+			_emplace_node( begin(), detail::make_construct_args( x ) );
+		}
+
+		void push_front( BOOST_RV_REF( value_type ) x )
+		{
+			_emplace_node( begin(), detail::make_construct_args( ::boost::move( x ) ) );
 		}
 
 		void pop_front()
@@ -243,9 +272,36 @@ namespace gstl
 
 		void push_back( const value_type& x )
 		{
-			detail::container::push_back( this, x );
+			_emplace_node( end(), detail::make_construct_args( x ) );
 		}
 
+		void push_back( BOOST_RV_REF( value_type ) x )
+		{
+			_emplace_node( end(), detail::make_construct_args( ::boost::move( x ) ) );
+		}
+
+		//emplace_front( args... ), emplace_back( args... ), emplace( position, args... )
+#define BOOST_PP_LOCAL_MACRO( n )\
+		GSTL_PP_TEMPLATE_HEAD( n )\
+		void emplace_front( GSTL_PP_FWD_PARAMS( n ) )\
+		{\
+			_emplace_node( begin(), GSTL_PP_CONSTRUCT_ARGS( n ) );\
+		}\
+		\
+		GSTL_PP_TEMPLATE_HEAD( n )\
+		void emplace_back( GSTL_PP_FWD_PARAMS( n ) )\
+		{\
+			_emplace_node( end(), GSTL_PP_CONSTRUCT_ARGS( n ) );\
+		}\
+		\
+		GSTL_PP_TEMPLATE_HEAD( n )\
+		iterator emplace( iterator position BOOST_PP_COMMA_IF( n ) GSTL_PP_FWD_PARAMS( n ) )\
+		{\
+			return _emplace_node( position, GSTL_PP_CONSTRUCT_ARGS( n ) );\
+		}
+#define BOOST_PP_LOCAL_LIMITS ( 0, GSTL_MAX_CONSTRUCT_ARGS )
+#include BOOST_PP_LOCAL_ITERATE()
+
 		void pop_back()
 		{
 			detail::container::pop_back( this );
@@ -255,7 +311,12 @@ namespace gstl
 		//Insert methods
 		iterator insert( iterator position, const value_type& x )
 		{
-			return _do_insert( position, &x, &x + 1, random_access_iterator_tag() );
+			return _emplace_node( position, detail::make_construct_args( x ) );
+		}
+
+		iterator insert( iterator position, BOOST_RV_REF( value_type ) x )
+		{
+			return _emplace_node( position, detail::make_construct_args( ::boost::move( x ) ) );
 		}
 
 		void insert( iterator position, size_type n, const value_type& x )
@@ -371,6 +432,20 @@ namespace gstl
 // 			}
 		}
 	private:
+		BOOST_COPYABLE_AND_MOVABLE( list )
+
+		template<class ConstructArgs>
+		iterator _emplace_node( iterator position, const ConstructArgs& args )
+		{
+			node_pointer curr = position.base();
+			node_pointer new_node = this->_create_node( curr, this->_prev( curr ), args );
+
+			this->_link_nodes( this->_prev( curr ), new_node );
+			this->_link_nodes( new_node, curr );
+			++size_;
+
+			return iter_helper::build_iter( new_node, this );
+		}
 
 		template <class InputIterator>
 		void _do_insert( iterator position,
@@ -404,7 +479,8 @@ namespace gstl
 			while( first != last )
 			{
 				node_ptr_reference prev = _prev( curr );
-				node_pointer new_node = _create_node( curr, prev, *first );
+				node_pointer new_node = _create_node( curr, prev,
+					detail::make_construct_args( *first ) );
 
 				//curr->prev_ = new_node
 				prev = new_node;
@@ -30,6 +30,7 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 
 #include <gstl/algorithm>
 #include <gstl/detail/list_node.hpp>
+#include <gstl/detail/construct_args.hpp>
 
 namespace gstl
 {
@@ -150,15 +151,16 @@ namespace gstl
 			  
 			   @param	next	pointer that will be set as next_ in new node
 			   @param	prev	pointer that will be set as prev_ in new node
-			   @param	val	(parameter description)
+			   @param	args	constructor arguments of the value, see detail::make_construct_args
 			   @exception	newer throws by itself, but if exception is 
 							thrown by allocator::allocate method or copy constructor of 
 							node_pointer or value, this exception will be passed out of function
 			  
 			   @return pointer to the new node
 			*/
+			template<class ConstructArgs>
 			node_pointer _create_node(node_pointer next,
-				node_pointer prev, const_reference val )
+				node_pointer prev, const ConstructArgs& args )
 			{
 				node_pointer node = node_alloc_.allocate( 1 );
 				bool next_linked = false;
@@ -172,7 +174,7 @@ namespace gstl
 					node_ptr_alloc_.construct( &_prev( node ), prev );
 					prev_linked = true;
 
-					alloc_.construct( &_value( node ), val );
+					args.construct( &_value( node ) );
 				}
 				catch(...)
 				{
@@ -0,0 +1,418 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_MMAP_ALLOCATOR_HEADER
+#define GSTL_MMAP_ALLOCATOR_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <gstl/detail/growth_policy.hpp>
+#include <gstl/detail/helpers.hpp>
+#include <new>
+
+#if defined(_WIN32)
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
+/**
+   @brief Default size of the block in bytes, starting from which mmap_allocator maps memory,
+	smaller blocks are allocated by operator new
+*/
+#ifndef GSTL_MMAP_THRESHOLD
+#	define GSTL_MMAP_THRESHOLD ( 1024 * 1024 )
+#endif
+
+namespace gstl
+{
+	/**
+	   @brief Flags of mmap_allocator
+	*/
+	enum mmap_flags
+	{
+		mmap_default	= 0,
+		mmap_populate	= 1,	///< Prefault the pages on allocation and growth (MAP_POPULATE)
+		mmap_huge_pages	= 2		///< Ask for transparent huge pages (MADV_HUGEPAGE), blocks are rounded to GSTL_HUGE_PAGE_SIZE
+	};
+
+	namespace detail
+	{
+		/**
+		   @brief Platform specific mapping of anonymous memory
+		   @details Remapping is available on Linux only, other platforms return failure,
+			so the containers fall back to allocate and copy.
+		*/
+		struct mmap_memory
+		{
+			static size_t page_size()
+			{
+				static const size_t size = query_page_size();
+				return size;
+			}
+
+			//Returns null pointer on failure
+			static void* map( size_t bytes, unsigned flags )
+			{
+#if defined(_WIN32)
+				void* ptr = ::VirtualAlloc( 0, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE );
+				if( ptr && ( flags & mmap_populate ) )
+				{
+					populate( ptr, bytes );
+				}
+				return ptr;
+#else
+				int map_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#	if defined(MAP_POPULATE)
+				if( flags & mmap_populate )
+				{
+					map_flags |= MAP_POPULATE;
+				}
+#	endif
+				void* ptr = ::mmap( 0, bytes, PROT_READ | PROT_WRITE, map_flags, -1, 0 );
+				if( ptr == MAP_FAILED )
+				{
+					return 0;
+				}
+				advise( ptr, bytes, flags );
+#	if !defined(MAP_POPULATE)
+				if( flags & mmap_populate )
+				{
+					populate( ptr, bytes );
+				}
+#	endif
+				return ptr;
+#endif
+			}
+
+			static void unmap( void* ptr, size_t bytes )
+			{
+#if defined(_WIN32)
+				gstl::helpers::unused_variable( bytes );
+				::VirtualFree( ptr, 0, MEM_RELEASE );
+#else
+				::munmap( ptr, bytes );
+#endif
+			}
+
+			//Grows the mapping in place
+			static bool expand( void* ptr, size_t old_bytes, size_t new_bytes, unsigned flags )
+			{
+#if defined(MREMAP_MAYMOVE)
+				if( ::mremap( ptr, old_bytes, new_bytes, 0 ) == MAP_FAILED )
+				{
+					return false;
+				}
+				grown( ptr, old_bytes, new_bytes, flags );
+				return true;
+#else
+				gstl::helpers::unused_variable( ptr );
+				gstl::helpers::unused_variable( old_bytes );
+				gstl::helpers::unused_variable( new_bytes );
+				gstl::helpers::unused_variable( flags );
+				return false;
+#endif
+			}
+
+			//Moves the pages into the new mapping, returns null pointer on failure
+			static void* remap( void* ptr, size_t old_bytes, size_t new_bytes, unsigned flags )
+			{
+#if defined(MREMAP_MAYMOVE)
+				void* new_ptr = ::mremap( ptr, old_bytes, new_bytes, MREMAP_MAYMOVE );
+				if( new_ptr == MAP_FAILED )
+				{
+					return 0;
+				}
+				grown( new_ptr, old_bytes, new_bytes, flags );
+				return new_ptr;
+#else
+				gstl::helpers::unused_variable( ptr );
+				gstl::helpers::unused_variable( old_bytes );
+				gstl::helpers::unused_variable( new_bytes );
+				gstl::helpers::unused_variable( flags );
+				return 0;
+#endif
+			}
+
+		private:
+			static size_t query_page_size()
+			{
+#if defined(_WIN32)
+				SYSTEM_INFO info;
+				::GetSystemInfo( &info );
+				return info.dwPageSize;
+#else
+				long size = ::sysconf( _SC_PAGESIZE );
+				return size > 0 ? static_cast<size_t>( size ) : GSTL_PAGE_SIZE;
+#endif
+			}
+
+			static void advise( void* ptr, size_t bytes, unsigned flags )
+			{
+#if defined(MADV_HUGEPAGE)
+				if( ( flags & mmap_huge_pages ) && bytes >= GSTL_HUGE_PAGE_SIZE )
+				{
+					::madvise( ptr, bytes, MADV_HUGEPAGE );
+				}
+#else
+				gstl::helpers::unused_variable( ptr );
+				gstl::helpers::unused_variable( bytes );
+				gstl::helpers::unused_variable( flags );
+#endif
+			}
+
+			//Touches every page, anonymous pages are zero filled anyway
+			static void populate( void* ptr, size_t bytes )
+			{
+				volatile char* begin = static_cast<volatile char*>( ptr );
+				for( size_t offset = 0; offset < bytes; offset += page_size() )
+				{
+					begin[offset] = 0;
+				}
+			}
+
+			//mremap doesn't prefault the new pages and resets nothing but the size
+			static void grown( void* ptr, size_t old_bytes, size_t new_bytes, unsigned flags )
+			{
+				advise( ptr, new_bytes, flags );
+				if( flags & mmap_populate )
+				{
+					populate( static_cast<char*>( ptr ) + old_bytes, new_bytes - old_bytes );
+				}
+			}
+		};
+	}
+
+	/**
+	   @brief Allocator, which maps anonymous memory for the large blocks
+	   @details Blocks of threshold bytes and larger are mapped directly from the OS
+		and rounded to the page size, smaller blocks are allocated by operator new.
+		Implements allocate_at_least, try_expand and reallocate (see allocator_expansion),
+		so dynamic buffers use the whole mapped pages and grow by mremap
+		instead of copying where it is possible.
+		Block kind is derived from its size, so deallocate must get the size
+		passed to allocate (or returned by allocate_at_least).
+	*/
+	template< class T >
+	class mmap_allocator
+	{
+	public:
+		typedef T									value_type;
+
+		typedef mmap_allocator< value_type >		self_type;
+
+		typedef value_type*			pointer;
+		typedef const value_type* 	const_pointer;
+		typedef value_type&			reference;
+		typedef const value_type&	const_reference;
+		
+		typedef size_t								size_type;
+		typedef ptrdiff_t							difference_type;
+
+		template<class Other>
+		struct rebind
+		{
+			typedef mmap_allocator< Other > other;
+		};
+
+		explicit mmap_allocator( unsigned flags = mmap_default,
+			size_type threshold = GSTL_MMAP_THRESHOLD )
+			:flags_( flags ),
+			threshold_( threshold )
+		{
+		}
+
+		template<class Other>
+		mmap_allocator( const mmap_allocator<Other>& rhs )
+			:flags_( rhs.flags() ),
+			threshold_( rhs.threshold() )
+		{
+		}
+
+		pointer address( reference val ) const
+		{	
+			return pointer(&val);
+		}
+
+		const_pointer address( const_reference val ) const
+		{	
+			return const_pointer(&val);
+		}
+
+		pointer allocate( size_type count, const void* /*hint*/ = 0 )
+		{
+			if( count > max_size() )
+			{
+				throw std::bad_alloc();
+			}
+			size_type bytes = count * sizeof( value_type );
+			if( !_is_mapped( bytes ) )
+			{
+				return static_cast<pointer>( ::operator new( bytes ) );
+			}
+			void* ptr = detail::mmap_memory::map( _mapping_size( bytes ), flags_ );
+			if( !ptr )
+			{
+				throw std::bad_alloc();
+			}
+			return static_cast<pointer>( ptr );
+		}
+
+		/**
+		   @brief Allocates block of at least count items, mapped blocks are rounded to the page size
+		*/
+		pointer allocate_at_least( size_type count, size_type& allocated )
+		{
+			pointer ptr = allocate( count );
+			allocated = _mapped_capacity( count );
+			return ptr;
+		}
+
+		void deallocate( pointer ptr, size_type count )
+		{
+			if( !ptr )
+			{
+				return;
+			}
+			size_type bytes = count * sizeof( value_type );
+			if( _is_mapped( bytes ) )
+			{
+				detail::mmap_memory::unmap( ptr, _mapping_size( bytes ) );
+			}
+			else
+			{
+				::operator delete( ptr );
+			}
+		}
+
+		/**
+		   @brief Grows the mapped block in place, blocks allocated by operator new are never expanded
+		*/
+		bool try_expand( pointer ptr, size_type old_count, size_type new_count )
+		{
+			size_type old_bytes = old_count * sizeof( value_type );
+			if( !ptr || !_is_mapped( old_bytes ) || new_count > max_size() )
+			{
+				return false;
+			}
+			size_type old_mapping = _mapping_size( old_bytes );
+			size_type new_mapping = _mapping_size( new_count * sizeof( value_type ) );
+			return new_mapping == old_mapping
+				|| detail::mmap_memory::expand( ptr, old_mapping, new_mapping, flags_ );
+		}
+
+		/**
+		   @brief Moves the pages of the mapped block into the larger mapping
+		   @return null pointer if the block isn't mapped or can't be remapped
+		*/
+		pointer reallocate( pointer ptr, size_type old_count, size_type new_count )
+		{
+			size_type old_bytes = old_count * sizeof( value_type );
+			size_type new_bytes = new_count * sizeof( value_type );
+			if( !ptr || !_is_mapped( old_bytes ) || new_count > max_size() || !_is_mapped( new_bytes ) )
+			{
+				return pointer();
+			}
+			return static_cast<pointer>( detail::mmap_memory::remap( ptr,
+				_mapping_size( old_bytes ), _mapping_size( new_bytes ), flags_ ) );
+		}
+
+		void construct( pointer ptr, const_reference val )
+		{	
+			::new (ptr) value_type(val);
+		}
+
+		void destroy( pointer ptr )
+		{	
+			ptr;//VS 2008 warning
+			ptr->~value_type();
+		}
+
+		size_type max_size() const 
+		{	
+			//Leaves room for rounding to the huge page size
+			size_type count = ( ~size_type(0) - GSTL_HUGE_PAGE_SIZE ) / sizeof(value_type);
+			return (0 < count ? count : 1);
+		}
+
+		unsigned flags() const
+		{
+			return flags_;
+		}
+
+		size_type threshold() const
+		{
+			return threshold_;
+		}
+
+	private:
+		bool _is_mapped( size_type bytes ) const
+		{
+			return bytes && bytes >= threshold_;
+		}
+
+		size_type _mapping_size( size_type bytes ) const
+		{
+			size_type granularity = ( flags_ & mmap_huge_pages ) && bytes >= GSTL_HUGE_PAGE_SIZE
+				? GSTL_HUGE_PAGE_SIZE : detail::mmap_memory::page_size();
+			return ( bytes + granularity - 1 ) / granularity * granularity;
+		}
+
+		//Number of items, which fit the block allocated for count items
+		size_type _mapped_capacity( size_type count ) const
+		{
+			size_type bytes = count * sizeof( value_type );
+			if( !_is_mapped( bytes ) )
+			{
+				return count;
+			}
+			size_type mapping = _mapping_size( bytes );
+			size_type capacity = mapping / sizeof( value_type );
+			//deallocate must get the same mapping size back
+			return _mapping_size( capacity * sizeof( value_type ) ) == mapping ? capacity : count;
+		}
+
+		unsigned	flags_;
+		size_type	threshold_;
+	};
+
+	template<class T, class U>
+	inline bool operator==( const mmap_allocator<T>& lhs, const mmap_allocator<U>& rhs )
+	{
+		//Blocks are unmapped by their mapping size, which depends on the threshold
+		//and on the huge page rounding, mmap_populate does not change it
+		return lhs.threshold() == rhs.threshold()
+			&& ( lhs.flags() & mmap_huge_pages ) == ( rhs.flags() & mmap_huge_pages );
+	}
+
+	template<class T, class U>
+	inline bool operator!=( const mmap_allocator<T>& lhs, const mmap_allocator<U>& rhs )
+	{
+		return !( lhs == rhs );
+	}
+}
+
+#endif //GSTL_MMAP_ALLOCATOR_HEADER
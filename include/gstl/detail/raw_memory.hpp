@@ -29,6 +29,9 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 #endif
 
 #include <gstl/detail/utility.hpp>
+#include <gstl/detail/construct_args.hpp>
+#include <new>
+#include <limits>
 
 namespace gstl
 {
@@ -43,7 +46,8 @@ namespace gstl
 			{
 				for (; first != last; ++result, ++first)
 				{
-					alloc.construct( &*result, *first );
+					//Forwards the result of dereference, so move iterators move items
+					detail::construct( &*result, *first );
 				}
 			}
 			catch( ... )
@@ -71,11 +75,29 @@ namespace gstl
 	};
 
 	// 20.4.3, temporary buffers:
+	/**
+	   @brief Allocates uninitialized storage for up to n objects of type T
+	   @details Never throws: if the memory is tight the request is halved until
+		the allocation succeeds, so the returned buffer may be smaller than requested.
+	   @return Pointer to the storage and its size in elements, (0, 0) if nothing was allocated
+	*/
 	template <class T>
 	pair<T*,ptrdiff_t> get_temporary_buffer( ptrdiff_t n )
 	{
-		return make_pair( static_cast<T*>(
-			::operator new( sizeof( T ) * n ) ), n );
+		const ptrdiff_t max_count = ( std::numeric_limits<ptrdiff_t>::max )() / sizeof( T );
+		if( n > max_count )
+		{
+			n = max_count;
+		}
+		for( ; n > 0; n /= 2 )
+		{
+			T* p = static_cast<T*>( ::operator new( sizeof( T ) * n, std::nothrow ) );
+			if( p )
+			{
+				return gstl::make_pair( p, n );
+			}
+		}
+		return gstl::make_pair( static_cast<T*>( 0 ), ptrdiff_t( 0 ) );
 	}
 
 	template <class T>
@@ -0,0 +1,681 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_SEGMENTED_VECTOR_HEADER
+#define GSTL_SEGMENTED_VECTOR_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <gstl/allocator>
+#include <gstl/algorithm>
+#include <gstl/iterator>
+#include <gstl/utility>
+#include <gstl/detail/assert.hpp>
+#include <gstl/detail/construct_args.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/integer/static_log2.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/move/move.hpp>
+#include <climits>
+#include <stdexcept>
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1400)
+#	include <intrin.h>
+#endif
+
+namespace gstl
+{
+	namespace detail
+	{
+		/**
+		   @brief Returns index of the highest set bit, x must not be zero
+		*/
+		inline size_t highest_bit( size_t x )
+		{
+			GSTL_ASSERT( x != 0 && "x is zero" );
+#if defined(_MSC_VER) && (_MSC_VER >= 1400)
+			unsigned long index;
+#	if defined(_WIN64)
+			_BitScanReverse64( &index, x );
+#	else
+			_BitScanReverse( &index, x );
+#	endif
+			return index;
+#elif defined(__GNUC__)
+			return sizeof( unsigned long long ) * CHAR_BIT - 1
+				- __builtin_clzll( static_cast<unsigned long long>( x ) );
+#else
+			size_t index = 0;
+			while( x >>= 1 )
+			{
+				++index;
+			}
+			return index;
+#endif
+		}
+
+		/**
+		   @brief Random access iterator of segmented_vector
+		   @details Stores the container and the item index, so it stays
+			valid while the item exists, no matter how many items are appended.
+		*/
+		template<class ContainerT, class Value>
+		class segmented_iterator
+			:public boost::iterator_facade<
+				segmented_iterator<ContainerT, Value>,	// Derived
+				Value,									// Value
+				boost::random_access_traversal_tag		// CategoryOrTraversal
+			>
+		{
+			struct enabler {};  // a private type avoids misuse
+
+		public:
+			typedef segmented_iterator						self_type;
+			typedef boost::iterator_facade<segmented_iterator, Value,
+				boost::random_access_traversal_tag>			base_type;
+			typedef ContainerT								container_type;
+			typedef typename container_type::size_type		size_type;
+			typedef typename base_type::difference_type		difference_type;
+
+			segmented_iterator()
+				:container_( 0 ),
+				index_( 0 )
+			{}
+
+			segmented_iterator( container_type* container, size_type index )
+				:container_( container ),
+				index_( index )
+			{}
+
+			template<class OtherContainerT, class OtherValue>
+			segmented_iterator( segmented_iterator<OtherContainerT, OtherValue> const& other,
+				typename boost::enable_if< boost::is_convertible<OtherValue*, Value*>,
+				enabler >::type = enabler() )
+				:container_( other.container_ ),
+				index_( other.index_ )
+			{}
+
+			size_type index() const
+			{
+				return index_;
+			}
+
+		private:
+			friend class boost::iterator_core_access;
+			template<class, class> friend class segmented_iterator;
+
+			Value& dereference() const
+			{
+				GSTL_ASSERT( !! container_ );
+				return (*container_)[ index_ ];
+			}
+
+			template<class OtherContainerT, class OtherValue>
+			bool equal( segmented_iterator<OtherContainerT, OtherValue> const& other ) const
+			{
+				GSTL_ASSERT( container_ == other.container_ );
+				return index_ == other.index_;
+			}
+
+			void increment()
+			{
+				++index_;
+			}
+
+			void decrement()
+			{
+				--index_;
+			}
+
+			void advance( difference_type n )
+			{
+				index_ += n;
+			}
+
+			template<class OtherContainerT, class OtherValue>
+			difference_type distance_to( segmented_iterator<OtherContainerT, OtherValue> const& other ) const
+			{
+				GSTL_ASSERT( container_ == other.container_ );
+				return static_cast<difference_type>( other.index_ )
+					- static_cast<difference_type>( index_ );
+			}
+
+			container_type* container_;
+			size_type index_;
+		};
+	}
+
+	/**
+	   @brief Vector, which never moves its items
+	   @details Items are stored in blocks, the first block holds FirstBlockSize
+		items and every next block is twice as large as the previous one.
+		Appending allocates a new block when the last one is full, existing
+		items are not copied, so references and iterators stay valid and the
+		peak memory doesn't double on growth. Item index is mapped to the block
+		by the highest bit of ( index / FirstBlockSize + 1 ), so operator[] is O(1).
+		Items can be added and removed at the end only.
+	*/
+	template
+		<
+			class T,
+			class Alloc = allocator<T>,
+			size_t FirstBlockSize = 16
+		>
+	class segmented_vector
+	{
+		BOOST_STATIC_ASSERT( FirstBlockSize > 0 && ( FirstBlockSize & ( FirstBlockSize - 1 ) ) == 0 );
+	public:
+		typedef segmented_vector									self_type;
+
+		// types:
+		typedef typename Alloc::template rebind<T>::other			allocator_type;
+		typedef T													value_type;
+		typedef typename allocator_type::pointer					pointer;
+		typedef typename allocator_type::const_pointer				const_pointer;
+		typedef typename allocator_type::reference					reference;
+		typedef typename allocator_type::const_reference			const_reference;
+		typedef typename allocator_type::size_type					size_type;
+		typedef typename allocator_type::difference_type			difference_type;
+
+		typedef detail::segmented_iterator<self_type, value_type>				iterator;
+		typedef detail::segmented_iterator<const self_type, const value_type>	const_iterator;
+
+		typedef gstl::reverse_iterator<iterator>			reverse_iterator;
+		typedef gstl::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+		enum
+		{
+			first_block_size = FirstBlockSize,
+			first_block_bits = boost::static_log2<FirstBlockSize>::value,
+			//Capacity of all blocks must fit size_type
+			max_blocks = sizeof( size_type ) * CHAR_BIT - first_block_bits - 1
+		};
+
+		// construct/copy/destroy:
+		explicit segmented_vector( const allocator_type& a = allocator_type() )
+			:alloc_( a )
+		{
+			_init();
+		}
+
+		explicit segmented_vector( size_type n, const T& value = T(),
+			const allocator_type& a = allocator_type() )
+			:alloc_( a )
+		{
+			_init();
+			_guarded_append( n, value );
+		}
+
+		template <class InputIterator>
+		segmented_vector( InputIterator first, InputIterator last,
+			const allocator_type& a = allocator_type() )
+			:alloc_( a )
+		{
+			_init();
+			_guarded_append( first, last );
+		}
+
+		segmented_vector( const self_type& x )
+			:alloc_( x.alloc_ )
+		{
+			_init();
+			_guarded_append( x.begin(), x.end() );
+		}
+
+		/**
+		   @brief Move constructor, takes ownership of the x blocks
+		   @details x is left empty, no items are copied or moved
+		*/
+		segmented_vector( BOOST_RV_REF( self_type ) x )
+			:alloc_( x.alloc_ )
+		{
+			_init();
+			self_type& src = x;
+			swap( src );
+		}
+
+		~segmented_vector()
+		{
+			_free();
+		}
+
+		self_type& operator=( BOOST_COPY_ASSIGN_REF( self_type ) x )
+		{
+			if( this != &x )
+			{
+				assign( x.begin(), x.end() );
+			}
+			return *this;
+		}
+
+		self_type& operator=( BOOST_RV_REF( self_type ) x )
+		{
+			self_type& src = x;
+			if( this != &src )
+			{
+				clear();
+				swap( src );
+			}
+			return *this;
+		}
+
+		template <class InputIterator>
+		void assign( InputIterator first, InputIterator last )
+		{
+			clear();
+			_append( first, last, boost::mpl::bool_< boost::is_integral<InputIterator>::value >() );
+		}
+
+		void assign( size_type n, const T& t )
+		{
+			clear();
+			_append_n( n, t );
+		}
+
+		allocator_type get_allocator() const
+		{
+			return alloc_;
+		}
+
+		// iterators:
+		iterator begin()
+		{
+			return iterator( this, 0 );
+		}
+
+		const_iterator begin() const
+		{
+			return const_iterator( this, 0 );
+		}
+
+		iterator end()
+		{
+			return iterator( this, size_ );
+		}
+
+		const_iterator end() const
+		{
+			return const_iterator( this, size_ );
+		}
+
+		reverse_iterator rbegin()
+		{
+			return reverse_iterator( end() );
+		}
+
+		const_reverse_iterator rbegin() const
+		{
+			return const_reverse_iterator( end() );
+		}
+
+		reverse_iterator rend()
+		{
+			return reverse_iterator( begin() );
+		}
+
+		const_reverse_iterator rend() const
+		{
+			return const_reverse_iterator( begin() );
+		}
+
+		// capacity:
+		size_type size() const
+		{
+			return size_;
+		}
+
+		size_type max_size() const
+		{
+			size_type alloc_max = alloc_.max_size();
+			size_type blocks_max = _block_start( max_blocks );
+			return alloc_max < blocks_max ? alloc_max : blocks_max;
+		}
+
+		bool empty() const
+		{
+			return !size_;
+		}
+
+		size_type capacity() const
+		{
+			return _block_start( blocks_count_ );
+		}
+
+		/**
+		   @brief Allocates blocks to hold at least n items, items are not moved
+		   @exception std::length_error if n exceeds max_size()
+		*/
+		void reserve( size_type n )
+		{
+			if( n > max_size() )
+			{
+				throw std::length_error( "invalid length" );
+			}
+			while( capacity() < n )
+			{
+				blocks_[blocks_count_] = alloc_.allocate( _block_size( blocks_count_ ) );
+				++blocks_count_;
+			}
+		}
+
+		/**
+		   @brief Frees the blocks, which are not used by the items
+		*/
+		void shrink_to_fit()
+		{
+			while( blocks_count_ && _block_start( blocks_count_ - 1 ) >= size_ )
+			{
+				--blocks_count_;
+				alloc_.deallocate( blocks_[blocks_count_], _block_size( blocks_count_ ) );
+				blocks_[blocks_count_] = pointer();
+			}
+		}
+
+		void resize( size_type sz, const_reference c = value_type() )
+		{
+			while( sz < size_ )
+			{
+				pop_back();
+			}
+			//Items are never moved, so c can refer to an item of this vector
+			while( sz > size_ )
+			{
+				push_back( c );
+			}
+		}
+
+		// element access:
+		reference operator[]( size_type n )
+		{
+			GSTL_ASSERT( n < size_ && "invalid index" );
+			return *_item( n );
+		}
+
+		const_reference operator[]( size_type n ) const
+		{
+			GSTL_ASSERT( n < size_ && "invalid index" );
+			return *_item( n );
+		}
+
+		reference at( size_type n )
+		{
+			_check_index( n );
+			return *_item( n );
+		}
+
+		const_reference at( size_type n ) const
+		{
+			_check_index( n );
+			return *_item( n );
+		}
+
+		reference front()
+		{
+			return (*this)[0];
+		}
+
+		const_reference front() const
+		{
+			return (*this)[0];
+		}
+
+		reference back()
+		{
+			return (*this)[size_ - 1];
+		}
+
+		const_reference back() const
+		{
+			return (*this)[size_ - 1];
+		}
+
+		/**
+		   @brief Number of allocated blocks
+		*/
+		size_type block_count() const
+		{
+			return blocks_count_;
+		}
+
+		// modifiers:
+		void push_back( const value_type& x )
+		{
+			_emplace_back( detail::make_construct_args( x ) );
+		}
+
+		void push_back( BOOST_RV_REF( value_type ) x )
+		{
+			_emplace_back( detail::make_construct_args( ::boost::move( x ) ) );
+		}
+
+		//emplace_back( args... )
+#define BOOST_PP_LOCAL_MACRO( n )\
+		GSTL_PP_TEMPLATE_HEAD( n )\
+		void emplace_back( GSTL_PP_FWD_PARAMS( n ) )\
+		{\
+			_emplace_back( GSTL_PP_CONSTRUCT_ARGS( n ) );\
+		}
+#define BOOST_PP_LOCAL_LIMITS ( 0, GSTL_MAX_CONSTRUCT_ARGS )
+#include BOOST_PP_LOCAL_ITERATE()
+
+		void pop_back()
+		{
+			GSTL_ASSERT( size_ && "vector is empty" );
+			--size_;
+			alloc_.destroy( _item( size_ ) );
+		}
+
+		void swap( self_type& rhs )
+		{
+			if( this != &rhs )
+			{
+				gstl::swap( alloc_, rhs.alloc_ );
+				for( size_type i = 0; i < max_blocks; ++i )
+				{
+					gstl::swap( blocks_[i], rhs.blocks_[i] );
+				}
+				gstl::swap( blocks_count_, rhs.blocks_count_ );
+				gstl::swap( size_, rhs.size_ );
+			}
+		}
+
+		void clear()
+		{
+			while( size_ )
+			{
+				pop_back();
+			}
+		}
+
+	private:
+		BOOST_COPYABLE_AND_MOVABLE( segmented_vector )
+
+		//Index of the first item of the block
+		static size_type _block_start( size_type block )
+		{
+			return ( static_cast<size_type>( FirstBlockSize ) << block ) - FirstBlockSize;
+		}
+
+		static size_type _block_size( size_type block )
+		{
+			return static_cast<size_type>( FirstBlockSize ) << block;
+		}
+
+		pointer _item( size_type n ) const
+		{
+			size_type block = detail::highest_bit( ( n >> first_block_bits ) + 1 );
+			return blocks_[block] + ( n - _block_start( block ) );
+		}
+
+		void _check_index( size_type n ) const
+		{
+			if( n >= size_ )
+			{
+				throw std::out_of_range( "invalid position" );
+			}
+		}
+
+		template<class ConstructArgs>
+		void _emplace_back( const ConstructArgs& args )
+		{
+			if( size_ == capacity() )
+			{
+				reserve( size_ + 1 );
+			}
+			//Items are never moved, so args can refer to an item of this vector
+			args.construct( &*_item( size_ ) );
+			++size_;
+		}
+
+		void _append_n( size_type n, const value_type& x )
+		{
+			reserve( size_ + n );
+			for( ; n; --n )
+			{
+				push_back( x );
+			}
+		}
+
+		template<class Integer>
+		void _append( Integer n, Integer x, boost::mpl::true_ /*integral*/ )
+		{
+			_append_n( static_cast<size_type>( n ), static_cast<const value_type&>( x ) );
+		}
+
+		template<class InputIterator>
+		void _append( InputIterator first, InputIterator last, boost::mpl::false_ /*integral*/ )
+		{
+			for( ; first != last; ++first )
+			{
+				push_back( *first );
+			}
+		}
+
+		//Appends in constructor, frees the blocks if an item throws
+		template<class InputIterator>
+		void _guarded_append( InputIterator first, InputIterator last )
+		{
+			try
+			{
+				_append( first, last, boost::mpl::bool_< boost::is_integral<InputIterator>::value >() );
+			}
+			catch(...)
+			{
+				_free();
+				throw;
+			}
+		}
+
+		void _guarded_append( size_type n, const T& value )
+		{
+			try
+			{
+				_append_n( n, value );
+			}
+			catch(...)
+			{
+				_free();
+				throw;
+			}
+		}
+
+		void _init()
+		{
+			for( size_type i = 0; i < max_blocks; ++i )
+			{
+				blocks_[i] = pointer();
+			}
+			blocks_count_ = 0;
+			size_ = 0;
+		}
+
+		void _free()
+		{
+			clear();
+			shrink_to_fit();
+		}
+
+		allocator_type	alloc_;
+		pointer			blocks_[max_blocks];
+		size_type		blocks_count_;
+		size_type		size_;
+	};
+
+	template<class value_type, class allocator, size_t block_size>
+	bool operator==( const segmented_vector<value_type, allocator, block_size>& lhs,
+		const segmented_vector<value_type, allocator, block_size>& rhs )
+	{
+		return ( lhs.size() == rhs.size() ) && gstl::equal( lhs.begin(), lhs.end(), rhs.begin() );
+	}
+
+	template<class value_type, class allocator, size_t block_size>
+	bool operator< (const segmented_vector<value_type, allocator, block_size>& lhs,
+		const segmented_vector<value_type, allocator, block_size>& rhs )
+	{
+		return gstl::lexicographical_compare( lhs.begin(), lhs.end(),
+				rhs.begin(), rhs.end());
+	}
+
+	template<class value_type, class allocator, size_t block_size>
+	bool operator!=( const segmented_vector<value_type, allocator, block_size>& lhs,
+		const segmented_vector<value_type, allocator, block_size>& rhs )
+	{
+		return rel_ops::operator !=( lhs, rhs );
+	}
+
+	template<class value_type, class allocator, size_t block_size>
+	bool operator>( const segmented_vector<value_type, allocator, block_size>& lhs,
+		const segmented_vector<value_type, allocator, block_size>& rhs )
+	{
+		return rel_ops::operator >( lhs, rhs );
+	}
+
+	template<class value_type, class allocator, size_t block_size>
+	bool operator>=( const segmented_vector<value_type, allocator, block_size>& lhs,
+		const segmented_vector<value_type, allocator, block_size>& rhs )
+	{
+		return rel_ops::operator >=( lhs, rhs );
+	}
+
+	template<class value_type, class allocator, size_t block_size>
+	bool operator<=( const segmented_vector<value_type, allocator, block_size>& lhs,
+		const segmented_vector<value_type, allocator, block_size>& rhs )
+	{
+		return rel_ops::operator <=( lhs, rhs );
+	}
+
+	template<class value_type, class allocator, size_t block_size>
+	void swap( segmented_vector<value_type, allocator, block_size>& lhs,
+		segmented_vector<value_type, allocator, block_size>& rhs )
+	{
+		lhs.swap( rhs );
+	}
+}
+
+#endif //GSTL_SEGMENTED_VECTOR_HEADER
@@ -0,0 +1,346 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_SMALL_VECTOR_HEADER
+#define GSTL_SMALL_VECTOR_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <gstl/detail/vector.hpp>
+#include <gstl/detail/buffer_helpers.hpp>
+#include <gstl/detail/allocator_expansion.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/move/move.hpp>
+
+namespace gstl
+{
+	namespace detail
+	{
+		/**
+		   @brief Uninitialized storage for N items of type T
+		   @details Used as the first base of small_vector, so the storage
+			exists before the vector base is constructed
+		*/
+		template<class T, size_t N>
+		class inline_storage
+		{
+			BOOST_STATIC_ASSERT( N > 0 );
+		public:
+			T* inline_buffer()
+			{
+				return static_cast<T*>( storage_.address() );
+			}
+
+			const T* inline_buffer() const
+			{
+				return static_cast<const T*>( storage_.address() );
+			}
+
+		private:
+			boost::aligned_storage< sizeof( T ) * N, boost::alignment_of<T>::value > storage_;
+		};
+
+		/**
+		   @brief Allocator adapter, which never frees the inline buffer of small_vector
+		   @details All allocations are passed to the base allocator, 
+			deallocation of the inline buffer is ignored.
+		*/
+		template<class T, size_t N, class Alloc>
+		class inline_buffer_allocator
+		{
+		public:
+			typedef typename Alloc::template rebind<T>::other	base_allocator_type;
+			typedef inline_buffer_allocator						self_type;
+
+			typedef T											value_type;
+			typedef value_type*									pointer;
+			typedef const value_type*							const_pointer;
+			typedef value_type&									reference;
+			typedef const value_type&							const_reference;
+
+			typedef typename base_allocator_type::size_type			size_type;
+			typedef typename base_allocator_type::difference_type	difference_type;
+
+			typedef allocator_expansion<base_allocator_type>		base_expansion_type;
+
+			template<class Other>
+			struct rebind
+			{
+				typedef inline_buffer_allocator< Other, N,
+					typename Alloc::template rebind<Other>::other > other;
+			};
+
+			explicit inline_buffer_allocator( pointer inline_buffer = pointer(),
+				const base_allocator_type& alloc = base_allocator_type() )
+				:inline_buffer_( inline_buffer ),
+				alloc_( alloc )
+			{}
+
+			template<class Other, class OtherAlloc>
+			inline_buffer_allocator( const inline_buffer_allocator<Other, N, OtherAlloc>& rhs )
+				:inline_buffer_(),
+				alloc_( rhs.base_allocator() )
+			{}
+
+			pointer allocate( size_type count )
+			{
+				return &*alloc_.allocate( count );
+			}
+
+			void deallocate( pointer ptr, size_type count )
+			{
+				if( ptr != inline_buffer_ )
+				{
+					alloc_.deallocate( ptr, count );
+				}
+			}
+
+			pointer allocate_at_least( size_type count, size_type& allocated )
+			{
+				return &*base_expansion_type::allocate_at_least( alloc_, count, allocated );
+			}
+
+			/**
+			   @brief Expands heap blocks by the base allocator, the inline buffer can't be expanded
+			*/
+			bool try_expand( pointer ptr, size_type old_count, size_type new_count )
+			{
+				return ptr != inline_buffer_ 
+					&& base_expansion_type::try_expand( alloc_, ptr, old_count, new_count );
+			}
+
+			void construct( pointer ptr, const_reference val )
+			{
+				::new( static_cast<void*>( ptr ) ) value_type( val );
+			}
+
+			void destroy( pointer ptr )
+			{
+				ptr;//VS 2008 warning
+				ptr->~value_type();
+			}
+
+			size_type max_size() const
+			{
+				return alloc_.max_size();
+			}
+
+			pointer inline_buffer() const
+			{
+				return inline_buffer_;
+			}
+
+			const base_allocator_type& base_allocator() const
+			{
+				return alloc_;
+			}
+
+		private:
+			pointer				inline_buffer_;
+			base_allocator_type	alloc_;
+		};
+
+		template<class T, size_t N, class Alloc>
+		inline bool operator==( const inline_buffer_allocator<T, N, Alloc>& lhs,
+			const inline_buffer_allocator<T, N, Alloc>& rhs )
+		{
+			return lhs.inline_buffer() == rhs.inline_buffer()
+				&& lhs.base_allocator() == rhs.base_allocator();
+		}
+
+		template<class T, size_t N, class Alloc>
+		inline bool operator!=( const inline_buffer_allocator<T, N, Alloc>& lhs,
+			const inline_buffer_allocator<T, N, Alloc>& rhs )
+		{
+			return !( lhs == rhs );
+		}
+	}
+
+	/**
+	   @brief Vector, which stores up to N items inside the object
+	   @details Allocator is used only when the size grows past N,
+		so small vectors don't allocate memory at all.
+		The rest of the interface is inherited from gstl::vector.
+		Note that move and swap of the inline items move them one by one.
+	*/
+	template
+		<
+			class T,
+			size_t N,
+			class Alloc = allocator<T>,
+			class GrowthPolicy = default_growth_policy
+		>
+	class small_vector
+		:private detail::inline_storage<T, N>,
+		public vector<T, detail::inline_buffer_allocator<T, N, Alloc>, GrowthPolicy>
+	{
+		typedef detail::inline_storage<T, N>	storage_type;
+	public:
+		typedef vector<T, detail::inline_buffer_allocator<T, N, Alloc>,
+			GrowthPolicy>										base_type;
+		typedef small_vector									self_type;
+
+		typedef typename base_type::allocator_type				allocator_type;
+		typedef typename allocator_type::base_allocator_type	base_allocator_type;
+
+		typedef typename base_type::value_type		value_type;
+		typedef typename base_type::pointer			pointer;
+		typedef typename base_type::size_type		size_type;
+		typedef typename base_type::iterator		iterator;
+		typedef typename base_type::const_iterator	const_iterator;
+
+		enum{ inline_capacity = N };
+
+		explicit small_vector( const base_allocator_type& a = base_allocator_type() )
+			:base_type( allocator_type( storage_type::inline_buffer(), a ) )
+		{
+			_reset_to_inline();
+		}
+
+		explicit small_vector( size_type n, const T& value = T(),
+			const base_allocator_type& a = base_allocator_type() )
+			:base_type( allocator_type( storage_type::inline_buffer(), a ) )
+		{
+			_reset_to_inline();
+			this->insert( this->begin(), n, value );
+		}
+
+		template <class InputIterator>
+		small_vector( InputIterator first, InputIterator last,
+			const base_allocator_type& a = base_allocator_type() )
+			:base_type( allocator_type( storage_type::inline_buffer(), a ) )
+		{
+			_reset_to_inline();
+			this->insert( this->begin(), first, last );
+		}
+
+		small_vector( const self_type& x )
+			:base_type( allocator_type( storage_type::inline_buffer(),
+				x.get_allocator().base_allocator() ) )
+		{
+			_reset_to_inline();
+			this->assign( x.begin(), x.end() );
+		}
+
+		/**
+		   @brief Move constructor
+		   @details Takes ownership of the x heap buffer, 
+			inline items are moved one by one. x is left empty.
+		*/
+		small_vector( BOOST_RV_REF( self_type ) x )
+			:base_type( allocator_type( storage_type::inline_buffer(),
+				x.get_allocator().base_allocator() ) )
+		{
+			_reset_to_inline();
+			self_type& src = x;
+			_take_items( src );
+		}
+
+		self_type& operator=( BOOST_COPY_ASSIGN_REF( self_type ) x )
+		{
+			if( this != &x )
+			{
+				this->assign( x.begin(), x.end() );
+			}
+			return *this;
+		}
+
+		self_type& operator=( BOOST_RV_REF( self_type ) x )
+		{
+			self_type& src = x;
+			if( this != &src )
+			{
+				this->clear();
+				_take_items( src );
+			}
+			return *this;
+		}
+
+		void swap( self_type& rhs )
+		{
+			if( this != &rhs )
+			{
+				self_type tmp( ::boost::move( rhs ) );
+				rhs = ::boost::move( *this );
+				*this = ::boost::move( tmp );
+			}
+		}
+
+		/**
+		   @brief Checks whether the items are stored inside the object
+		*/
+		bool is_inline() const
+		{
+			return this->get_buffer() == storage_type::inline_buffer();
+		}
+
+	private:
+		BOOST_COPYABLE_AND_MOVABLE( small_vector )
+
+		//Sets up empty inline buffer, current buffer is not freed
+		void _reset_to_inline()
+		{
+			this->buffer_ = storage_type::inline_buffer();
+			this->size_ = 0;
+			this->reserved_ = N;
+		}
+
+		//Moves items of the src into this empty vector, src is left empty
+		void _take_items( self_type& src )
+		{
+			GSTL_ASSERT( this->empty() );
+			if( src.is_inline() )
+			{
+				//Inline capacity is never greater than the current one
+				if( src.size() )
+				{
+					detail::uninitialized_move( this->get_buffer(), src.get_buffer(), src.size() );
+				}
+				this->set_size( src.size() );
+				src.clear();
+			}
+			else
+			{
+				//Frees the current heap buffer, if any, then adopts the src block
+				//together with the base allocator, which will free it
+				this->reset_buffer( src.buffer_, src.size_, src.reserved_ );
+				this->alloc_ = allocator_type( storage_type::inline_buffer(),
+					src.get_allocator().base_allocator() );
+				src._reset_to_inline();
+			}
+		}
+	};
+
+	template<class T, size_t N, class Alloc, class GrowthPolicy>
+	void swap( small_vector<T, N, Alloc, GrowthPolicy>& lhs,
+		small_vector<T, N, Alloc, GrowthPolicy>& rhs )
+	{
+		lhs.swap( rhs );
+	}
+}
+
+#endif //GSTL_SMALL_VECTOR_HEADER
@@ -0,0 +1,1239 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_SORT_HEADER
+#define GSTL_SORT_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <stddef.h>
+#include <functional>
+#include <gstl/detail/iterator_unwrap.hpp>
+#include <gstl/detail/assert.hpp>
+#include <gstl/detail/allocator.hpp>
+#include <gstl/detail/raw_memory.hpp>
+
+#include <gstl/detail/boost_warnings_off.hpp>
+#include <boost/move/move.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/has_trivial_constructor.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <gstl/detail/boost_warnings_on.hpp>
+
+namespace gstl
+{
+	namespace detail
+	{
+		/**
+		   @brief Pattern-defeating quicksort, see O. Peters "Pattern-defeating Quicksort"
+		   @details Introsort with the median of 3 (ninther for the large ranges) pivot,
+			detection of the already partitioned ranges, shuffling of the bad partitions
+			and the heapsort fallback, which guarantees O(n log n).
+		*/
+		namespace sort_impl
+		{
+			enum
+			{
+				insertion_sort_threshold = 24,	/**< Ranges shorter than this are sorted by insertion sort */
+				ninther_threshold = 128,		/**< Ranges longer than this use the ninther pivot */
+				partial_insertion_sort_limit = 8,
+				block_size = 64,				/**< Elements per block of the branchless partition */
+				cacheline_size = 64
+			};
+
+			/**
+			   @brief Selects the branchless partition: arithmetic keys compared by std::less or std::greater
+			*/
+			template<class T, class Compare>
+			struct is_branchless
+				:public boost::mpl::false_
+			{};
+
+			template<class T>
+			struct is_branchless< T, std::less<T> >
+				:public boost::mpl::bool_< boost::is_arithmetic<T>::value >
+			{};
+
+			template<class T>
+			struct is_branchless< T, std::greater<T> >
+				:public boost::mpl::bool_< boost::is_arithmetic<T>::value >
+			{};
+
+			template<class Size>
+			inline int log2( Size n )
+			{
+				int log = 0;
+				while( n >>= 1 )
+				{
+					++log;
+				}
+				return log;
+			}
+
+			template<class RanIt, class Compare>
+			inline void insertion_sort( RanIt first, RanIt last, Compare comp )
+			{
+				typedef typename iterator_traits<RanIt>::value_type value_type;
+				if( first == last )
+				{
+					return;
+				}
+				for( RanIt cur = first + 1; cur != last; ++cur )
+				{
+					RanIt sift = cur;
+					RanIt sift_1 = cur - 1;
+					if( comp( *sift, *sift_1 ) )
+					{
+						value_type tmp( ::boost::move( *sift ) );
+						do
+						{
+							*sift-- = ::boost::move( *sift_1 );
+						}
+						while( sift != first && comp( tmp, *--sift_1 ) );
+						*sift = ::boost::move( tmp );
+					}
+				}
+			}
+
+			/**
+			   @brief Insertion sort, which relies on the element before first,
+				that is not greater than any element of the range
+			*/
+			template<class RanIt, class Compare>
+			inline void unguarded_insertion_sort( RanIt first, RanIt last, Compare comp )
+			{
+				typedef typename iterator_traits<RanIt>::value_type value_type;
+				if( first == last )
+				{
+					return;
+				}
+				for( RanIt cur = first + 1; cur != last; ++cur )
+				{
+					RanIt sift = cur;
+					RanIt sift_1 = cur - 1;
+					if( comp( *sift, *sift_1 ) )
+					{
+						value_type tmp( ::boost::move( *sift ) );
+						do
+						{
+							*sift-- = ::boost::move( *sift_1 );
+						}
+						while( comp( tmp, *--sift_1 ) );
+						*sift = ::boost::move( tmp );
+					}
+				}
+			}
+
+			/**
+			   @brief Tries to sort the nearly sorted range by insertion sort
+			   @return false if more than partial_insertion_sort_limit elements
+				were moved, the range is left unsorted then
+			*/
+			template<class RanIt, class Compare>
+			inline bool partial_insertion_sort( RanIt first, RanIt last, Compare comp )
+			{
+				typedef typename iterator_traits<RanIt>::value_type value_type;
+				if( first == last )
+				{
+					return true;
+				}
+				size_t limit = 0;
+				for( RanIt cur = first + 1; cur != last; ++cur )
+				{
+					if( limit > partial_insertion_sort_limit )
+					{
+						return false;
+					}
+					RanIt sift = cur;
+					RanIt sift_1 = cur - 1;
+					if( comp( *sift, *sift_1 ) )
+					{
+						value_type tmp( ::boost::move( *sift ) );
+						do
+						{
+							*sift-- = ::boost::move( *sift_1 );
+						}
+						while( sift != first && comp( tmp, *--sift_1 ) );
+						*sift = ::boost::move( tmp );
+						limit += cur - sift;
+					}
+				}
+				return true;
+			}
+
+			template<class RanIt, class Compare>
+			inline void sort2( RanIt a, RanIt b, Compare comp )
+			{
+				if( comp( *b, *a ) )
+				{
+					gstl::iter_swap( a, b );
+				}
+			}
+
+			template<class RanIt, class Compare>
+			inline void sort3( RanIt a, RanIt b, RanIt c, Compare comp )
+			{
+				sort2( a, b, comp );
+				sort2( b, c, comp );
+				sort2( a, b, comp );
+			}
+
+			template<class RanIt, class Compare>
+			inline void sift_down( RanIt first, ptrdiff_t size, ptrdiff_t root, Compare comp )
+			{
+				for( ;; )
+				{
+					ptrdiff_t child = 2 * root + 1;
+					if( child >= size )
+					{
+						return;
+					}
+					if( child + 1 < size && comp( first[child], first[child + 1] ) )
+					{
+						++child;
+					}
+					if( !comp( first[root], first[child] ) )
+					{
+						return;
+					}
+					gstl::iter_swap( first + root, first + child );
+					root = child;
+				}
+			}
+
+			template<class RanIt, class Compare>
+			inline void heap_sort( RanIt first, RanIt last, Compare comp )
+			{
+				const ptrdiff_t size = last - first;
+				for( ptrdiff_t i = size / 2; i-- > 0; )
+				{
+					sift_down( first, size, i, comp );
+				}
+				for( ptrdiff_t end = size - 1; end > 0; --end )
+				{
+					gstl::iter_swap( first, first + end );
+					sift_down( first, end, 0, comp );
+				}
+			}
+
+			template<class RanIt>
+			struct partition_result
+			{
+				RanIt pivot;
+				bool already_partitioned;
+			};
+
+			/**
+			   @brief Partitions [first, last) around the pivot *first, the elements equal
+				to the pivot go to the right part
+			*/
+			template<class RanIt, class Compare>
+			inline partition_result<RanIt> partition_right( RanIt first, RanIt last, Compare comp,
+				boost::mpl::false_ /*branchless*/ )
+			{
+				typedef typename iterator_traits<RanIt>::value_type value_type;
+				value_type pivot( ::boost::move( *first ) );
+				RanIt l = first;
+				RanIt r = last;
+
+				//The median of 3 guarantees, that the loops stop inside the range
+				while( comp( *++l, pivot ) );
+				if( l - 1 == first )
+				{
+					while( l < r && !comp( *--r, pivot ) );
+				}
+				else
+				{
+					while( !comp( *--r, pivot ) );
+				}
+
+				const bool already_partitioned = l >= r;
+				while( l < r )
+				{
+					gstl::iter_swap( l, r );
+					while( comp( *++l, pivot ) );
+					while( !comp( *--r, pivot ) );
+				}
+
+				RanIt pivot_pos = l - 1;
+				*first = ::boost::move( *pivot_pos );
+				*pivot_pos = ::boost::move( pivot );
+				partition_result<RanIt> result = { pivot_pos, already_partitioned };
+				return result;
+			}
+
+			template<class RanIt>
+			inline void swap_offsets( RanIt first, RanIt last, const unsigned char* offsets_l,
+				const unsigned char* offsets_r, size_t num, bool use_swaps )
+			{
+				typedef typename iterator_traits<RanIt>::value_type value_type;
+				if( use_swaps )
+				{//Both sides have the same number of elements, the cyclic permutation may produce a wrong order
+					for( size_t i = 0; i < num; ++i )
+					{
+						gstl::iter_swap( first + offsets_l[i], last - offsets_r[i] );
+					}
+				}
+				else if( num > 0 )
+				{
+					RanIt l = first + offsets_l[0];
+					RanIt r = last - offsets_r[0];
+					value_type tmp( ::boost::move( *l ) );
+					*l = ::boost::move( *r );
+					for( size_t i = 1; i < num; ++i )
+					{
+						l = first + offsets_l[i];
+						*r = ::boost::move( *l );
+						r = last - offsets_r[i];
+						*l = ::boost::move( *r );
+					}
+					*r = ::boost::move( tmp );
+				}
+			}
+
+			inline unsigned char* align_cacheline( unsigned char* p )
+			{
+				const size_t misalignment = reinterpret_cast<size_t>( p ) % cacheline_size;
+				return misalignment == 0 ? p : p + ( cacheline_size - misalignment );
+			}
+
+			/**
+			   @brief Block partition of B. Edelkamp and A. Weiss "BlockQuicksort",
+				comparisons results are stored into the offset buffers without branches
+			*/
+			template<class RanIt, class Compare>
+			inline partition_result<RanIt> partition_right( RanIt first, RanIt last, Compare comp,
+				boost::mpl::true_ /*branchless*/ )
+			{
+				typedef typename iterator_traits<RanIt>::value_type value_type;
+				value_type pivot( ::boost::move( *first ) );
+				RanIt l = first;
+				RanIt r = last;
+
+				while( comp( *++l, pivot ) );
+				if( l - 1 == first )
+				{
+					while( l < r && !comp( *--r, pivot ) );
+				}
+				else
+				{
+					while( !comp( *--r, pivot ) );
+				}
+
+				const bool already_partitioned = l >= r;
+				if( !already_partitioned )
+				{
+					gstl::iter_swap( l, r );
+					++l;
+
+					unsigned char offsets_l_storage[block_size + cacheline_size];
+					unsigned char offsets_r_storage[block_size + cacheline_size];
+					unsigned char* offsets_l = align_cacheline( offsets_l_storage );
+					unsigned char* offsets_r = align_cacheline( offsets_r_storage );
+
+					RanIt offsets_l_base = l;
+					RanIt offsets_r_base = r;
+					size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+					while( l < r )
+					{
+						//Fills the empty offset buffers, the last blocks may be shorter
+						const size_t num_unknown = r - l;
+						const size_t left_split = num_l == 0 ? ( num_r == 0 ? num_unknown / 2 : num_unknown ) : 0;
+						const size_t right_split = num_r == 0 ? ( num_unknown - left_split ) : 0;
+
+						if( left_split >= block_size )
+						{
+							for( size_t i = 0; i < block_size; )
+							{
+								offsets_l[num_l] = static_cast<unsigned char>( i++ ); num_l += !comp( *l, pivot ); ++l;
+								offsets_l[num_l] = static_cast<unsigned char>( i++ ); num_l += !comp( *l, pivot ); ++l;
+								offsets_l[num_l] = static_cast<unsigned char>( i++ ); num_l += !comp( *l, pivot ); ++l;
+								offsets_l[num_l] = static_cast<unsigned char>( i++ ); num_l += !comp( *l, pivot ); ++l;
+							}
+						}
+						else
+						{
+							for( size_t i = 0; i < left_split; )
+							{
+								offsets_l[num_l] = static_cast<unsigned char>( i++ ); num_l += !comp( *l, pivot ); ++l;
+							}
+						}
+
+						if( right_split >= block_size )
+						{
+							for( size_t i = 0; i < block_size; )
+							{
+								offsets_r[num_r] = static_cast<unsigned char>( ++i ); num_r += comp( *--r, pivot );
+								offsets_r[num_r] = static_cast<unsigned char>( ++i ); num_r += comp( *--r, pivot );
+								offsets_r[num_r] = static_cast<unsigned char>( ++i ); num_r += comp( *--r, pivot );
+								offsets_r[num_r] = static_cast<unsigned char>( ++i ); num_r += comp( *--r, pivot );
+							}
+						}
+						else
+						{
+							for( size_t i = 0; i < right_split; )
+							{
+								offsets_r[num_r] = static_cast<unsigned char>( ++i ); num_r += comp( *--r, pivot );
+							}
+						}
+
+						//Swaps the misplaced elements found on both sides
+						const size_t num = num_l < num_r ? num_l : num_r;
+						swap_offsets( offsets_l_base, offsets_r_base,
+							offsets_l + start_l, offsets_r + start_r, num, num_l == num_r );
+						num_l -= num;
+						num_r -= num;
+						start_l += num;
+						start_r += num;
+						if( num_l == 0 )
+						{
+							start_l = 0;
+							offsets_l_base = l;
+						}
+						if( num_r == 0 )
+						{
+							start_r = 0;
+							offsets_r_base = r;
+						}
+					}
+
+					//Moves the rest of the misplaced elements to the middle
+					if( num_l != 0 )
+					{
+						offsets_l += start_l;
+						while( num_l-- )
+						{
+							gstl::iter_swap( offsets_l_base + offsets_l[num_l], --r );
+						}
+						l = r;
+					}
+					if( num_r != 0 )
+					{
+						offsets_r += start_r;
+						while( num_r-- )
+						{
+							gstl::iter_swap( offsets_r_base - offsets_r[num_r], l );
+							++l;
+						}
+						r = l;
+					}
+				}
+
+				RanIt pivot_pos = l - 1;
+				*first = ::boost::move( *pivot_pos );
+				*pivot_pos = ::boost::move( pivot );
+				partition_result<RanIt> result = { pivot_pos, already_partitioned };
+				return result;
+			}
+
+			/**
+			   @brief Partitions [first, last) around the pivot *first, the elements equal
+				to the pivot go to the left part
+			   @details Used when the pivot is equal to the element before the range,
+				all the elements equal to the pivot are placed once and for all
+			*/
+			template<class RanIt, class Compare>
+			inline RanIt partition_left( RanIt first, RanIt last, Compare comp )
+			{
+				typedef typename iterator_traits<RanIt>::value_type value_type;
+				value_type pivot( ::boost::move( *first ) );
+				RanIt l = first;
+				RanIt r = last;
+
+				while( comp( pivot, *--r ) );
+				if( r + 1 == last )
+				{
+					while( l < r && !comp( pivot, *++l ) );
+				}
+				else
+				{
+					while( !comp( pivot, *++l ) );
+				}
+
+				while( l < r )
+				{
+					gstl::iter_swap( l, r );
+					while( comp( pivot, *--r ) );
+					while( !comp( pivot, *++l ) );
+				}
+
+				RanIt pivot_pos = r;
+				*first = ::boost::move( *pivot_pos );
+				*pivot_pos = ::boost::move( pivot );
+				return pivot_pos;
+			}
+
+			template<class RanIt, class Compare, class Branchless>
+			void pdqsort_loop( RanIt first, RanIt last, Compare comp, int bad_allowed, bool leftmost,
+				Branchless branchless )
+			{
+				typedef typename iterator_traits<RanIt>::difference_type difference_type;
+
+				//The larger part is sorted in the loop, the smaller one by the recursion
+				for( ;; )
+				{
+					const difference_type size = last - first;
+					if( size < insertion_sort_threshold )
+					{
+						if( leftmost )
+						{
+							insertion_sort( first, last, comp );
+						}
+						else
+						{
+							unguarded_insertion_sort( first, last, comp );
+						}
+						return;
+					}
+
+					//The pivot is placed at first
+					const difference_type half = size / 2;
+					if( size > ninther_threshold )
+					{
+						sort3( first, first + half, last - 1, comp );
+						sort3( first + 1, first + ( half - 1 ), last - 2, comp );
+						sort3( first + 2, first + ( half + 1 ), last - 3, comp );
+						sort3( first + ( half - 1 ), first + half, first + ( half + 1 ), comp );
+						gstl::iter_swap( first, first + half );
+					}
+					else
+					{
+						sort3( first + half, first, last - 1, comp );
+					}
+
+					//The pivot is equal to the element before the range,
+					//the elements equal to the pivot need no further sorting
+					if( !leftmost && !comp( *( first - 1 ), *first ) )
+					{
+						first = partition_left( first, last, comp ) + 1;
+						continue;
+					}
+
+					const partition_result<RanIt> part = partition_right( first, last, comp, branchless );
+					const RanIt pivot_pos = part.pivot;
+
+					const difference_type l_size = pivot_pos - first;
+					const difference_type r_size = last - ( pivot_pos + 1 );
+					if( l_size < size / 8 || r_size < size / 8 )
+					{//Highly unbalanced partition
+						if( --bad_allowed == 0 )
+						{
+							heap_sort( first, last, comp );
+							return;
+						}
+
+						//Breaks the patterns, which could lead to the bad partitions
+						if( l_size >= insertion_sort_threshold )
+						{
+							gstl::iter_swap( first, first + l_size / 4 );
+							gstl::iter_swap( pivot_pos - 1, pivot_pos - l_size / 4 );
+							if( l_size > ninther_threshold )
+							{
+								gstl::iter_swap( first + 1, first + ( l_size / 4 + 1 ) );
+								gstl::iter_swap( first + 2, first + ( l_size / 4 + 2 ) );
+								gstl::iter_swap( pivot_pos - 2, pivot_pos - ( l_size / 4 + 1 ) );
+								gstl::iter_swap( pivot_pos - 3, pivot_pos - ( l_size / 4 + 2 ) );
+							}
+						}
+						if( r_size >= insertion_sort_threshold )
+						{
+							gstl::iter_swap( pivot_pos + 1, pivot_pos + ( 1 + r_size / 4 ) );
+							gstl::iter_swap( last - 1, last - r_size / 4 );
+							if( r_size > ninther_threshold )
+							{
+								gstl::iter_swap( pivot_pos + 2, pivot_pos + ( 2 + r_size / 4 ) );
+								gstl::iter_swap( pivot_pos + 3, pivot_pos + ( 3 + r_size / 4 ) );
+								gstl::iter_swap( last - 2, last - ( 1 + r_size / 4 ) );
+								gstl::iter_swap( last - 3, last - ( 2 + r_size / 4 ) );
+							}
+						}
+					}
+					else if( part.already_partitioned
+						&& partial_insertion_sort( first, pivot_pos, comp )
+						&& partial_insertion_sort( pivot_pos + 1, last, comp ) )
+					{//The range was already sorted or nearly sorted
+						return;
+					}
+
+					pdqsort_loop( first, pivot_pos, comp, bad_allowed, leftmost, branchless );
+					first = pivot_pos + 1;
+					leftmost = false;
+				}
+			}
+
+			template<class RanIt, class Compare>
+			inline void pdqsort( RanIt first, RanIt last, Compare comp )
+			{
+				typedef typename iterator_traits<RanIt>::value_type value_type;
+				if( last - first < 2 )
+				{
+					return;
+				}
+				pdqsort_loop( first, last, comp, log2( last - first ), true,
+					typename is_branchless<value_type, Compare>::type() );
+			}
+		}
+
+		/**
+		   @brief Adaptive stable merge sort
+		   @details Natural runs are detected and merged like in timsort (T. Peters, "listsort.txt"):
+			short runs are extended to minrun by insertion sort, runs are kept on the stack
+			with the lengths growing at least as fast as the Fibonacci numbers.
+			Merges go through a temporary buffer of the half range size, if the buffer
+			can't be allocated the runs are merged in place by the rotations, O(n log^2 n).
+		*/
+		namespace stable_sort_impl
+		{
+			enum
+			{
+				min_merge = 64,	/**< Ranges shorter than this are sorted by insertion sort as a single run */
+				max_runs = 128	/**< Depth of the run stack, enough for any range length */
+			};
+
+			/**
+			   @brief Uninitialized storage from get_temporary_buffer with the elements constructed
+			   @details Elements are move constructed in a chain from the seed, which gets
+				the value back at the end, so T is not required to be default constructible.
+				Buffer is empty if the memory could not be allocated.
+			*/
+			template<class T>
+			class temporary_buffer
+			{
+			public:
+				template<class Iterator>
+				temporary_buffer( ptrdiff_t requested, Iterator seed )
+					:data_( 0 ), size_( 0 )
+				{
+					pair<T*, ptrdiff_t> storage = gstl::get_temporary_buffer<T>( requested );
+					if( storage.first )
+					{
+						construct( storage.first, storage.second, seed,
+							typename is_trivial::type() );
+						data_ = storage.first;
+						size_ = storage.second;
+					}
+				}
+
+				~temporary_buffer()
+				{
+					if( data_ )
+					{
+						destroy( typename is_trivial::type() );
+						gstl::return_temporary_buffer( data_ );
+					}
+				}
+
+				T* data() const
+				{
+					return data_;
+				}
+
+				ptrdiff_t size() const
+				{
+					return size_;
+				}
+
+			private:
+				typedef boost::mpl::and_< boost::has_trivial_default_constructor<T>,
+					boost::has_trivial_destructor<T> > is_trivial;
+
+				template<class Iterator>
+				static void construct( T*, ptrdiff_t, Iterator, boost::mpl::true_ )
+				{
+				}
+
+				template<class Iterator>
+				static void construct( T* p, ptrdiff_t n, Iterator seed, boost::mpl::false_ )
+				{
+					ptrdiff_t i = 0;
+					try
+					{
+						::new( static_cast<void*>( p ) ) T( ::boost::move( *seed ) );
+						for( ++i; i != n; ++i )
+						{
+							::new( static_cast<void*>( p + i ) ) T( ::boost::move( p[i - 1] ) );
+						}
+						*seed = ::boost::move( p[n - 1] );
+					}
+					catch( ... )
+					{
+						if( i )
+						{
+							*seed = ::boost::move( p[i - 1] );
+						}
+						while( i )
+						{
+							p[--i].~T();
+						}
+						gstl::return_temporary_buffer( p );
+						throw;
+					}
+				}
+
+				void destroy( boost::mpl::true_ )
+				{
+				}
+
+				void destroy( boost::mpl::false_ )
+				{
+					for( ptrdiff_t i = 0; i != size_; ++i )
+					{
+						data_[i].~T();
+					}
+				}
+
+				temporary_buffer( const temporary_buffer& );
+				temporary_buffer& operator=( const temporary_buffer& );
+
+				T* data_;
+				ptrdiff_t size_;
+			};
+
+			template<class InputIt, class OutputIt>
+			inline OutputIt move_range( InputIt first, InputIt last, OutputIt dest )
+			{
+				for( ; first != last; ++first, ++dest )
+				{
+					*dest = ::boost::move( *first );
+				}
+				return dest;
+			}
+
+			template<class BidIt1, class BidIt2>
+			inline BidIt2 move_range_backward( BidIt1 first, BidIt1 last, BidIt2 dest_last )
+			{
+				while( first != last )
+				{
+					*--dest_last = ::boost::move( *--last );
+				}
+				return dest_last;
+			}
+
+			template<class ForwardIt, class T, class Compare>
+			inline ForwardIt lower_bound( ForwardIt first, ForwardIt last, const T& value, Compare comp )
+			{
+				typedef typename iterator_traits<ForwardIt>::difference_type difference_type;
+				difference_type len = gstl::distance( first, last );
+				while( len > 0 )
+				{
+					difference_type half = len / 2;
+					ForwardIt mid = first;
+					gstl::advance( mid, half );
+					if( comp( *mid, value ) )
+					{
+						first = ++mid;
+						len -= half + 1;
+					}
+					else
+					{
+						len = half;
+					}
+				}
+				return first;
+			}
+
+			template<class ForwardIt, class T, class Compare>
+			inline ForwardIt upper_bound( ForwardIt first, ForwardIt last, const T& value, Compare comp )
+			{
+				typedef typename iterator_traits<ForwardIt>::difference_type difference_type;
+				difference_type len = gstl::distance( first, last );
+				while( len > 0 )
+				{
+					difference_type half = len / 2;
+					ForwardIt mid = first;
+					gstl::advance( mid, half );
+					if( !comp( value, *mid ) )
+					{
+						first = ++mid;
+						len -= half + 1;
+					}
+					else
+					{
+						len = half;
+					}
+				}
+				return first;
+			}
+
+			/**
+			   @brief Merges [first, middle) and [middle, last) moving the left run to the buffer
+			*/
+			template<class BidIt, class T, class Compare>
+			inline void merge_forward( BidIt first, BidIt middle, BidIt last, T* buf, Compare comp )
+			{
+				T* buf_last = move_range( first, middle, buf );
+				while( buf != buf_last && middle != last )
+				{
+					if( comp( *middle, *buf ) )
+					{
+						*first = ::boost::move( *middle );
+						++middle;
+					}
+					else
+					{
+						*first = ::boost::move( *buf );
+						++buf;
+					}
+					++first;
+				}
+				move_range( buf, buf_last, first );
+			}
+
+			/**
+			   @brief Merges [first, middle) and [middle, last) moving the right run to the buffer
+			*/
+			template<class BidIt, class T, class Compare>
+			inline void merge_backward( BidIt first, BidIt middle, BidIt last, T* buf, Compare comp )
+			{
+				T* buf_last = move_range( middle, last, buf );
+				if( first == middle )
+				{
+					move_range_backward( buf, buf_last, last );
+					return;
+				}
+				--middle;
+				--buf_last;
+				for( ;; )
+				{
+					if( comp( *buf_last, *middle ) )
+					{
+						*--last = ::boost::move( *middle );
+						if( middle == first )
+						{
+							move_range_backward( buf, ++buf_last, last );
+							return;
+						}
+						--middle;
+					}
+					else
+					{
+						*--last = ::boost::move( *buf_last );
+						if( buf_last == buf )
+						{
+							return;
+						}
+						--buf_last;
+					}
+				}
+			}
+
+			/**
+			   @brief Rotates [first, last) so that middle becomes first, through the buffer if it fits
+			   @return New position of first
+			*/
+			template<class BidIt, class Distance, class T>
+			inline BidIt rotate_adaptive( BidIt first, BidIt middle, BidIt last,
+				Distance len1, Distance len2, T* buf, ptrdiff_t buf_size )
+			{
+				if( len1 > len2 && len2 <= buf_size )
+				{
+					if( !len2 )
+					{
+						return first;
+					}
+					T* buf_last = move_range( middle, last, buf );
+					move_range_backward( first, middle, last );
+					return move_range( buf, buf_last, first );
+				}
+				else if( len1 <= buf_size )
+				{
+					if( !len1 )
+					{
+						return last;
+					}
+					T* buf_last = move_range( first, middle, buf );
+					BidIt result = move_range( middle, last, first );
+					move_range( buf, buf_last, result );
+					return result;
+				}
+				gstl::reverse( first, middle );
+				gstl::reverse( middle, last );
+				gstl::reverse( first, last );
+				gstl::advance( first, len2 );
+				return first;
+			}
+
+			/**
+			   @brief Merges the sorted runs [first, middle) and [middle, last)
+			   @details Merges through the buffer if the shorter run fits it, otherwise splits
+				the runs around the middle element of the longer one, rotates and merges the parts.
+				With the zero buf_size the merge is done in place.
+			*/
+			template<class BidIt, class Distance, class T, class Compare>
+			void merge_adaptive( BidIt first, BidIt middle, BidIt last,
+				Distance len1, Distance len2, T* buf, ptrdiff_t buf_size, Compare comp )
+			{
+				while( len1 && len2 )
+				{
+					if( len1 <= len2 && len1 <= buf_size )
+					{
+						merge_forward( first, middle, last, buf, comp );
+						return;
+					}
+					if( len2 <= buf_size )
+					{
+						merge_backward( first, middle, last, buf, comp );
+						return;
+					}
+					if( len1 + len2 == 2 )
+					{
+						if( comp( *middle, *first ) )
+						{
+							gstl::iter_swap( first, middle );
+						}
+						return;
+					}
+
+					BidIt first_cut = first;
+					BidIt second_cut = middle;
+					Distance len11 = 0;
+					Distance len22 = 0;
+					if( len1 > len2 )
+					{
+						len11 = len1 / 2;
+						gstl::advance( first_cut, len11 );
+						second_cut = stable_sort_impl::lower_bound( middle, last, *first_cut, comp );
+						len22 = gstl::distance( middle, second_cut );
+					}
+					else
+					{
+						len22 = len2 / 2;
+						gstl::advance( second_cut, len22 );
+						first_cut = stable_sort_impl::upper_bound( first, middle, *second_cut, comp );
+						len11 = gstl::distance( first, first_cut );
+					}
+					BidIt new_middle = rotate_adaptive( first_cut, middle, second_cut,
+						len1 - len11, len22, buf, buf_size );
+
+					merge_adaptive( first, first_cut, new_middle, len11, len22, buf, buf_size, comp );
+					first = new_middle;
+					middle = second_cut;
+					len1 -= len11;
+					len2 -= len22;
+				}
+			}
+
+			/**
+			   @brief Returns length of the run starting at first, the descending run is reversed
+			   @details Only the strictly descending runs are reversed, that keeps the sort stable.
+			*/
+			template<class RanIt, class Compare>
+			inline ptrdiff_t count_run( RanIt first, RanIt last, Compare comp )
+			{
+				RanIt cur = first + 1;
+				if( cur == last )
+				{
+					return 1;
+				}
+				if( comp( *cur, *first ) )
+				{
+					for( ++cur; cur != last && comp( *cur, *( cur - 1 ) ); ++cur )
+					{}
+					gstl::reverse( first, cur );
+				}
+				else
+				{
+					for( ++cur; cur != last && !comp( *cur, *( cur - 1 ) ); ++cur )
+					{}
+				}
+				return cur - first;
+			}
+
+			/**
+			   @brief Minimal run length: n / minrun is a power of 2 or a bit less than it
+			*/
+			inline ptrdiff_t min_run_length( ptrdiff_t n )
+			{
+				ptrdiff_t low_bits = 0;
+				while( n >= min_merge )
+				{
+					low_bits |= n & 1;
+					n >>= 1;
+				}
+				return n + low_bits;
+			}
+
+			template<class RanIt>
+			struct run
+			{
+				RanIt base;
+				ptrdiff_t len;
+			};
+
+			template<class RanIt, class Compare>
+			class merge_state
+			{
+			public:
+				typedef typename iterator_traits<RanIt>::value_type value_type;
+
+				merge_state( value_type* buf, ptrdiff_t buf_size, Compare comp )
+					:buf_( buf ), buf_size_( buf_size ), comp_( comp ), depth_( 0 )
+				{}
+
+				void push( RanIt base, ptrdiff_t len )
+				{
+					GSTL_ASSERT( depth_ < max_runs );
+					runs_[depth_].base = base;
+					runs_[depth_].len = len;
+					++depth_;
+				}
+
+				/**
+				   @brief Restores the invariants of the run stack:
+					len[i - 2] > len[i - 1] + len[i] and len[i - 1] > len[i]
+				   @details The invariant is checked for the top 4 runs, see de Gouw et al.
+					"OpenJDK's java.utils.Collection.sort() is broken"
+				*/
+				void collapse()
+				{
+					while( depth_ > 1 )
+					{
+						int n = depth_ - 2;
+						if( ( n > 0 && runs_[n - 1].len <= runs_[n].len + runs_[n + 1].len )
+							|| ( n > 1 && runs_[n - 2].len <= runs_[n - 1].len + runs_[n].len ) )
+						{
+							if( runs_[n - 1].len < runs_[n + 1].len )
+							{
+								--n;
+							}
+						}
+						else if( runs_[n].len > runs_[n + 1].len )
+						{
+							break;
+						}
+						merge_at( n );
+					}
+				}
+
+				void force_collapse()
+				{
+					while( depth_ > 1 )
+					{
+						int n = depth_ - 2;
+						if( n > 0 && runs_[n - 1].len < runs_[n + 1].len )
+						{
+							--n;
+						}
+						merge_at( n );
+					}
+				}
+
+			private:
+				/**
+				   @brief Merges the runs i and i + 1
+				*/
+				void merge_at( int i )
+				{
+					RanIt first = runs_[i].base;
+					RanIt middle = runs_[i + 1].base;
+					RanIt last = middle + runs_[i + 1].len;
+
+					runs_[i].len += runs_[i + 1].len;
+					if( i == depth_ - 3 )
+					{
+						runs_[i + 1] = runs_[i + 2];
+					}
+					--depth_;
+
+					//Elements of the left run not greater than the right run head are already in place
+					first = stable_sort_impl::upper_bound( first, middle, *middle, comp_ );
+					if( first == middle )
+					{
+						return;
+					}
+					//So are the elements of the right run not less than the left run tail
+					last = stable_sort_impl::lower_bound( middle, last, *( middle - 1 ), comp_ );
+					merge_adaptive( first, middle, last, middle - first, last - middle,
+						buf_, buf_size_, comp_ );
+				}
+
+				value_type* buf_;
+				ptrdiff_t buf_size_;
+				Compare comp_;
+				run<RanIt> runs_[max_runs];
+				int depth_;
+			};
+
+			template<class RanIt, class Compare>
+			void stable_sort( RanIt first, RanIt last, Compare comp,
+				typename iterator_traits<RanIt>::value_type* buf, ptrdiff_t buf_size )
+			{
+				ptrdiff_t remaining = last - first;
+				const ptrdiff_t min_run = min_run_length( remaining );
+				merge_state<RanIt, Compare> state( buf, buf_size, comp );
+				while( remaining )
+				{
+					ptrdiff_t len = count_run( first, last, comp );
+					if( len < min_run )
+					{
+						len = remaining < min_run ? remaining : min_run;
+						sort_impl::insertion_sort( first, first + len, comp );
+					}
+					state.push( first, len );
+					state.collapse();
+					first += len;
+					remaining -= len;
+				}
+				state.force_collapse();
+			}
+
+			template<class RanIt, class Compare>
+			inline void stable_sort( RanIt first, RanIt last, Compare comp )
+			{
+				typedef typename iterator_traits<RanIt>::value_type value_type;
+				const ptrdiff_t len = last - first;
+				if( len < 2 )
+				{
+					return;
+				}
+				if( len < min_merge )
+				{//Single run, no merges
+					stable_sort( first, last, comp, static_cast<value_type*>( 0 ), 0 );
+					return;
+				}
+				//Both runs of a merge never have more than the half of the range
+				temporary_buffer<value_type> buf( ( len + 1 ) / 2, first );
+				stable_sort( first, last, comp, buf.data(), buf.size() );
+			}
+
+			template<class BidIt, class Compare>
+			inline void inplace_merge( BidIt first, BidIt middle, BidIt last, Compare comp )
+			{
+				typedef typename iterator_traits<BidIt>::value_type value_type;
+				typedef typename iterator_traits<BidIt>::difference_type difference_type;
+				const difference_type len1 = gstl::distance( first, middle );
+				const difference_type len2 = gstl::distance( middle, last );
+				if( !len1 || !len2 )
+				{
+					return;
+				}
+				temporary_buffer<value_type> buf( len1 < len2 ? len1 : len2, first );
+				merge_adaptive( first, middle, last, len1, len2, buf.data(), buf.size(), comp );
+			}
+		}
+	}
+
+	/**
+	   @brief Sorts [first, last) by comp, the order of the equal elements is not preserved
+	   @details Pattern-defeating quicksort: O(n log n) in the worst case, O(n) for the sorted,
+		reversed and the equal elements. Iterators of vector and basic_string are sorted
+		as raw pointers, arithmetic elements with std::less or std::greater are
+		partitioned without branches.
+	*/
+	template<class RandomAccessIterator, class Compare>
+	void sort( RandomAccessIterator first, RandomAccessIterator last, Compare comp )
+	{
+		GSTL_DEBUG_RANGE( first, last );
+		detail::sort_impl::pdqsort( detail::unwrap_iter( first ), detail::unwrap_iter( last ), comp );
+	}
+
+	template<class RandomAccessIterator>
+	void sort( RandomAccessIterator first, RandomAccessIterator last )
+	{
+		gstl::sort( first, last, std::less<GSTL_ITER_VALUE_TYPE( RandomAccessIterator )>() );
+	}
+
+	/**
+	   @brief Sorts [first, last) by comp preserving the order of the equal elements
+	   @details Natural merge sort: O(n) for the sorted and the reversed ranges, O(n log n)
+		in the worst case. Takes a temporary buffer of n / 2 elements, if the memory
+		is tight the sort runs in place in O(n log^2 n).
+	*/
+	template<class RandomAccessIterator, class Compare>
+	void stable_sort( RandomAccessIterator first, RandomAccessIterator last, Compare comp )
+	{
+		GSTL_DEBUG_RANGE( first, last );
+		detail::stable_sort_impl::stable_sort( detail::unwrap_iter( first ),
+			detail::unwrap_iter( last ), comp );
+	}
+
+	template<class RandomAccessIterator>
+	void stable_sort( RandomAccessIterator first, RandomAccessIterator last )
+	{
+		gstl::stable_sort( first, last, std::less<GSTL_ITER_VALUE_TYPE( RandomAccessIterator )>() );
+	}
+
+	template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+	OutputIterator merge( InputIterator1 first1, InputIterator1 last1,
+		InputIterator2 first2, InputIterator2 last2,
+		OutputIterator result, Compare comp )
+	{
+		GSTL_DEBUG_RANGE( first1, last1 );
+		GSTL_DEBUG_RANGE( first2, last2 );
+		for( ; first1 != last1 && first2 != last2; ++result )
+		{
+			//Equal elements are taken from the first range
+			if( comp( *first2, *first1 ) )
+			{
+				*result = *first2;
+				++first2;
+			}
+			else
+			{
+				*result = *first1;
+				++first1;
+			}
+		}
+		return gstl::copy( first2, last2, gstl::copy( first1, last1, result ) );
+	}
+
+	template<class InputIterator1, class InputIterator2, class OutputIterator>
+	OutputIterator merge( InputIterator1 first1, InputIterator1 last1,
+		InputIterator2 first2, InputIterator2 last2,
+		OutputIterator result )
+	{
+		return gstl::merge( first1, last1, first2, last2, result,
+			std::less<GSTL_ITER_VALUE_TYPE( InputIterator1 )>() );
+	}
+
+	/**
+	   @brief Merges the sorted ranges [first, middle) and [middle, last) preserving
+		the order of the equal elements
+	   @details Linear with a temporary buffer of the shorter range size,
+		O(n log n) in place if the buffer can't be allocated.
+	*/
+	template<class BidirectionalIterator, class Compare>
+	void inplace_merge( BidirectionalIterator first, BidirectionalIterator middle,
+		BidirectionalIterator last, Compare comp )
+	{
+		GSTL_DEBUG_RANGE( first, middle );
+		GSTL_DEBUG_RANGE( middle, last );
+		detail::stable_sort_impl::inplace_merge( detail::unwrap_iter( first ),
+			detail::unwrap_iter( middle ), detail::unwrap_iter( last ), comp );
+	}
+
+	template<class BidirectionalIterator>
+	void inplace_merge( BidirectionalIterator first, BidirectionalIterator middle,
+		BidirectionalIterator last )
+	{
+		gstl::inplace_merge( first, middle, last,
+			std::less<GSTL_ITER_VALUE_TYPE( BidirectionalIterator )>() );
+	}
+}
+
+#endif //GSTL_SORT_HEADER
@@ -0,0 +1,218 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_STRING_CONCAT_HEADER
+#define GSTL_STRING_CONCAT_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <stddef.h>
+#include <stdexcept>
+#include <gstl/detail/basic_string_view.hpp>
+
+namespace gstl
+{
+	/**
+	   @brief Builder of the concatenation of strings, views, character arrays and characters
+	   @details Collects the pieces, sums their sizes, sizes the destination once and
+		copies every piece with traits_type::copy, so
+		string_concat()( host )( '/' )( path )( ".html" ).assign_to( key )
+		allocates at most once and not at all, if key has enough capacity.
+		The chain starts with the default constructed builder, string_concat( host )( '/' )
+		would declare the variable host.
+		The pieces are referred to, not copied, so the builder must not outlive them.
+		At most MaxPieces pieces are accepted, std::length_error is thrown otherwise.
+	*/
+	template<class String, size_t MaxPieces = 16>
+	class basic_string_concat
+	{
+	public:
+		typedef String									string_type;
+		typedef typename String::value_type				value_type;
+		typedef typename String::traits_type			traits_type;
+		typedef typename String::size_type				size_type;
+		typedef typename String::allocator_type			allocator_type;
+		typedef basic_string_view<value_type, traits_type>	string_view_type;
+
+		enum{ max_pieces = MaxPieces };
+
+		basic_string_concat()
+			:count_( 0 )
+			,size_( 0 )
+		{}
+
+		explicit basic_string_concat( string_view_type sv )
+			:count_( 0 )
+			,size_( 0 )
+		{
+			_add( sv.data(), sv.size() );
+		}
+
+		explicit basic_string_concat( value_type c )
+			:count_( 0 )
+			,size_( 0 )
+		{
+			_add( c );
+		}
+
+		basic_string_concat& operator()( string_view_type sv )
+		{
+			_add( sv.data(), sv.size() );
+			return *this;
+		}
+
+		basic_string_concat& operator()( value_type c )
+		{
+			_add( c );
+			return *this;
+		}
+
+		/**
+		   @brief Total size of the pieces
+		*/
+		size_type size() const
+		{
+			return size_;
+		}
+
+		/**
+		   @brief Replaces the characters of str, its capacity is reused
+		   @details Pieces, which refer to str itself, are built in a new buffer.
+		*/
+		template<class StringT>
+		StringT& assign_to( StringT& str ) const
+		{
+			if( _refers_to( str.data(), str.data() + str.size() ) )
+			{
+				StringT result( str.get_allocator() );
+				assign_to( result );
+				str.swap( result );
+				return str;
+			}
+			str.clear();
+			str.resize_default_init( size_ );
+			_copy_to( &str[0] );
+			return str;
+		}
+
+		/**
+		   @brief Appends the pieces to str, it is grown at most once
+		   @details Pieces, which refer to str itself, are built in a temporary string first.
+		*/
+		template<class StringT>
+		StringT& append_to( StringT& str ) const
+		{
+			if( _refers_to( str.data(), str.data() + str.size() ) )
+			{
+				StringT tail( str.get_allocator() );
+				assign_to( tail );
+				return str.append( tail.data(), tail.size() );
+			}
+			const size_type old_size = str.size();
+			str.resize_default_init( old_size + size_ );
+			_copy_to( &str[0] + old_size );
+			return str;
+		}
+
+		/**
+		   @brief Builds the new string of exactly the total size
+		*/
+		string_type str( const allocator_type& alloc = allocator_type() ) const
+		{
+			string_type result( alloc );
+			assign_to( result );
+			return result;
+		}
+
+	private:
+		//Single characters are held by value in chars_, s is null for them
+		struct piece
+		{
+			const value_type* s;
+			size_type size;
+		};
+
+		void _add( const value_type* s, size_type n )
+		{
+			if( n == 0 )
+			{
+				return;
+			}
+			_check_count();
+			pieces_[count_].s = s;
+			pieces_[count_].size = n;
+			++count_;
+			size_ += n;
+		}
+
+		void _add( value_type c )
+		{
+			_check_count();
+			pieces_[count_].s = 0;
+			pieces_[count_].size = 1;
+			chars_[count_] = c;
+			++count_;
+			++size_;
+		}
+
+		void _check_count() const
+		{
+			if( count_ == MaxPieces )
+			{
+				throw std::length_error( "too many pieces to concatenate" );
+			}
+		}
+
+		void _copy_to( value_type* dst ) const
+		{
+			for( size_type i = 0; i < count_; ++i )
+			{
+				const piece& p = pieces_[i];
+				traits_type::copy( dst, p.s != 0 ? p.s : &chars_[i], p.size );
+				dst += p.size;
+			}
+		}
+
+		bool _refers_to( const value_type* first, const value_type* last ) const
+		{
+			for( size_type i = 0; i < count_; ++i )
+			{
+				const piece& p = pieces_[i];
+				if( p.s != 0 && p.s < last && first < p.s + p.size )
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		piece pieces_[MaxPieces];
+		value_type chars_[MaxPieces];
+		size_type count_;
+		size_type size_;
+	};
+}
+
+#endif //GSTL_STRING_CONCAT_HEADER
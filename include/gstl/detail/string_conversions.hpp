@@ -0,0 +1,250 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_STRING_CONVERSIONS_HEADER
+#define GSTL_STRING_CONVERSIONS_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <stdexcept>
+#include <gstl/detail/basic_string.hpp>
+#include <gstl/detail/charconv.hpp>
+#include <gstl/detail/utf8.hpp>
+
+#include <gstl/detail/boost_warnings_off.hpp>
+#include <boost/cstdint.hpp>
+#include <gstl/detail/boost_warnings_on.hpp>
+
+namespace gstl
+{
+	namespace detail
+	{
+		namespace charconv
+		{
+			/**
+			   @brief Enough for any integer in base 10 and the shortest form of double
+			*/
+			enum { max_number_chars = 32 };
+
+			inline bool is_space( char c )
+			{
+				return c == ' ' || ( c >= '\t' && c <= '\r' );
+			}
+
+			/**
+			   @brief Implementation of the sto* functions: skips the leading whitespaces,
+				accepts '+' and reports errors by the exceptions as the std ones do
+			*/
+			template<class Number, class Parse>
+			inline Number string_to_number( const char* first, const char* last, size_t* idx,
+				Parse parse, const char* name )
+			{
+				const char* p = first;
+				while( p != last && is_space( *p ) )
+				{
+					++p;
+				}
+				if( p != last && *p == '+' && p + 1 != last && p[1] != '-' )
+				{
+					++p;
+				}
+
+				Number value = Number();
+				const from_chars_result result = parse( p, last, value );
+				if( result.ec == chars_invalid_argument )
+				{
+					throw std::invalid_argument( name );
+				}
+				if( result.ec == chars_value_too_large )
+				{
+					throw std::out_of_range( name );
+				}
+				if( idx != 0 )
+				{
+					*idx = static_cast<size_t>( result.ptr - first );
+				}
+				return value;
+			}
+
+			template<class Int>
+			struct parse_integer
+			{
+				explicit parse_integer( int base )
+					:base_( base )
+				{}
+
+				from_chars_result operator()( const char* first, const char* last, Int& value ) const
+				{
+					return gstl::from_chars( first, last, value, base_ );
+				}
+
+			private:
+				int base_;
+			};
+
+			template<class Float>
+			struct parse_float
+			{
+				from_chars_result operator()( const char* first, const char* last, Float& value ) const
+				{
+					return gstl::from_chars( first, last, value );
+				}
+			};
+		}
+	}
+
+	/**
+	   @brief Appends the decimal representation of the number to str
+	   @details Characters are written by to_chars directly into the spare capacity of the string,
+		no temporary strings and no iostreams are involved.
+	*/
+	template<class StringT, class Number>
+	inline StringT& append_number( StringT& str, Number value )
+	{
+		typedef typename StringT::size_type size_type;
+		const size_type old_size = str.size();
+		str.resize_default_init( old_size + detail::charconv::max_number_chars );
+		char* first = &str[0] + old_size;
+		const to_chars_result result = gstl::to_chars( first, first + detail::charconv::max_number_chars, value );
+		GSTL_ASSERT( result.ec == chars_ok );
+		str.resize_default_init( old_size + static_cast<size_type>( result.ptr - first ) );
+		return str;
+	}
+
+	/**
+	   @brief Returns the decimal representation of the number,
+		floating point numbers are written in the shortest round-trip form
+	*/
+	template<class Number>
+	inline string to_string( Number value )
+	{
+		string result;
+		return append_number( result, value );
+	}
+
+	inline int stoi( const string& str, size_t* idx = 0, int base = 10 )
+	{
+		return detail::charconv::string_to_number<int>( str.data(), str.data() + str.size(), idx,
+			detail::charconv::parse_integer<int>( base ), "gstl::stoi" );
+	}
+
+	inline long stol( const string& str, size_t* idx = 0, int base = 10 )
+	{
+		return detail::charconv::string_to_number<long>( str.data(), str.data() + str.size(), idx,
+			detail::charconv::parse_integer<long>( base ), "gstl::stol" );
+	}
+
+	inline unsigned long stoul( const string& str, size_t* idx = 0, int base = 10 )
+	{
+		return detail::charconv::string_to_number<unsigned long>( str.data(), str.data() + str.size(), idx,
+			detail::charconv::parse_integer<unsigned long>( base ), "gstl::stoul" );
+	}
+
+	inline boost::long_long_type stoll( const string& str, size_t* idx = 0, int base = 10 )
+	{
+		return detail::charconv::string_to_number<boost::long_long_type>( str.data(), str.data() + str.size(), idx,
+			detail::charconv::parse_integer<boost::long_long_type>( base ), "gstl::stoll" );
+	}
+
+	inline boost::ulong_long_type stoull( const string& str, size_t* idx = 0, int base = 10 )
+	{
+		return detail::charconv::string_to_number<boost::ulong_long_type>( str.data(), str.data() + str.size(), idx,
+			detail::charconv::parse_integer<boost::ulong_long_type>( base ), "gstl::stoull" );
+	}
+
+	inline float stof( const string& str, size_t* idx = 0 )
+	{
+		return detail::charconv::string_to_number<float>( str.data(), str.data() + str.size(), idx,
+			detail::charconv::parse_float<float>(), "gstl::stof" );
+	}
+
+	inline double stod( const string& str, size_t* idx = 0 )
+	{
+		return detail::charconv::string_to_number<double>( str.data(), str.data() + str.size(), idx,
+			detail::charconv::parse_float<double>(), "gstl::stod" );
+	}
+
+	template<class Traits>
+	inline bool utf8_validate( const basic_string_view<char, Traits>& str )
+	{
+		return utf8_validate( str.data(), str.data() + str.size() );
+	}
+
+	template<class Traits, class Alloc, class GrowthPolicy>
+	inline bool utf8_validate( const basic_string<char, Traits, Alloc, GrowthPolicy>& str )
+	{
+		return utf8_validate( str.data(), str.data() + str.size() );
+	}
+
+	/**
+	   @brief Replaces the content of the wide string by the converted UTF-8 text
+	   @details The length is computed first, so the string is resized once
+		and the characters are written in place.
+	   @exception std::range_error if the text is not valid UTF-8
+	*/
+	template<class WideString>
+	inline WideString& utf8_to_wide( const char* first, const char* last, WideString& out )
+	{
+		const size_t length = utf8_to_wide_length( first, last );
+		out.resize_default_init( length );
+		if( length != 0 )
+		{
+			utf8_to_wide( first, last, &out[0] );
+		}
+		return out;
+	}
+
+	inline wstring utf8_to_wide( const string_view& str )
+	{
+		wstring result;
+		return utf8_to_wide( str.data(), str.data() + str.size(), result );
+	}
+
+	/**
+	   @brief Replaces the content of the string by the wide text converted to UTF-8
+	   @details The length is computed first, so the string is resized once
+		and the characters are written in place.
+	   @exception std::range_error if the text is not valid UTF-16/UTF-32
+	*/
+	template<class NarrowString>
+	inline NarrowString& wide_to_utf8( const wchar_t* first, const wchar_t* last, NarrowString& out )
+	{
+		const size_t length = wide_to_utf8_length( first, last );
+		out.resize_default_init( length );
+		if( length != 0 )
+		{
+			wide_to_utf8( first, last, &out[0] );
+		}
+		return out;
+	}
+
+	inline string wide_to_utf8( const wstring_view& str )
+	{
+		string result;
+		return wide_to_utf8( str.data(), str.data() + str.size(), result );
+	}
+}
+
+#endif //GSTL_STRING_CONVERSIONS_HEADER
@@ -0,0 +1,304 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_STRING_SEARCHER_HEADER
+#define GSTL_STRING_SEARCHER_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <gstl/detail/types.hpp>
+#include <gstl/detail/assert.hpp>
+#include <gstl/detail/char_traits.hpp>
+
+#include <gstl/detail/boost_warnings_off.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <gstl/detail/boost_warnings_on.hpp>
+
+namespace gstl
+{
+	namespace detail
+	{
+		/**
+		   @brief Substring search helpers shared by basic_string and string_searcher
+		*/
+		template<class Traits>
+		struct substring_search
+		{
+			typedef typename Traits::char_type	value_type;
+			typedef typename Traits::size_type	size_type;
+
+			/**
+			   @brief Patterns up to this size are searched by the first/last character filter
+			*/
+			enum{ short_pattern_size = 8 };
+
+			/**
+			   @brief Size of the shift tables, characters are hashed by their low byte
+			*/
+			enum{ table_size = 256 };
+
+			static inline size_type table_index( const value_type& c )
+			{
+				return static_cast<size_type>( Traits::to_int_type( c ) ) & ( table_size - 1 );
+			}
+
+			/**
+			   @brief Shift tables are built only for gstl::char_traits
+			   @details Custom traits may compare characters in their own way (e.g. case insensitive),
+				then equal characters fall into different table slots and the shifts skip matches
+			*/
+			enum{ use_tables = boost::is_same< Traits, gstl::char_traits<value_type> >::value };
+
+			/**
+			   @brief Checks whether the pattern is searched by Horspool with the shift tables
+			*/
+			static inline bool is_long( size_type n )
+			{
+				return use_tables && n > short_pattern_size;
+			}
+
+			/**
+			   @brief Returns first occurrence of s[0, n) in [first, last) or 0
+			   @details Candidates are located by traits_type::find of the first character
+				(memchr for char) and rejected by the last character before the full compare.
+			*/
+			static const value_type* find_short( const value_type* first, const value_type* last,
+				const value_type* s, size_type n )
+			{
+				GSTL_ASSERT( n != 0 && "empty pattern" );
+				if( static_cast<size_type>( last - first ) < n )
+				{
+					return 0;
+				}
+
+				const value_type* curr = first;
+				//Number of the possible match positions
+				size_type count = ( last - first ) - n + 1;
+				const value_type* fres;
+				while( ( fres = Traits::find( curr, count, *s ) ) != 0 )
+				{
+					if( Traits::eq( fres[n - 1], s[n - 1] )
+						&& Traits::compare( fres + 1, s + 1, n - 1 ) == 0 )
+					{
+						return fres;
+					}
+					count -= fres - curr + 1;
+					curr = fres + 1;
+				}
+				return 0;
+			}
+
+			/**
+			   @brief Returns last occurrence of s[0, n) in [first, last) or 0
+			*/
+			static const value_type* rfind_short( const value_type* first, const value_type* last,
+				const value_type* s, size_type n )
+			{
+				GSTL_ASSERT( n != 0 && "empty pattern" );
+				if( static_cast<size_type>( last - first ) < n )
+				{
+					return 0;
+				}
+
+				for( const value_type* curr = last - n; ; --curr )
+				{
+					if( Traits::eq( *curr, *s )
+						&& Traits::eq( curr[n - 1], s[n - 1] )
+						&& Traits::compare( curr + 1, s + 1, n - 1 ) == 0 )
+					{
+						return curr;
+					}
+					if( curr == first )
+					{
+						return 0;
+					}
+				}
+			}
+		};
+	}
+
+	/**
+	   @brief Preprocessed substring pattern
+	   @details Short patterns are searched by the first/last character filter, the long ones
+		by Boyer-Moore-Horspool, whose shift tables are built once in the constructor,
+		so the same searcher can be applied to any number of texts.
+		With custom traits all patterns are searched by the character filter.
+		The pattern is not copied and must outlive the searcher.
+	*/
+	template<class CharT, class Traits = gstl::char_traits<CharT> >
+	class string_searcher
+	{
+	public:
+		typedef CharT								value_type;
+		typedef Traits								traits_type;
+		typedef typename traits_type::size_type		size_type;
+
+	private:
+		typedef detail::substring_search<traits_type>	search_type;
+
+	public:
+		string_searcher( const value_type* s, size_type n )
+			:pattern_( s )
+			,size_( n )
+		{
+			GSTL_ASSERT( ( s != 0 || n == 0 ) && "s is null" );
+			if( is_long() )
+			{
+				_build_tables();
+			}
+		}
+
+		explicit string_searcher( const value_type* s )
+			:pattern_( s )
+			,size_( traits_type::length( s ) )
+		{
+			if( is_long() )
+			{
+				_build_tables();
+			}
+		}
+
+		const value_type* pattern() const
+		{
+			return pattern_;
+		}
+
+		size_type pattern_size() const
+		{
+			return size_;
+		}
+
+		/**
+		   @brief Returns first occurrence of the pattern in [first, last) or 0
+		   @details Empty pattern matches at first
+		*/
+		const value_type* find( const value_type* first, const value_type* last ) const
+		{
+			if( size_ == 0 )
+			{
+				return first;
+			}
+			if( !is_long() )
+			{
+				return search_type::find_short( first, last, pattern_, size_ );
+			}
+			if( static_cast<size_type>( last - first ) < size_ )
+			{
+				return 0;
+			}
+
+			//Horspool: compare the last character of the window first and shift
+			//by the distance to its rightmost occurrence in the pattern
+			const size_type lastpos = size_ - 1;
+			const size_type end = ( last - first ) - size_;
+			const value_type last_char = pattern_[lastpos];
+			for( size_type i = 0; i <= end; )
+			{
+				const value_type c = first[i + lastpos];
+				if( traits_type::eq( c, last_char )
+					&& traits_type::compare( first + i, pattern_, lastpos ) == 0 )
+				{
+					return first + i;
+				}
+				i += shift_[search_type::table_index( c )];
+			}
+			return 0;
+		}
+
+		/**
+		   @brief Returns last occurrence of the pattern in [first, last) or 0
+		   @details Empty pattern matches at last
+		*/
+		const value_type* rfind( const value_type* first, const value_type* last ) const
+		{
+			if( size_ == 0 )
+			{
+				return last;
+			}
+			if( !is_long() )
+			{
+				return search_type::rfind_short( first, last, pattern_, size_ );
+			}
+			if( static_cast<size_type>( last - first ) < size_ )
+			{
+				return 0;
+			}
+
+			//Mirrored Horspool: compare the first character of the window first and shift
+			//by the distance to its leftmost occurrence in the pattern
+			const value_type first_char = pattern_[0];
+			for( size_type i = ( last - first ) - size_; ; )
+			{
+				const value_type c = first[i];
+				if( traits_type::eq( c, first_char )
+					&& traits_type::compare( first + i + 1, pattern_ + 1, size_ - 1 ) == 0 )
+				{
+					return first + i;
+				}
+				const size_type shift = rshift_[search_type::table_index( c )];
+				if( i < shift )
+				{
+					return 0;
+				}
+				i -= shift;
+			}
+		}
+
+	private:
+		bool is_long() const
+		{
+			return search_type::is_long( size_ );
+		}
+
+		/**
+		   @brief Builds the shift tables
+		   @details Characters with the same table index share the slot and the smallest
+			shift wins, so hashing of the wide characters never skips a match.
+		*/
+		void _build_tables()
+		{
+			for( size_type i = 0; i < search_type::table_size; ++i )
+			{
+				shift_[i] = size_;
+				rshift_[i] = size_;
+			}
+			for( size_type i = 0; i + 1 < size_; ++i )
+			{
+				shift_[search_type::table_index( pattern_[i] )] = size_ - 1 - i;
+			}
+			for( size_type i = size_ - 1; i > 0; --i )
+			{
+				rshift_[search_type::table_index( pattern_[i] )] = i;
+			}
+		}
+
+		const value_type* pattern_;
+		size_type size_;
+		size_type shift_[search_type::table_size];
+		size_type rshift_[search_type::table_size];
+	};
+}
+
+#endif //GSTL_STRING_SEARCHER_HEADER
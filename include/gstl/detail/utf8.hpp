@@ -0,0 +1,710 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#ifndef GSTL_UTF8_HEADER
+#define GSTL_UTF8_HEADER
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#include <stddef.h>
+#include <string.h>
+#include <stdexcept>
+#include <gstl/detail/assert.hpp>
+#include <gstl/detail/temp_buffer.hpp>
+
+#include <gstl/detail/boost_warnings_off.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <gstl/detail/boost_warnings_on.hpp>
+
+//Define GSTL_NO_SIMD to use only the portable code
+#if !defined(GSTL_NO_SIMD)
+#	if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#		define GSTL_UTF_SSE2
+#		include <emmintrin.h>
+#	endif
+#	if defined(__AVX2__)
+#		define GSTL_UTF_AVX2
+#		include <immintrin.h>
+#	endif
+#endif
+
+namespace gstl
+{
+	namespace detail
+	{
+		namespace utf
+		{
+			typedef boost::uint32_t uint32;
+			typedef boost::uint64_t uint64;
+
+			/**
+			   @brief Returns the length of the leading run of ASCII characters
+			   @details Checks 32 or 16 bytes per step with AVX2 or SSE2,
+				8 bytes per step without them.
+			*/
+			inline size_t ascii_run( const char* first, const char* last )
+			{
+				const char* p = first;
+#if defined(GSTL_UTF_AVX2)
+				while( last - p >= 32
+					&& _mm256_movemask_epi8( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( p ) ) ) == 0 )
+				{
+					p += 32;
+				}
+#endif
+#if defined(GSTL_UTF_SSE2)
+				while( last - p >= 16
+					&& _mm_movemask_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) ) ) == 0 )
+				{
+					p += 16;
+				}
+#else
+				while( last - p >= 8 )
+				{
+					uint64 word;
+					memcpy( &word, p, sizeof( word ) );
+					if( ( word & 0x8080808080808080ULL ) != 0 )
+					{
+						break;
+					}
+					p += 8;
+				}
+#endif
+				//The rest of the run is shorter than one block
+				while( p != last && static_cast<unsigned char>( *p ) < 0x80 )
+				{
+					++p;
+				}
+				return static_cast<size_t>( p - first );
+			}
+
+			/**
+			   @brief ASCII kernels for the wide code units of the given size
+			*/
+			template<size_t UnitSize>
+			struct ascii_kernels;
+
+			template<>
+			struct ascii_kernels<2>
+			{
+				template<class WideChar>
+				static size_t run( const WideChar* first, const WideChar* last )
+				{
+					const WideChar* p = first;
+#if defined(GSTL_UTF_SSE2)
+					const __m128i mask = _mm_set1_epi16( static_cast<short>( 0xFF80 ) );
+					const __m128i zero = _mm_setzero_si128();
+					while( last - p >= 8 )
+					{
+						const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+						if( _mm_movemask_epi8( _mm_cmpeq_epi16( _mm_and_si128( v, mask ), zero ) ) != 0xFFFF )
+						{
+							break;
+						}
+						p += 8;
+					}
+#endif
+					while( p != last && static_cast<boost::uint16_t>( *p ) < 0x80 )
+					{
+						++p;
+					}
+					return static_cast<size_t>( p - first );
+				}
+
+				template<class WideChar>
+				static WideChar* widen( const char* p, size_t n, WideChar* out )
+				{
+#if defined(GSTL_UTF_SSE2)
+					const __m128i zero = _mm_setzero_si128();
+					for( ; n >= 16; n -= 16, p += 16, out += 16 )
+					{
+						const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+						_mm_storeu_si128( reinterpret_cast<__m128i*>( out ), _mm_unpacklo_epi8( v, zero ) );
+						_mm_storeu_si128( reinterpret_cast<__m128i*>( out + 8 ), _mm_unpackhi_epi8( v, zero ) );
+					}
+#endif
+					for( ; n != 0; --n )
+					{
+						*out++ = static_cast<WideChar>( *p++ );
+					}
+					return out;
+				}
+
+				template<class WideChar>
+				static char* narrow( const WideChar* p, size_t n, char* out )
+				{
+#if defined(GSTL_UTF_SSE2)
+					for( ; n >= 16; n -= 16, p += 16, out += 16 )
+					{
+						const __m128i lo = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+						const __m128i hi = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p + 8 ) );
+						_mm_storeu_si128( reinterpret_cast<__m128i*>( out ), _mm_packus_epi16( lo, hi ) );
+					}
+#endif
+					for( ; n != 0; --n )
+					{
+						*out++ = static_cast<char>( *p++ );
+					}
+					return out;
+				}
+			};
+
+			template<>
+			struct ascii_kernels<4>
+			{
+				template<class WideChar>
+				static size_t run( const WideChar* first, const WideChar* last )
+				{
+					const WideChar* p = first;
+#if defined(GSTL_UTF_SSE2)
+					const __m128i mask = _mm_set1_epi32( static_cast<int>( 0xFFFFFF80 ) );
+					const __m128i zero = _mm_setzero_si128();
+					while( last - p >= 4 )
+					{
+						const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+						if( _mm_movemask_epi8( _mm_cmpeq_epi32( _mm_and_si128( v, mask ), zero ) ) != 0xFFFF )
+						{
+							break;
+						}
+						p += 4;
+					}
+#endif
+					while( p != last && static_cast<uint32>( *p ) < 0x80 )
+					{
+						++p;
+					}
+					return static_cast<size_t>( p - first );
+				}
+
+				template<class WideChar>
+				static WideChar* widen( const char* p, size_t n, WideChar* out )
+				{
+#if defined(GSTL_UTF_SSE2)
+					const __m128i zero = _mm_setzero_si128();
+					for( ; n >= 16; n -= 16, p += 16, out += 16 )
+					{
+						const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+						const __m128i lo = _mm_unpacklo_epi8( v, zero );
+						const __m128i hi = _mm_unpackhi_epi8( v, zero );
+						_mm_storeu_si128( reinterpret_cast<__m128i*>( out ), _mm_unpacklo_epi16( lo, zero ) );
+						_mm_storeu_si128( reinterpret_cast<__m128i*>( out + 4 ), _mm_unpackhi_epi16( lo, zero ) );
+						_mm_storeu_si128( reinterpret_cast<__m128i*>( out + 8 ), _mm_unpacklo_epi16( hi, zero ) );
+						_mm_storeu_si128( reinterpret_cast<__m128i*>( out + 12 ), _mm_unpackhi_epi16( hi, zero ) );
+					}
+#endif
+					for( ; n != 0; --n )
+					{
+						*out++ = static_cast<WideChar>( *p++ );
+					}
+					return out;
+				}
+
+				template<class WideChar>
+				static char* narrow( const WideChar* p, size_t n, char* out )
+				{
+#if defined(GSTL_UTF_SSE2)
+					for( ; n >= 8; n -= 8, p += 8, out += 8 )
+					{
+						const __m128i lo = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+						const __m128i hi = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p + 4 ) );
+						const __m128i units = _mm_packs_epi32( lo, hi );
+						_mm_storel_epi64( reinterpret_cast<__m128i*>( out ), _mm_packus_epi16( units, units ) );
+					}
+#endif
+					for( ; n != 0; --n )
+					{
+						*out++ = static_cast<char>( *p++ );
+					}
+					return out;
+				}
+			};
+
+			/**
+			   @brief Decodes one non-ASCII UTF-8 sequence
+			   @details Rejects the overlong forms, the surrogates and the code points above U+10FFFF.
+			   @return Length of the sequence, or 0 if it is invalid
+			*/
+			inline size_t decode_utf8( const char* first, const char* last, uint32& cp )
+			{
+				const unsigned char* p = reinterpret_cast<const unsigned char*>( first );
+				const ptrdiff_t avail = last - first;
+				const uint32 c0 = p[0];
+				if( c0 < 0x80 )
+				{
+					cp = c0;
+					return 1;
+				}
+				if( c0 < 0xC2 || c0 > 0xF4 || avail < 2 || ( p[1] & 0xC0 ) != 0x80 )
+				{
+					return 0;
+				}
+				const uint32 c1 = p[1] & 0x3F;
+				if( c0 < 0xE0 )
+				{
+					cp = ( ( c0 & 0x1F ) << 6 ) | c1;
+					return 2;
+				}
+				if( avail < 3 || ( p[2] & 0xC0 ) != 0x80 )
+				{
+					return 0;
+				}
+				const uint32 c2 = p[2] & 0x3F;
+				if( c0 < 0xF0 )
+				{
+					cp = ( ( c0 & 0x0F ) << 12 ) | ( c1 << 6 ) | c2;
+					//Overlong forms and the surrogates
+					return cp < 0x800 || ( cp >= 0xD800 && cp <= 0xDFFF ) ? 0 : 3;
+				}
+				if( avail < 4 || ( p[3] & 0xC0 ) != 0x80 )
+				{
+					return 0;
+				}
+				cp = ( ( c0 & 0x07 ) << 18 ) | ( c1 << 12 ) | ( c2 << 6 ) | ( p[3] & 0x3F );
+				return cp < 0x10000 || cp > 0x10FFFF ? 0 : 4;
+			}
+
+			inline size_t utf8_length( uint32 cp )
+			{
+				return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+			}
+
+			inline char* encode_utf8( uint32 cp, char* out )
+			{
+				if( cp < 0x80 )
+				{
+					*out++ = static_cast<char>( cp );
+				}
+				else if( cp < 0x800 )
+				{
+					*out++ = static_cast<char>( 0xC0 | ( cp >> 6 ) );
+					*out++ = static_cast<char>( 0x80 | ( cp & 0x3F ) );
+				}
+				else if( cp < 0x10000 )
+				{
+					*out++ = static_cast<char>( 0xE0 | ( cp >> 12 ) );
+					*out++ = static_cast<char>( 0x80 | ( ( cp >> 6 ) & 0x3F ) );
+					*out++ = static_cast<char>( 0x80 | ( cp & 0x3F ) );
+				}
+				else
+				{
+					*out++ = static_cast<char>( 0xF0 | ( cp >> 18 ) );
+					*out++ = static_cast<char>( 0x80 | ( ( cp >> 12 ) & 0x3F ) );
+					*out++ = static_cast<char>( 0x80 | ( ( cp >> 6 ) & 0x3F ) );
+					*out++ = static_cast<char>( 0x80 | ( cp & 0x3F ) );
+				}
+				return out;
+			}
+
+			/**
+			   @brief UTF-16 or UTF-32 encoding, selected by the size of the code unit
+			*/
+			template<size_t UnitSize>
+			struct wide_codec;
+
+			template<>
+			struct wide_codec<2>
+			{
+				static size_t length( uint32 cp )
+				{
+					return cp < 0x10000 ? 1 : 2;
+				}
+
+				template<class WideChar>
+				static WideChar* encode( uint32 cp, WideChar* out )
+				{
+					if( cp < 0x10000 )
+					{
+						*out++ = static_cast<WideChar>( cp );
+					}
+					else
+					{
+						cp -= 0x10000;
+						*out++ = static_cast<WideChar>( 0xD800 + ( cp >> 10 ) );
+						*out++ = static_cast<WideChar>( 0xDC00 + ( cp & 0x3FF ) );
+					}
+					return out;
+				}
+
+				/**
+				   @return Number of the code units, or 0 for the unpaired surrogate
+				*/
+				template<class WideChar>
+				static size_t decode( const WideChar* p, const WideChar* last, uint32& cp )
+				{
+					const uint32 u = static_cast<boost::uint16_t>( *p );
+					if( u < 0xD800 || u > 0xDFFF )
+					{
+						cp = u;
+						return 1;
+					}
+					if( u > 0xDBFF || last - p < 2 )
+					{
+						return 0;
+					}
+					const uint32 low = static_cast<boost::uint16_t>( p[1] );
+					if( low < 0xDC00 || low > 0xDFFF )
+					{
+						return 0;
+					}
+					cp = 0x10000 + ( ( u - 0xD800 ) << 10 ) + ( low - 0xDC00 );
+					return 2;
+				}
+			};
+
+			template<>
+			struct wide_codec<4>
+			{
+				static size_t length( uint32 )
+				{
+					return 1;
+				}
+
+				template<class WideChar>
+				static WideChar* encode( uint32 cp, WideChar* out )
+				{
+					*out++ = static_cast<WideChar>( cp );
+					return out;
+				}
+
+				template<class WideChar>
+				static size_t decode( const WideChar* p, const WideChar*, uint32& cp )
+				{
+					cp = static_cast<uint32>( *p );
+					return cp < 0xD800 || ( cp > 0xDFFF && cp <= 0x10FFFF ) ? 1 : 0;
+				}
+			};
+
+			/**
+			   @brief Counts the code units of UTF-8 text in the encoding of the given unit size
+			   @return The first invalid byte or last
+			*/
+			template<size_t UnitSize>
+			inline const char* decoded_length( const char* first, const char* last, size_t& length )
+			{
+				size_t count = 0;
+				const char* p = first;
+				for( ;; )
+				{
+					const size_t run = ascii_run( p, last );
+					p += run;
+					count += run;
+					if( p == last )
+					{
+						break;
+					}
+					uint32 cp;
+					const size_t n = decode_utf8( p, last, cp );
+					if( n == 0 )
+					{
+						break;
+					}
+					p += n;
+					count += wide_codec<UnitSize>::length( cp );
+				}
+				length = count;
+				return p;
+			}
+
+			/**
+			   @brief Counts the bytes of the wide text encoded in UTF-8
+			   @return The first invalid code unit or last
+			*/
+			template<class WideChar>
+			inline const WideChar* encoded_length( const WideChar* first, const WideChar* last, size_t& length )
+			{
+				size_t count = 0;
+				const WideChar* p = first;
+				for( ;; )
+				{
+					const size_t run = ascii_kernels<sizeof( WideChar )>::run( p, last );
+					p += run;
+					count += run;
+					if( p == last )
+					{
+						break;
+					}
+					uint32 cp;
+					const size_t n = wide_codec<sizeof( WideChar )>::decode( p, last, cp );
+					if( n == 0 )
+					{
+						break;
+					}
+					p += n;
+					count += utf8_length( cp );
+				}
+				length = count;
+				return p;
+			}
+
+			/**
+			   @brief Converts valid UTF-8 text, stops at the first invalid sequence
+			*/
+			template<class WideChar>
+			inline WideChar* decode( const char* p, const char* last, WideChar* out )
+			{
+				for( ;; )
+				{
+					const size_t run = ascii_run( p, last );
+					out = ascii_kernels<sizeof( WideChar )>::widen( p, run, out );
+					p += run;
+					if( p == last )
+					{
+						return out;
+					}
+					uint32 cp;
+					const size_t n = decode_utf8( p, last, cp );
+					GSTL_ASSERT( n != 0 && "invalid UTF-8 sequence" );
+					if( n == 0 )
+					{
+						return out;
+					}
+					p += n;
+					out = wide_codec<sizeof( WideChar )>::encode( cp, out );
+				}
+			}
+
+			/**
+			   @brief Converts valid wide text to UTF-8, stops at the first invalid code unit
+			*/
+			template<class WideChar>
+			inline char* encode( const WideChar* p, const WideChar* last, char* out )
+			{
+				for( ;; )
+				{
+					const size_t run = ascii_kernels<sizeof( WideChar )>::run( p, last );
+					out = ascii_kernels<sizeof( WideChar )>::narrow( p, run, out );
+					p += run;
+					if( p == last )
+					{
+						return out;
+					}
+					uint32 cp;
+					const size_t n = wide_codec<sizeof( WideChar )>::decode( p, last, cp );
+					GSTL_ASSERT( n != 0 && "invalid UTF-16/UTF-32 sequence" );
+					if( n == 0 )
+					{
+						return out;
+					}
+					p += n;
+					out = encode_utf8( cp, out );
+				}
+			}
+
+			inline void throw_invalid_utf8()
+			{
+				throw std::range_error( "gstl: invalid UTF-8 sequence" );
+			}
+
+			inline void throw_invalid_wide()
+			{
+				throw std::range_error( "gstl: invalid UTF-16/UTF-32 sequence" );
+			}
+		}
+	}
+
+	/**
+	   @brief Returns the start of the first invalid UTF-8 sequence in [first, last), or last
+	   @details Overlong forms, surrogates, code points above U+10FFFF and truncated
+		sequences are invalid. Runs of ASCII are checked 16 or 32 bytes at a time.
+	*/
+	inline const char* utf8_find_invalid( const char* first, const char* last )
+	{
+		size_t length;
+		return detail::utf::decoded_length<4>( first, last, length );
+	}
+
+	inline bool utf8_validate( const char* first, const char* last )
+	{
+		return utf8_find_invalid( first, last ) == last;
+	}
+
+	/**
+	   @brief Returns the number of UTF-16 code units of UTF-8 text
+	   @exception std::range_error if the text is not valid UTF-8
+	*/
+	inline size_t utf8_to_utf16_length( const char* first, const char* last )
+	{
+		size_t length;
+		if( detail::utf::decoded_length<2>( first, last, length ) != last )
+		{
+			detail::utf::throw_invalid_utf8();
+		}
+		return length;
+	}
+
+	/**
+	   @brief Returns the number of code points of UTF-8 text
+	   @exception std::range_error if the text is not valid UTF-8
+	*/
+	inline size_t utf8_to_utf32_length( const char* first, const char* last )
+	{
+		size_t length;
+		if( detail::utf::decoded_length<4>( first, last, length ) != last )
+		{
+			detail::utf::throw_invalid_utf8();
+		}
+		return length;
+	}
+
+	/**
+	   @brief Converts valid UTF-8 text to UTF-16, out must have room for utf8_to_utf16_length() units
+	   @return End of the written units
+	*/
+	template<class Char16>
+	inline Char16* utf8_to_utf16( const char* first, const char* last, Char16* out )
+	{
+		BOOST_STATIC_ASSERT( sizeof( Char16 ) == 2 );
+		return detail::utf::decode( first, last, out );
+	}
+
+	/**
+	   @brief Converts valid UTF-8 text to UTF-32, out must have room for utf8_to_utf32_length() units
+	   @return End of the written units
+	*/
+	template<class Char32>
+	inline Char32* utf8_to_utf32( const char* first, const char* last, Char32* out )
+	{
+		BOOST_STATIC_ASSERT( sizeof( Char32 ) == 4 );
+		return detail::utf::decode( first, last, out );
+	}
+
+	/**
+	   @brief Returns the number of UTF-8 bytes of UTF-16 text
+	   @exception std::range_error if the text has unpaired surrogates
+	*/
+	template<class Char16>
+	inline size_t utf16_to_utf8_length( const Char16* first, const Char16* last )
+	{
+		BOOST_STATIC_ASSERT( sizeof( Char16 ) == 2 );
+		size_t length;
+		if( detail::utf::encoded_length( first, last, length ) != last )
+		{
+			detail::utf::throw_invalid_wide();
+		}
+		return length;
+	}
+
+	/**
+	   @brief Returns the number of UTF-8 bytes of UTF-32 text
+	   @exception std::range_error if the text has surrogates or values above U+10FFFF
+	*/
+	template<class Char32>
+	inline size_t utf32_to_utf8_length( const Char32* first, const Char32* last )
+	{
+		BOOST_STATIC_ASSERT( sizeof( Char32 ) == 4 );
+		size_t length;
+		if( detail::utf::encoded_length( first, last, length ) != last )
+		{
+			detail::utf::throw_invalid_wide();
+		}
+		return length;
+	}
+
+	/**
+	   @brief Converts valid UTF-16 text to UTF-8, out must have room for utf16_to_utf8_length() bytes
+	   @return End of the written bytes
+	*/
+	template<class Char16>
+	inline char* utf16_to_utf8( const Char16* first, const Char16* last, char* out )
+	{
+		BOOST_STATIC_ASSERT( sizeof( Char16 ) == 2 );
+		return detail::utf::encode( first, last, out );
+	}
+
+	/**
+	   @brief Converts valid UTF-32 text to UTF-8, out must have room for utf32_to_utf8_length() bytes
+	   @return End of the written bytes
+	*/
+	template<class Char32>
+	inline char* utf32_to_utf8( const Char32* first, const Char32* last, char* out )
+	{
+		BOOST_STATIC_ASSERT( sizeof( Char32 ) == 4 );
+		return detail::utf::encode( first, last, out );
+	}
+
+	/**
+	   @brief Returns the number of wchar_t of UTF-8 text, wchar_t strings are
+		UTF-16 or UTF-32 depending on the size of wchar_t
+	   @exception std::range_error if the text is not valid UTF-8
+	*/
+	inline size_t utf8_to_wide_length( const char* first, const char* last )
+	{
+		size_t length;
+		if( detail::utf::decoded_length<sizeof( wchar_t )>( first, last, length ) != last )
+		{
+			detail::utf::throw_invalid_utf8();
+		}
+		return length;
+	}
+
+	inline wchar_t* utf8_to_wide( const char* first, const char* last, wchar_t* out )
+	{
+		return detail::utf::decode( first, last, out );
+	}
+
+	/**
+	   @brief Converts UTF-8 text to the zero terminated wide buffer, allocated once
+	   @exception std::range_error if the text is not valid UTF-8
+	*/
+	inline void utf8_to_wide( const char* first, const char* last, detail::wchar_buffer& out )
+	{
+		const size_t length = utf8_to_wide_length( first, last );
+		out.reallocate( length + 1 );
+		utf8_to_wide( first, last, out.get() );
+	}
+
+	/**
+	   @brief Returns the number of UTF-8 bytes of the wide text
+	   @exception std::range_error if the text is not valid UTF-16/UTF-32
+	*/
+	inline size_t wide_to_utf8_length( const wchar_t* first, const wchar_t* last )
+	{
+		size_t length;
+		if( detail::utf::encoded_length( first, last, length ) != last )
+		{
+			detail::utf::throw_invalid_wide();
+		}
+		return length;
+	}
+
+	inline char* wide_to_utf8( const wchar_t* first, const wchar_t* last, char* out )
+	{
+		return detail::utf::encode( first, last, out );
+	}
+
+	/**
+	   @brief Converts the wide text to the zero terminated UTF-8 buffer, allocated once
+	   @exception std::range_error if the text is not valid UTF-16/UTF-32
+	*/
+	inline void wide_to_utf8( const wchar_t* first, const wchar_t* last, detail::char_buffer& out )
+	{
+		const size_t length = wide_to_utf8_length( first, last );
+		out.reallocate( length + 1 );
+		wide_to_utf8( first, last, out.get() );
+	}
+}
+
+#endif //GSTL_UTF8_HEADER
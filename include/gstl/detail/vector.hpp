@@ -35,8 +35,17 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 #include <gstl/detail/container_helpers.hpp>
 #include <gstl/detail/dynamic_buffer.hpp>
 #include <gstl/detail/fill_iterator.hpp>
+#include <gstl/detail/construct_args.hpp>
 #include <boost/utility/enable_if.hpp>
 #include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_constructor.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/move/move.hpp>
 
 namespace gstl
 {
@@ -45,14 +54,15 @@ namespace gstl
 	template
 		<
 			class T,
-			class Alloc = allocator<T>
+			class Alloc = allocator<T>,
+			class GrowthPolicy = default_growth_policy
 		>
 	class vector
-		:public detail::dynamic_buffer<T, Alloc, detail::default_sequence_traits<T> >
+		:public detail::dynamic_buffer<T, Alloc, detail::default_sequence_traits<T>, GrowthPolicy>
 	{
 	public:
 		typedef detail::dynamic_buffer<T, Alloc,
-			detail::default_sequence_traits<T> >	base_type;
+			detail::default_sequence_traits<T>, GrowthPolicy >	base_type;
 		typedef base_type							internal_buffer_type;
 
 		// types:
@@ -102,7 +112,17 @@ namespace gstl
 		vector( const self_type& x )
 			:base_type( x.get_allocator() )
 		{
-			*this = x;
+			assign( x.begin(), x.end() );
+		}
+
+		/**
+		   @brief Move constructor, takes ownership of the x buffer
+		   @details x is left empty, no items are copied or moved
+		*/
+		vector( BOOST_RV_REF( self_type ) x )
+			:base_type( x.get_allocator() )
+		{
+			base_type::swap( x );
 		}
 
 		~vector()
@@ -110,12 +130,22 @@ namespace gstl
 			_destroy( begin(), end() );
 		}
 
-		self_type& operator=( const self_type& x )
+		self_type& operator=( BOOST_COPY_ASSIGN_REF( self_type ) x )
 		{
 			assign( x.begin(), x.end() );
 			return *this;
 		}
 
+		self_type& operator=( BOOST_RV_REF( self_type ) x )
+		{
+			if( this != &x )
+			{
+				clear();
+				base_type::swap( x );
+			}
+			return *this;
+		}
+
 		template <class InputIterator>
 		void assign( InputIterator first, InputIterator last )
 		{
@@ -184,6 +214,80 @@ namespace gstl
 			detail::container::resize( this, sz, c );
 		}
 
+		/**
+		   @brief Resizes the vector without initialization of the new items
+		   @details Useful when the vector is a landing buffer for read() and the
+			new items are overwritten anyway. Allowed only for trivially default
+			constructible types.
+		*/
+		void resize_default_init( size_type sz )
+		{
+			if( sz > size() )
+			{
+				append_uninitialized( sz - size() );
+			}
+			else
+			{
+				erase( begin() + sz, end() );
+			}
+		}
+
+		/**
+		   @brief Appends n items without initialization
+		   @details Allowed only for trivially default constructible types.
+		   @exception std::length_error if the new size exceeds max_size()
+		   @return pointer to the first appended item
+		*/
+		value_type* append_uninitialized( size_type n )
+		{
+			BOOST_STATIC_ASSERT( boost::has_trivial_default_constructor<value_type>::value );
+
+			size_type old_size = size();
+			if( n >= max_size() - old_size )
+			{
+				base_type::throw_length_error();
+			}
+			base_type::reserve( old_size + n );
+			set_size( old_size + n );
+			return get_buffer() + old_size;
+		}
+
+		/**
+		   @brief Appends the range to the end of the vector
+		   @details Storage for forward ranges is reserved once, input ranges
+			are appended item by item without buffering.
+		*/
+		template <class InputIterator>
+		void append( InputIterator first, InputIterator last )
+		{
+			_do_append( first, last, GSTL_ITER_CAT( InputIterator ) );
+		}
+
+		/**
+		   @brief Lets producer construct up to n items right in the tail storage
+		   @details producer is called once as producer( value_type* dst, size_type n )
+			and must construct items in [dst, dst + count) and return count,
+			count must not exceed n. If producer throws it must destroy items it
+			has constructed, the vector keeps its old size then.
+		   @exception std::length_error if size() + n exceeds max_size()
+		   @return number of appended items
+		*/
+		template <class Producer>
+		size_type append_with( size_type n, Producer producer )
+		{
+			size_type old_size = size();
+			if( n >= max_size() - old_size )
+			{
+				base_type::throw_length_error();
+			}
+			base_type::reserve( old_size + n );
+
+			size_type produced = producer( get_buffer() + old_size, n );
+			GSTL_ASSERT( produced <= n && "producer has written past the requested count" );
+			set_size( old_size + produced );
+			return produced;
+		}
+
 		// element access:
 		using base_type::operator[];
 		using base_type::at;
@@ -210,9 +314,30 @@ namespace gstl
 		
 		void push_back( const value_type& x )
 		{
-			detail::container::push_back( this, x );
+			_emplace_back( detail::make_construct_args( x ) );
 		}
 
+		void push_back( BOOST_RV_REF( value_type ) x )
+		{
+			_emplace_back( detail::make_construct_args( ::boost::move( x ) ) );
+		}
+
+		//emplace_back( args... ), emplace( position, args... )
+#define BOOST_PP_LOCAL_MACRO( n )\
+		GSTL_PP_TEMPLATE_HEAD( n )\
+		void emplace_back( GSTL_PP_FWD_PARAMS( n ) )\
+		{\
+			_emplace_back( GSTL_PP_CONSTRUCT_ARGS( n ) );\
+		}\
+		\
+		GSTL_PP_TEMPLATE_HEAD( n )\
+		iterator emplace( iterator position BOOST_PP_COMMA_IF( n ) GSTL_PP_FWD_PARAMS( n ) )\
+		{\
+			return _emplace( position, GSTL_PP_CONSTRUCT_ARGS( n ) );\
+		}
+#define BOOST_PP_LOCAL_LIMITS ( 0, GSTL_MAX_CONSTRUCT_ARGS )
+#include BOOST_PP_LOCAL_ITERATE()
+
 		void pop_back()
 		{
 			detail::container::pop_back( this );
@@ -220,11 +345,31 @@ namespace gstl
 
 		iterator insert( iterator position, const value_type& x )
 		{
+			if( _is_own_item( &x ) )
+			{
+				//x would be shifted along with the suffix
+				value_type tmp( x );
+				return insert( position, ::boost::move( tmp ) );
+			}
 			return _do_insert( position, &x, &x + 1, random_access_iterator_tag() );
 		}
 
+		iterator insert( iterator position, BOOST_RV_REF( value_type ) x )
+		{
+			value_type& item = x;
+			return _do_insert( position, ::boost::make_move_iterator( &item ),
+				::boost::make_move_iterator( &item + 1 ), random_access_iterator_tag() );
+		}
+
 		void insert( iterator position, size_type n, const value_type& x )
 		{
+			if( _is_own_item( &x ) )
+			{
+				//x would be shifted along with the suffix
+				value_type tmp( x );
+				insert( position, n, tmp );
+				return;
+			}
 			typedef fill_iterator_ref<const value_type>  fill_iter;
 			insert( position,  fill_iter( x ),  fill_iter( x, n ) );
 		}
@@ -247,7 +392,7 @@ namespace gstl
 			if( first != last )
 			{
 				size_type tail_length = end() - last;
-				detail::move( &*first, &*last, tail_length );
+				detail::move_forward( &*first, &*last, tail_length );
 				_destroy( first + tail_length, end() );
 				set_size( size() - (last - first) );
 			}
@@ -265,6 +410,118 @@ namespace gstl
 		}
 
 	private:
+		BOOST_COPYABLE_AND_MOVABLE( vector )
+
+		template<class ConstructArgs>
+		void _emplace_back( const ConstructArgs& args )
+		{
+			size_type new_size = size() + 1;
+			if( base_type::try_expand( new_size ) )
+			{
+				args.construct( get_buffer() + size() );
+			}
+			else if( base_type::can_reallocate::value && size() )
+			{
+				//Args can refer to the items of this vector, so the new item is constructed aside.
+				//It is bitwise relocatable, so it is copied by memcpy and never destroyed
+				typedef boost::aligned_storage< sizeof( value_type ),
+					boost::alignment_of<value_type>::value > storage_type;
+				storage_type storage;
+				value_type* tmp = static_cast<value_type*>( storage.address() );
+				args.construct( tmp );
+				if( base_type::try_reallocate( base_type::grown_capacity( new_size ) ) )
+				{
+					detail::relocate( get_buffer() + size(), tmp, 1 );
+				}
+				else
+				{
+					_reallocate_back( detail::make_construct_args( *tmp ) );
+				}
+			}
+			else
+			{
+				_reallocate_back( args );
+			}
+			set_size( new_size );
+		}
+
+		//Constructs the item past the end in the new buffer and moves the items there
+		template<class ConstructArgs>
+		void _reallocate_back( const ConstructArgs& args )
+		{
+			internal_buffer_type tmp_buff( get_allocator() );
+			tmp_buff.reserve( base_type::grown_capacity( size() + 1 ) );
+
+			value_type* tmp_begin = tmp_buff.get_buffer();
+			//Construct the new item first, args can refer to the items of this vector
+			args.construct( tmp_begin + size() );
+			if( size() )
+			{
+				try
+				{
+					detail::relocate( tmp_begin, get_buffer(), size() );
+				}
+				catch(...)
+				{
+					(tmp_begin + size())->~value_type();
+					throw;
+				}
+			}
+			base_type::swap( tmp_buff );
+		}
+
+		template<class ConstructArgs>
+		iterator _emplace( iterator position, const ConstructArgs& args )
+		{
+			size_type pos = position - begin();
+			if( position == end() )
+			{
+				_emplace_back( args );
+			}
+			else
+			{
+				//Args can refer to the items of this vector, so the new item is constructed aside
+				typedef boost::aligned_storage< sizeof( value_type ),
+					boost::alignment_of<value_type>::value > storage_type;
+				storage_type storage;
+				value_type* tmp = static_cast<value_type*>( storage.address() );
+				args.construct( tmp );
+				try
+				{
+					insert( position, ::boost::move( *tmp ) );
+				}
+				catch(...)
+				{
+					tmp->~value_type();
+					throw;
+				}
+				tmp->~value_type();
+			}
+			return begin() + pos;
+		}
+
+		template <class InputIterator>
+		void _do_append( InputIterator n, InputIterator x, integral_iterator_tag )
+		{
+			insert( end(), static_cast<size_type>( n ), static_cast<const value_type&>( x ) );
+		}
+
+		template <class InputIterator>
+		void _do_append( InputIterator first, InputIterator last, input_iterator_tag )
+		{
+			for( ; first != last; ++first )
+			{
+				_emplace_back( detail::make_construct_args( *first ) );
+			}
+		}
+
+		template <class FwdIterator>
+		void _do_append( FwdIterator first, FwdIterator last, forward_iterator_tag )
+		{
+			//Reserves once, the range is copied before the old buffer is released
+			_do_insert( end(), first, last, forward_iterator_tag() );
+		}
+
 		template <class InputIterator>
 		void _do_insert( iterator position,
 			InputIterator n, InputIterator x, integral_iterator_tag )
@@ -276,14 +533,16 @@ namespace gstl
 		iterator _do_insert( iterator position,
 			InputIterator first, InputIterator last, input_iterator_tag )
 		{
-			size_type pos = position - begin();
-			while( first != last )
+			//Items count is unknown until the range is read, so the items are buffered
+			//and moved into the gap. The buffer uses the default allocator,
+			//file_allocator has only one block
+			gstl::vector<value_type> items;
+			for( ; first != last; ++first )
 			{
-				insert( position, *first );
-				++first;
-				++position;
+				items.push_back( *first );
 			}
-			return iterator( begin() + pos );
+			return _do_insert( position, ::boost::make_move_iterator( items.begin() ),
+				::boost::make_move_iterator( items.end() ), random_access_iterator_tag() );
 		}
 
 		template <class FwdIterator>
@@ -295,29 +554,48 @@ namespace gstl
 			size_type new_size = static_cast<size_type>(size() + new_items_count);
 
 			iterator result_pos = position;
-			if( new_size > capacity() )
+			if( !new_items_count )
+			{
+				return result_pos;
+			}
+			if( !base_type::try_expand( new_size ) )
 			{
-				internal_buffer_type tmp_buff;
+				internal_buffer_type tmp_buff( get_allocator() );
 
 				//calculate reservation size here as we are reserving the TEMP buffer
-				size_type new_reserved = capacity() + capacity()/2;
-				tmp_buff.reserve( (gstl::max)(new_size, new_reserved) );
+				tmp_buff.reserve( base_type::grown_capacity( new_size ) );
 
 				value_type* tmp_begin = tmp_buff.get_buffer();
+				size_type prefix_length = position - begin();
+				size_type suffix_length = end() - position;
 
-				value_type* tmp_pos = tmp_begin;
+				//Copy new items first, the source range can refer to the items of this vector
+				value_type* new_begin = tmp_begin + prefix_length;
+				value_type* new_end = gstl::uninitialized_copy( first, last, new_begin );
 				try
 				{
-					//Copy prefix
-					tmp_pos = gstl::uninitialized_copy( begin(), position, tmp_pos );
-					//Copy new
-					tmp_pos = gstl::uninitialized_copy( first, last, tmp_pos );
-					//Copy suffix
-					tmp_pos = gstl::uninitialized_copy( position, end(), tmp_pos );
+					//Move prefix
+					if( prefix_length )
+					{
+						detail::uninitialized_move( tmp_begin, get_buffer(), prefix_length );
+					}
+					try
+					{
+						//Move suffix
+						if( suffix_length )
+						{
+							detail::uninitialized_move( new_end, get_buffer() + prefix_length, suffix_length );
+						}
+					}
+					catch(...)
+					{
+						_destroy( tmp_begin, new_begin );
+						throw;
+					}
 				}
 				catch(...)
 				{
-					_destroy( tmp_begin, tmp_pos );
+					_destroy( new_begin, new_end );
 					throw;
 				}
 				_destroy( begin(), end() );
@@ -325,26 +603,112 @@ namespace gstl
 					tmp_begin + gstl::distance( begin(), position ), this );
 				
 				base_type::swap( tmp_buff );
+				set_size( new_size );
 			}
 			else
 			{
-				//Buffer size is enough to hold new items
-				iterator vec_end = end();
-				//Insert them past the end of existent items
-				iterator new_end = gstl::uninitialized_copy( first, last, vec_end );
-				
-				if( vec_end != position )
+				//Buffer size is enough to hold new items,
+				//shift the suffix once and put new items into the gap
+				size_type count = static_cast<size_type>( new_items_count );
+				value_type* pos_ptr = get_buffer() + ( position - begin() );
+				value_type* old_end = get_buffer() + size();
+				size_type elems_after = old_end - pos_ptr;
+				//The source range can refer to the items of this vector
+				const value_type* own_items = _own_items( first, last );
+
+				if( elems_after > count )
+				{
+					//The last count items go to the uninitialized memory,
+					//the rest of the suffix is shifted over constructed items
+					detail::uninitialized_move( old_end, old_end - count, count );
+					set_size( new_size );
+					detail::move_backward( pos_ptr + count, pos_ptr, elems_after - count );
+					if( own_items )
+					{
+						_assign_shifted( pos_ptr, own_items, count, count );
+					}
+					else
+					{
+						gstl::copy( first, last, pos_ptr );
+					}
+				}
+				else
 				{
-					//put new items on their position
-					gstl::reverse( position, vec_end );
-					gstl::reverse( vec_end, new_end );
-					gstl::reverse( position, new_end );
+					//New items past the suffix are constructed,
+					//the whole suffix goes to the uninitialized memory
+					FwdIterator mid = first;
+					gstl::advance( mid, elems_after );
+					value_type* new_end = gstl::uninitialized_copy( mid, last, old_end );
+					if( elems_after )
+					{
+						try
+						{
+							detail::uninitialized_move( new_end, pos_ptr, elems_after );
+						}
+						catch(...)
+						{
+							_destroy( old_end, new_end );
+							throw;
+						}
+					}
+					set_size( new_size );
+					if( own_items )
+					{
+						_assign_shifted( pos_ptr, own_items, elems_after, count );
+					}
+					else
+					{
+						gstl::copy( first, mid, pos_ptr );
+					}
 				}
 			}
-			set_size( new_size );
 			return result_pos;
 		}
 
+		bool _is_own_item( const value_type* item ) const
+		{
+			return item >= get_buffer() && item < get_buffer() + size();
+		}
+
+		/**
+		   @brief Returns the first item of the range, if the range is a part of this vector, 0 otherwise
+		*/
+		template <class FwdIterator>
+		const value_type* _own_items( FwdIterator first, FwdIterator last ) const
+		{
+			typedef ::boost::mpl::or_<
+				::boost::is_convertible<FwdIterator, const_iterator>,
+				::boost::is_convertible<FwdIterator, const value_type*> > may_refer;
+			return first != last ? _own_items( first, ::boost::mpl::bool_<may_refer::value>() ) : 0;
+		}
+
+		template <class FwdIterator>
+		const value_type* _own_items( FwdIterator, ::boost::mpl::false_ ) const
+		{
+			return 0;
+		}
+
+		template <class FwdIterator>
+		const value_type* _own_items( FwdIterator first, ::boost::mpl::true_ ) const
+		{
+			const value_type* item = &*first;
+			return _is_own_item( item ) ? item : 0;
+		}
+
+		/**
+		   @brief Assigns n own items, which started at src, to the gap at dst
+		   @details Items at dst and after it have been shifted by shift positions along with the suffix.
+		*/
+		void _assign_shifted( value_type* dst, const value_type* src, size_type n, size_type shift )
+		{
+			const value_type* gap = dst;
+			for( size_type i = 0; i < n; ++i )
+			{
+				const value_type* item = src + i;
+				dst[i] = item < gap ? *item : item[shift];
+			}
+		}
+
 		void _destroy( iterator first, iterator last )
 		{
 			_destroy( pointer(&*first), pointer(&*last) );
@@ -370,52 +734,52 @@ namespace gstl
 
 
 
-	template<class value_type, class allocator>
-	bool operator==( const vector<value_type, allocator>& lhs,
-		const vector<value_type, allocator>& rhs )
+	template<class value_type, class allocator, class growth_policy>
+	bool operator==( const vector<value_type, allocator, growth_policy>& lhs,
+		const vector<value_type, allocator, growth_policy>& rhs )
 	{
 		return ( lhs.size() == rhs.size() ) && gstl::equal( lhs.begin(), lhs.end(), rhs.begin() );
 	}
 
-	template<class value_type, class allocator>
-	bool operator< (const vector<value_type, allocator>& lhs,
-		const vector<value_type, allocator>& rhs )
+	template<class value_type, class allocator, class growth_policy>
+	bool operator< (const vector<value_type, allocator, growth_policy>& lhs,
+		const vector<value_type, allocator, growth_policy>& rhs )
 	{
 		return gstl::lexicographical_compare( lhs.begin(), lhs.end(),
 				rhs.begin(), rhs.end());
 	}
 
-	template<class value_type, class allocator>
-	bool operator!=( const vector<value_type, allocator>& lhs,
-		const vector<value_type, allocator>& rhs )
+	template<class value_type, class allocator, class growth_policy>
+	bool operator!=( const vector<value_type, allocator, growth_policy>& lhs,
+		const vector<value_type, allocator, growth_policy>& rhs )
 	{
 		return rel_ops::operator !=( lhs, rhs );
 	}
 
-	template<class value_type, class allocator>
-	bool operator>( const vector<value_type, allocator>& lhs,
-		const vector<value_type, allocator>& rhs )
+	template<class value_type, class allocator, class growth_policy>
+	bool operator>( const vector<value_type, allocator, growth_policy>& lhs,
+		const vector<value_type, allocator, growth_policy>& rhs )
 	{
 		return rel_ops::operator >( lhs, rhs );
 	}
 
-	template<class value_type, class allocator>
-	bool operator>=( const vector<value_type, allocator>& lhs,
-		const vector<value_type, allocator>& rhs )
+	template<class value_type, class allocator, class growth_policy>
+	bool operator>=( const vector<value_type, allocator, growth_policy>& lhs,
+		const vector<value_type, allocator, growth_policy>& rhs )
 	{
 		return rel_ops::operator >=( lhs, rhs );
 	}
 
-	template<class value_type, class allocator>
-	bool operator<=( const vector<value_type, allocator>& lhs,
-		const vector<value_type, allocator>& rhs )
+	template<class value_type, class allocator, class growth_policy>
+	bool operator<=( const vector<value_type, allocator, growth_policy>& lhs,
+		const vector<value_type, allocator, growth_policy>& rhs )
 	{
 		return rel_ops::operator <=( lhs, rhs );
 	}
 
-	template<class value_type, class allocator>
-	void swap( vector<value_type, allocator>& lhs,
-		vector<value_type, allocator>& rhs )
+	template<class value_type, class allocator, class growth_policy>
+	void swap( vector<value_type, allocator, growth_policy>& lhs,
+		vector<value_type, allocator, growth_policy>& rhs )
 	{
 		lhs.swap( rhs );
 	}
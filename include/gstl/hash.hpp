@@ -29,14 +29,81 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 #endif
 
 
-namespace boost
+#include <cstddef>
+#include <functional>
+#include <gstl/string>
+#include <gstl/detail/hash_bytes.hpp>
+
+#include <gstl/detail/boost_warnings_off.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <gstl/detail/boost_warnings_on.hpp>
+
+namespace gstl
 {
-	template<class char_type, class traits, class allocator_type>
-	inline std::size_t hash_value(gstl::basic_string<char_type,traits,allocator_type> v)
+	namespace detail
+	{
+		template<class CharT, class Traits>
+		inline std::size_t hash_chars( const CharT* s, std::size_t n, boost::mpl::true_ )
+		{
+			return static_cast<std::size_t>( hash_bytes( s, n * sizeof( CharT ) ) );
+		}
+
+		template<class CharT, class Traits>
+		inline std::size_t hash_chars( const CharT* s, std::size_t n, boost::mpl::false_ )
+		{
+			return boost::hash_range( s, s + n );
+		}
+
+		/**
+		   @brief Hashes the characters of the string
+		   @details Integral characters compared by gstl::char_traits are equal only if
+			their bytes are equal, so they are hashed as bytes, a word at a time.
+			Other traits may treat different characters as equal, those strings are hashed
+			character by character.
+		*/
+		template<class CharT, class Traits>
+		inline std::size_t hash_chars( const CharT* s, std::size_t n )
+		{
+			typedef boost::mpl::and_< boost::is_integral<CharT>,
+				boost::is_same< Traits, gstl::char_traits<CharT> > > is_bytes;
+			return hash_chars<CharT, Traits>( s, n, is_bytes() );
+		}
+	}
+
+	/**
+	   @brief Hash of the string, found by boost::hash through ADL
+	*/
+	template<class char_type, class traits, class allocator_type, class growth_policy>
+	inline std::size_t hash_value(const basic_string<char_type,traits,allocator_type,growth_policy>& v)
+	{
+		return detail::hash_chars<char_type, traits>( v.data(), v.size() );
+	}
+
+	template<class char_type, class traits>
+	inline std::size_t hash_value(basic_string_view<char_type,traits> v)
 	{
-		return hash_range(v.begin(), v.end());
+		return detail::hash_chars<char_type, traits>( v.data(), v.size() );
 	}
+
+	/**
+	   @brief Hash function object, which can be used with any unordered container
+	   @details Forwards to boost::hash, which finds hash_value overloads for the gstl types.
+		Strings and views of the same characters have the same hash.
+	*/
+	template<class T>
+	struct hash
+		:public std::unary_function<T, std::size_t>
+	{
+		std::size_t operator()( const T& v ) const
+		{
+			return boost::hash<T>()( v );
+		}
+	};
 }
 
+#include <gstl/detail/hashed_string.hpp>
 
-#endif GSTL_HASH_HEADER
\ No newline at end of file
+#endif //GSTL_HASH_HEADER
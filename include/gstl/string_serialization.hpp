@@ -31,54 +31,117 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 
 #include <gstl/string>
 
+#include <cstddef>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/remove_const.hpp>
 #include <boost/serialization/string.hpp>
-//#include <boost/serialization/array.hpp>
+#include <boost/serialization/split_free.hpp>
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/array_optimization.hpp>
+#include <boost/serialization/level.hpp>
 #include <boost/serialization/tracking.hpp>
 
 namespace boost
 {
 	namespace serialization
 	{ 
-		template<class Archive, class CharT, class Traits, class Alloc>
+		namespace gstl_detail
+		{
+			template<class Archive, class CharT, class Traits, class Alloc, class GrowthPolicy>
+			inline void save( Archive& ar, const gstl::basic_string<CharT, Alloc, Traits, GrowthPolicy>& str,
+				::boost::mpl::true_ /*use_array_optimization*/ )
+			{
+				const std::size_t length = static_cast<std::size_t>( str.length() );
+				ar << BOOST_SERIALIZATION_NVP( length );
+				if( length != 0 )
+				{
+					ar << make_array( str.data(), length );
+				}
+			}
+
+			template<class Archive, class CharT, class Traits, class Alloc, class GrowthPolicy>
+			inline void save( Archive& ar, const gstl::basic_string<CharT, Alloc, Traits, GrowthPolicy>& str,
+				::boost::mpl::false_ /*use_array_optimization*/ )
+			{
+				typedef std::basic_string<CharT> StdStringType;
+				typedef typename StdStringType::size_type size_type;
+				StdStringType chars( str.c_str(), static_cast<size_type>( str.length() ) );
+				ar & /*BOOST_SERIALIZATION_NVP*/( chars );
+			}
+
+			template<class Archive, class CharT, class Traits, class Alloc, class GrowthPolicy>
+			inline void load( Archive& ar, gstl::basic_string<CharT, Alloc, Traits, GrowthPolicy>& str,
+				::boost::mpl::true_ /*use_array_optimization*/ )
+			{
+				std::size_t length = 0;
+				ar >> BOOST_SERIALIZATION_NVP( length );
+				str.resize_default_init( length );
+				if( length != 0 )
+				{
+					ar >> make_array( &str[0], length );
+				}
+			}
+
+			template<class Archive, class CharT, class Traits, class Alloc, class GrowthPolicy>
+			inline void load( Archive& ar, gstl::basic_string<CharT, Alloc, Traits, GrowthPolicy>& str,
+				::boost::mpl::false_ /*use_array_optimization*/ )
+			{
+				typedef std::basic_string<CharT> StdStringType;
+				StdStringType chars;
+				ar & /*BOOST_SERIALIZATION_NVP*/( chars );
+				str.assign( chars.c_str(), chars.length() );
+			}
+		}
+
+		/**
+		   @brief Saves the string in the format of std::basic_string
+		   @details Archives with use_array_optimization (binary ones) get the std::size_t length
+			and the characters straight from the string buffer in one save_binary call.
+			Other archives get the string through a temporary std::basic_string as before.
+		*/
+		template<class Archive, class CharT, class Traits, class Alloc, class GrowthPolicy>
 		inline void save(
 			Archive& ar,
-			const gstl::basic_string<CharT, Alloc, Traits>& str,
-			const unsigned int version
+			const gstl::basic_string<CharT, Alloc, Traits, GrowthPolicy>& str,
+			const unsigned int /*version*/
 			)
 		{
-			typedef std::basic_string<CharT> StdStringType;
-			typedef StdStringType::size_type size_type;
-			StdStringType chars( str.c_str(), static_cast<size_type>( str.length() ) );
-			ar & /*BOOST_SERIALIZATION_NVP*/( chars );
+			typedef typename use_array_optimization<Archive>::template apply<
+				typename ::boost::remove_const<CharT>::type >::type use_optimized;
+			gstl_detail::save( ar, str, use_optimized() );
 		}
 
-		template<class Archive, class CharT, class Traits, class Alloc>
+		/**
+		   @brief Loads the string saved by save()
+		   @details With use_array_optimization the string is sized once and the characters
+			are read straight into its buffer.
+		*/
+		template<class Archive, class CharT, class Traits, class Alloc, class GrowthPolicy>
 		inline void load(
 			Archive& ar,
-			gstl::basic_string<CharT, Alloc, Traits>& str,
-			const unsigned int version
+			gstl::basic_string<CharT, Alloc, Traits, GrowthPolicy>& str,
+			const unsigned int /*version*/
 			)
 		{
-			typedef std::basic_string<CharT> StdStringType;
-			StdStringType chars;
-			ar & /*BOOST_SERIALIZATION_NVP*/( chars );
-			str.assign( chars.c_str(), chars.length() );
+			typedef typename use_array_optimization<Archive>::template apply<
+				typename ::boost::remove_const<CharT>::type >::type use_optimized;
+			gstl_detail::load( ar, str, use_optimized() );
 		}
 
 		// split non-intrusive serialization function member into separate
 		// non intrusive save/load member functions
-		template<class Archive, class CharT, class Traits, class Alloc>
+		template<class Archive, class CharT, class Traits, class Alloc, class GrowthPolicy>
 		inline void serialize(
 			Archive & ar,
-			gstl::basic_string<CharT, Alloc, Traits> & str,
+			gstl::basic_string<CharT, Alloc, Traits, GrowthPolicy> & str,
 			const unsigned int version
 			)
 		{
 			boost::serialization::split_free(ar, str, version);
 		}
 
-		template <class CharT, class Traits, class Alloc>                                     
-		struct implementation_level_impl< const gstl::basic_string<CharT, Alloc, Traits> >  
+		template <class CharT, class Traits, class Alloc, class GrowthPolicy>                                     
+		struct implementation_level_impl< const gstl::basic_string<CharT, Alloc, Traits, GrowthPolicy> >  
 		{
 			typedef mpl::integral_c_tag tag;
 			typedef mpl::int_< boost::serialization::object_serializable > type;
@@ -88,8 +151,8 @@ namespace boost
 				);
 		};
 
-		template <class CharT, class Traits, class Alloc> 
-		struct tracking_level< const gstl::basic_string<CharT, Alloc, Traits> >  
+		template <class CharT, class Traits, class Alloc, class GrowthPolicy> 
+		struct tracking_level< const gstl::basic_string<CharT, Alloc, Traits, GrowthPolicy> >  
 		{
 			typedef mpl::integral_c_tag tag;
 			typedef mpl::int_<boost::serialization::track_never> type;
@@ -0,0 +1,205 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#	pragma once
+#endif
+
+#ifndef GSTL_VECTOR_SERIALIZATION_HEADER
+#define GSTL_VECTOR_SERIALIZATION_HEADER
+
+
+#include <gstl/vector>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/int.hpp>
+#include <boost/mpl/integral_c_tag.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/serialization/split_free.hpp>
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/array_optimization.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/level.hpp>
+#include <boost/serialization/version.hpp>
+#include <boost/serialization/collection_size_type.hpp>
+#include <boost/serialization/item_version_type.hpp>
+#include <boost/serialization/library_version_type.hpp>
+
+namespace boost
+{
+	namespace serialization
+	{
+		namespace gstl_detail
+		{
+			/**
+			   @brief Producer for vector::append_with, reads items straight into the vector buffer
+			*/
+			template<class Archive, class T>
+			struct array_reader
+			{
+				explicit array_reader( Archive& ar )
+					:ar_( ar )
+				{}
+
+				std::size_t operator()( T* dst, std::size_t n ) const
+				{
+					ar_ >> make_array( dst, n );
+					return n;
+				}
+
+			private:
+				Archive& ar_;
+			};
+
+			template<class Archive, class T, class Alloc, class GrowthPolicy>
+			inline void save( Archive& ar, const gstl::vector<T, Alloc, GrowthPolicy>& vec,
+				::boost::mpl::true_ /*use_array_optimization*/ )
+			{
+				const collection_size_type count( vec.size() );
+				ar << BOOST_SERIALIZATION_NVP( count );
+				if( !vec.empty() )
+				{
+					ar << make_array( &vec[0], vec.size() );
+				}
+			}
+
+			template<class Archive, class T, class Alloc, class GrowthPolicy>
+			inline void save( Archive& ar, const gstl::vector<T, Alloc, GrowthPolicy>& vec,
+				::boost::mpl::false_ /*use_array_optimization*/ )
+			{
+				const collection_size_type count( vec.size() );
+				const item_version_type item_version( version<T>::value );
+				ar << BOOST_SERIALIZATION_NVP( count );
+				ar << BOOST_SERIALIZATION_NVP( item_version );
+				for( std::size_t i = 0; i < vec.size(); ++i )
+				{
+					ar << make_nvp( "item", vec[i] );
+				}
+			}
+
+			template<class Archive, class T, class Alloc, class GrowthPolicy>
+			inline void load( Archive& ar, gstl::vector<T, Alloc, GrowthPolicy>& vec,
+				::boost::mpl::true_ /*use_array_optimization*/ )
+			{
+				collection_size_type count( 0 );
+				ar >> BOOST_SERIALIZATION_NVP( count );
+				//Archives of library versions 4 and 5 wrote the item version here
+				const library_version_type library_version( ar.get_library_version() );
+				if( library_version == library_version_type( 4 ) || library_version == library_version_type( 5 ) )
+				{
+					item_version_type item_version( 0 );
+					ar >> BOOST_SERIALIZATION_NVP( item_version );
+				}
+				vec.clear();
+				if( count != 0 )
+				{
+					vec.append_with( static_cast<std::size_t>( count ), array_reader<Archive, T>( ar ) );
+				}
+			}
+
+			template<class Archive, class T, class Alloc, class GrowthPolicy>
+			inline void load( Archive& ar, gstl::vector<T, Alloc, GrowthPolicy>& vec,
+				::boost::mpl::false_ /*use_array_optimization*/ )
+			{
+				collection_size_type count( 0 );
+				item_version_type item_version( 0 );
+				ar >> BOOST_SERIALIZATION_NVP( count );
+				if( library_version_type( 3 ) < ar.get_library_version() )
+				{
+					ar >> BOOST_SERIALIZATION_NVP( item_version );
+				}
+				vec.clear();
+				vec.resize( static_cast<std::size_t>( count ) );
+				for( std::size_t i = 0; i < vec.size(); ++i )
+				{
+					ar >> make_nvp( "item", vec[i] );
+				}
+			}
+		}
+
+		/**
+		   @brief Saves the item count and the items in the format of std::vector
+		   @details Archives with use_array_optimization (binary ones) get the items as one array,
+			which is written with one save_binary call. Other archives get the item version
+			and the items one by one, as boost does for std::vector.
+		*/
+		template<class Archive, class T, class Alloc, class GrowthPolicy>
+		inline void save(
+			Archive& ar,
+			const gstl::vector<T, Alloc, GrowthPolicy>& vec,
+			const unsigned int /*version*/
+			)
+		{
+			typedef typename use_array_optimization<Archive>::template apply<
+				typename ::boost::remove_const<T>::type >::type use_optimized;
+			gstl_detail::save( ar, vec, use_optimized() );
+		}
+
+		/**
+		   @brief Loads the vector saved by save() or the std::vector one
+		   @details With use_array_optimization the items are read straight into the reserved buffer.
+		*/
+		template<class Archive, class T, class Alloc, class GrowthPolicy>
+		inline void load(
+			Archive& ar,
+			gstl::vector<T, Alloc, GrowthPolicy>& vec,
+			const unsigned int /*version*/
+			)
+		{
+			typedef typename use_array_optimization<Archive>::template apply<
+				typename ::boost::remove_const<T>::type >::type use_optimized;
+			gstl_detail::load( ar, vec, use_optimized() );
+		}
+
+		template<class Archive, class T, class Alloc, class GrowthPolicy>
+		inline void serialize(
+			Archive & ar,
+			gstl::vector<T, Alloc, GrowthPolicy> & vec,
+			const unsigned int version
+			)
+		{
+			boost::serialization::split_free( ar, vec, version );
+		}
+
+		/**
+		   @brief Vectors of arithmetic types are written without the class information,
+			as boost does for std::vector of primitive types
+		*/
+		template<class T, class Alloc, class GrowthPolicy>
+		struct implementation_level_impl< const gstl::vector<T, Alloc, GrowthPolicy> >
+		{
+			typedef mpl::integral_c_tag tag;
+			typedef mpl::int_< ::boost::is_arithmetic<T>::value
+				? boost::serialization::object_serializable
+				: boost::serialization::object_class_info > type;
+			BOOST_STATIC_CONSTANT(
+				int,
+				value = implementation_level_impl::type::value
+				);
+		};
+
+	} // serialization
+} // namespace boost
+
+#endif //GSTL_VECTOR_SERIALIZATION_HEADER
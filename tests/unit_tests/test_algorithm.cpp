@@ -24,7 +24,12 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 #include "stdafx.h"
 
 #include <gstl/algorithm>
+#include <gstl/vector>
 #include <vector>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <list>
 
 /**
 	@brief		Wrapper class on advance algorithm
@@ -237,6 +242,190 @@ BOOST_AUTO_TEST_CASE( test_lexicographical_compare )
 	BOOST_CHECK( !gstl::lexicographical_compare( int_vec.begin(), int_vec.end(), less_int_vec.begin(), less_int_vec.end() ) );
 }
 
+BOOST_AUTO_TEST_CASE( test_unwrapped_kernels )
+{
+	typedef gstl::vector<unsigned char> byte_vec;
+
+	const char* text = "generic stl";
+	byte_vec src( text, text + 11 );
+	byte_vec dst( src.size(), 0 );
+
+	//copy returns an iterator into the destination container
+	byte_vec::iterator cres = gstl::copy( src.begin(), src.end(), dst.begin() );
+	BOOST_CHECK( cres == dst.end() );
+	BOOST_CHECK( gstl::equal( src.begin(), src.end(), dst.begin() ) );
+
+	//find over bytes, including a value that doesn't fit the item type
+	byte_vec::iterator fres1 = gstl::find( src.begin(), src.end(), 's' );
+	BOOST_CHECK( fres1 == src.begin() + 8 );
+	BOOST_CHECK( gstl::find( src.begin(), src.end(), 's' + 256 ) == src.end() );
+	BOOST_CHECK( gstl::find( src.begin(), src.end(), 'x' ) == src.end() );
+
+	//fill and comparisons
+	gstl::fill( dst.begin() + 7, dst.end(), 'z' );
+	BOOST_CHECK( !gstl::equal( src.begin(), src.end(), dst.begin() ) );
+	BOOST_CHECK( gstl::lexicographical_compare( src.begin(), src.end(), dst.begin(), dst.end() ) );
+	BOOST_CHECK( !gstl::lexicographical_compare( dst.begin(), dst.end(), src.begin(), src.end() ) );
+	BOOST_CHECK( gstl::lexicographical_compare( src.begin(), src.end() - 1, src.begin(), src.end() ) );
+}
+
+namespace
+{
+	bool int_less( int lhs, int rhs )
+	{
+		return lhs < rhs;
+	}
+
+	/**
+	   @brief Sort key and the original position of the element, to check the stability
+	*/
+	struct keyed_int
+	{
+		keyed_int( int k = 0, int p = 0 )
+			:key( k ), position( p )
+		{}
+
+		bool operator==( const keyed_int& rhs ) const
+		{
+			return key == rhs.key && position == rhs.position;
+		}
+
+		int key;
+		int position;
+	};
+
+	bool key_less( const keyed_int& lhs, const keyed_int& rhs )
+	{
+		return lhs.key < rhs.key;
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_sort )
+{
+	//Random, sorted, reversed, organ pipe and many equal elements, the sizes
+	//cover insertion sort, median of 3, ninther and the branchless blocks
+	const int sizes[] = { 0, 1, 2, 23, 24, 100, 129, 1000, 10000 };
+	for( size_t s = 0; s < GSTL_ARRAY_LEN( sizes ); ++s )
+	{
+		const int n = sizes[s];
+		for( int pattern = 0; pattern < 5; ++pattern )
+		{
+			std::vector<int> expected( n );
+			unsigned seed = 12345;
+			for( int i = 0; i < n; ++i )
+			{
+				seed = seed * 1103515245 + 12345;
+				switch( pattern )
+				{
+				case 0: expected[i] = static_cast<int>( seed >> 8 ); break;
+				case 1: expected[i] = i; break;
+				case 2: expected[i] = n - i; break;
+				case 3: expected[i] = i < n / 2 ? i : n - i; break;
+				default: expected[i] = static_cast<int>( ( seed >> 8 ) % 4 ); break;
+				}
+			}
+			gstl::vector<int> v( expected.begin(), expected.end() );
+			std::vector<double> d( expected.begin(), expected.end() );
+			std::sort( expected.begin(), expected.end() );
+
+			gstl::sort( v.begin(), v.end() );
+			BOOST_CHECK( std::equal( v.begin(), v.end(), expected.begin() ) );
+
+			//Not unwrapped iterators and the partition with branches
+			std::vector<int> generic( expected.rbegin(), expected.rend() );
+			gstl::sort( generic.rbegin(), generic.rend(), int_less );
+			BOOST_CHECK( generic == std::vector<int>( expected.rbegin(), expected.rend() ) );
+
+			gstl::sort( d.begin(), d.end(), std::greater<double>() );
+			BOOST_CHECK( std::equal( d.rbegin(), d.rend(), expected.begin() ) );
+		}
+	}
+
+	const char* words[] = { "sort", "generic", "stl", "vector", "algorithm", "string", "a", "generic" };
+	std::vector<std::string> strings( words, words + GSTL_ARRAY_LEN( words ) );
+	gstl::sort( strings.begin(), strings.end() );
+	BOOST_CHECK_EQUAL( strings.front(), "a" );
+	BOOST_CHECK_EQUAL( strings[2], "generic" );
+	BOOST_CHECK_EQUAL( strings.back(), "vector" );
+}
+
+BOOST_AUTO_TEST_CASE( test_stable_sort )
+{
+	//Few keys, so the equal elements are many.
+	//Sizes cover the single insertion sorted run and the run stack merges
+	const int sizes[] = { 0, 1, 2, 63, 64, 65, 1000, 10000 };
+	for( size_t s = 0; s < GSTL_ARRAY_LEN( sizes ); ++s )
+	{
+		const int n = sizes[s];
+		for( int pattern = 0; pattern < 4; ++pattern )
+		{
+			std::vector<keyed_int> expected( n );
+			unsigned seed = 12345;
+			for( int i = 0; i < n; ++i )
+			{
+				seed = seed * 1103515245 + 12345;
+				switch( pattern )
+				{
+				case 0: expected[i].key = static_cast<int>( ( seed >> 8 ) % 16 ); break;
+				case 1: expected[i].key = i / 3; break;
+				case 2: expected[i].key = ( n - i ) / 3; break;
+				default: expected[i].key = i % 100 < 95 ? i : static_cast<int>( ( seed >> 8 ) % n ); break;
+				}
+				expected[i].position = i;
+			}
+			gstl::vector<keyed_int> v( expected.begin(), expected.end() );
+			std::stable_sort( expected.begin(), expected.end(), key_less );
+
+			gstl::stable_sort( v.begin(), v.end(), key_less );
+			BOOST_CHECK( std::equal( v.begin(), v.end(), expected.begin() ) );
+		}
+	}
+
+	const char* words[] = { "sort", "generic", "stl", "vector", "algorithm", "string", "a", "generic" };
+	std::vector<std::string> strings( words, words + GSTL_ARRAY_LEN( words ) );
+	gstl::stable_sort( strings.begin(), strings.end() );
+	BOOST_CHECK_EQUAL( strings.front(), "a" );
+	BOOST_CHECK_EQUAL( strings[2], "generic" );
+	BOOST_CHECK_EQUAL( strings.back(), "vector" );
+}
+
+BOOST_AUTO_TEST_CASE( test_merge )
+{
+	const keyed_int first[] = { keyed_int( 1, 0 ), keyed_int( 2, 1 ), keyed_int( 2, 2 ), keyed_int( 5, 3 ) };
+	const keyed_int second[] = { keyed_int( 0, 4 ), keyed_int( 2, 5 ), keyed_int( 5, 6 ), keyed_int( 7, 7 ) };
+	const int order[] = { 4, 0, 1, 2, 5, 3, 6, 7 };
+
+	std::vector<keyed_int> merged( 8 );
+	BOOST_CHECK( gstl::merge( first, first + 4, second, second + 4, merged.begin(), key_less ) == merged.end() );
+	for( int i = 0; i < 8; ++i )
+	{
+		BOOST_CHECK_EQUAL( merged[i].position, order[i] );
+	}
+
+	gstl::vector<keyed_int> v( first, first + 4 );
+	v.insert( v.end(), second, second + 4 );
+	gstl::inplace_merge( v.begin(), v.begin() + 4, v.end(), key_less );
+	for( int i = 0; i < 8; ++i )
+	{
+		BOOST_CHECK_EQUAL( v[i].position, order[i] );
+	}
+
+	//Bidirectional iterators
+	std::list<int> l;
+	for( int i = 0; i < 10; ++i )
+	{
+		l.push_back( i * 2 + ( i < 5 ? 0 : -9 ) );
+	}
+	std::list<int>::iterator middle = l.begin();
+	std::advance( middle, 5 );
+	gstl::inplace_merge( l.begin(), middle, l.end() );
+	int expected = 0;
+	for( std::list<int>::iterator it = l.begin(); it != l.end(); ++it, ++expected )
+	{
+		BOOST_CHECK_EQUAL( *it, expected );
+	}
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE( test_1, type, t_list )
 {
 
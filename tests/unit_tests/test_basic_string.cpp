@@ -26,6 +26,7 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 #include <gstl/detail/basic_string.hpp>
 #include <gstl/utility>
 #include "managers.hpp"
+#include <ctype.h>
 
 typedef gstl::string gstl_string;
 
@@ -43,6 +44,50 @@ typedef gstl::basic_string<char, gstl::char_traits<char>,
 //template memory_mgr_string;
 //template memory_mgr_off_string;
 
+namespace
+{
+	/**
+	   @brief Case insensitive traits, equal characters have different codes
+	*/
+	struct ci_char_traits
+		:public gstl::char_traits<char>
+	{
+		static bool eq( char lhs, char rhs )
+		{
+			return toupper( static_cast<unsigned char>( lhs ) ) == toupper( static_cast<unsigned char>( rhs ) );
+		}
+
+		static bool lt( char lhs, char rhs )
+		{
+			return toupper( static_cast<unsigned char>( lhs ) ) < toupper( static_cast<unsigned char>( rhs ) );
+		}
+
+		static int compare( const char* s1, const char* s2, size_t n )
+		{
+			for( ; n--; ++s1, ++s2 )
+			{
+				if( !eq( *s1, *s2 ) )
+				{
+					return lt( *s1, *s2 ) ? -1 : 1;
+				}
+			}
+			return 0;
+		}
+
+		static const char* find( const char* s, size_t n, char a )
+		{
+			for( ; n--; ++s )
+			{
+				if( eq( *s, a ) )
+				{
+					return s;
+				}
+			}
+			return 0;
+		}
+	};
+}
+
 class basic_string_test_fixture
 {
 public:
@@ -656,6 +701,17 @@ typedef boost::mpl::list< /**std::string,/**/ gstl_string, memory_mgr_string/**/
 		BOOST_CHECK_THROW( s.erase( s.size() + 1 ), std::out_of_range );
 	}
 
+	BOOST_AUTO_TEST_CASE_TEMPLATE( test_erase_overlapped_tail, string_type, t_list )
+	{
+		//The tail is longer than the erased range, so it is shifted over itself
+		string_type s( "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz" );
+		s.erase( s.begin() + 10, s.begin() + 12 );
+		BOOST_CHECK_EQUAL( s.c_str(), "0123456789cdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz" );
+
+		s.erase( 1, 1 );
+		BOOST_CHECK_EQUAL( s.c_str(), "023456789cdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz" );
+	}
+
 	//21.3.5.6 basic_string::replace
 	BOOST_AUTO_TEST_CASE_TEMPLATE( test_replace, string_type, t_list )
 	{
@@ -723,6 +779,60 @@ typedef boost::mpl::list< /**std::string,/**/ gstl_string, memory_mgr_string/**/
  		BOOST_CHECK_EQUAL( str.c_str(), "Is test string_type for string_type calls" );
 	}
 
+	BOOST_AUTO_TEST_CASE_TEMPLATE( test_replace_self_in_place, string_type, t_list )
+	{
+		string_type s;
+		s.reserve( 64 );
+		const char* buffer = s.data();
+
+		//The source before, inside, after and across the replaced range
+		s = "0123456789";
+		s.replace( 0, 3, s, 5, 3 );
+		BOOST_CHECK_EQUAL( s.c_str(), "5673456789" );
+
+		s = "0123456789";
+		s.replace( 6, 2, s, 1, 4 );
+		BOOST_CHECK_EQUAL( s.c_str(), "012345123489" );
+
+		s = "0123456789";
+		s.replace( 2, 2, s, 3, 5 );
+		BOOST_CHECK_EQUAL( s.c_str(), "0134567456789" );
+
+		s = "0123456789";
+		s.replace( 2, 1, s, 7, 3 );
+		BOOST_CHECK_EQUAL( s.c_str(), "017893456789" );
+
+		s = "0123456789";
+		s.replace( 1, 8, s.c_str() + 3, 2 );
+		BOOST_CHECK_EQUAL( s.c_str(), "0349" );
+
+		s = "0123456789";
+		s.insert( 0, s );
+		BOOST_CHECK_EQUAL( s.c_str(), "01234567890123456789" );
+
+		s.append( s );
+		BOOST_CHECK_EQUAL( s.size(), size_t( 40 ) );
+
+		s = "0123456789";
+		s.assign( s.c_str() + 2, 5 );
+		BOOST_CHECK_EQUAL( s.c_str(), "23456" );
+
+		s.assign( s.begin(), s.end() - 1 );
+		BOOST_CHECK_EQUAL( s.c_str(), "2345" );
+
+		//No reallocations while the capacity is enough
+		BOOST_CHECK( s.data() == buffer );
+
+		//Source stays valid when the string grows
+		s = "0123456789";
+		while( s.size() < 200 )
+		{
+			s.insert( 1, s );
+		}
+		BOOST_CHECK_EQUAL( s.size(), size_t( 320 ) );
+		BOOST_CHECK_EQUAL( s.substr( 0, 12 ).c_str(), "000000123456" );
+	}
+
 	//21.3.5.7 basic_string::copy
 	BOOST_AUTO_TEST_CASE_TEMPLATE( test_copy, string_type, t_list )
 	{
@@ -807,6 +917,55 @@ typedef boost::mpl::list< /**std::string,/**/ gstl_string, memory_mgr_string/**/
 		BOOST_CHECK_EQUAL( test.rfind( 'a', 0 ), sz_null );
 	}
 
+	BOOST_AUTO_TEST_CASE_TEMPLATE( test_find_long_pattern, string_type, t_list )
+	{
+		//Repetitive text, which is long enough for the searcher to be used
+		string_type s( 1000, 'a' );
+		s[100] = 'b';
+		s[700] = 'b';
+		const char pattern[] = "aaaaaaaaaaaab";
+		const size_t pattern_len = GSTL_STR_LEN( pattern );
+
+		BOOST_CHECK_EQUAL( s.find( pattern ), size_t(100 - pattern_len + 1) );
+		BOOST_CHECK_EQUAL( s.find( pattern, 100 ), size_t(700 - pattern_len + 1) );
+		BOOST_CHECK_EQUAL( s.find( pattern, 700 ), string_type::npos );
+		BOOST_CHECK_EQUAL( s.rfind( pattern ), size_t(700 - pattern_len + 1) );
+		BOOST_CHECK_EQUAL( s.rfind( pattern, 600 ), size_t(100 - pattern_len + 1) );
+		BOOST_CHECK_EQUAL( s.rfind( pattern, 50 ), string_type::npos );
+		BOOST_CHECK_EQUAL( s.find( "baaaaaaaaaaaaaaaaaaab" ), string_type::npos );
+
+		typename string_type::searcher_type searcher( pattern );
+		BOOST_CHECK_EQUAL( searcher.pattern_size(), pattern_len );
+		BOOST_CHECK_EQUAL( s.find( searcher ), s.find( pattern ) );
+		BOOST_CHECK_EQUAL( s.find( searcher, 100 ), s.find( pattern, 100 ) );
+		BOOST_CHECK_EQUAL( s.rfind( searcher ), s.rfind( pattern ) );
+		BOOST_CHECK_EQUAL( s.rfind( searcher, 600 ), s.rfind( pattern, 600 ) );
+
+		string_type tail( s, 650 );
+		BOOST_CHECK_EQUAL( tail.find( searcher ), size_t(50 - pattern_len + 1) );
+
+		typename string_type::searcher_type short_searcher( "ab" );
+		BOOST_CHECK_EQUAL( s.find( short_searcher ), size_t(99) );
+		BOOST_CHECK_EQUAL( s.rfind( short_searcher ), size_t(699) );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_find_custom_traits )
+	{
+		//Shift tables of the searcher would skip the characters, which differ in case only
+		typedef gstl::basic_string<char, ci_char_traits> ci_string;
+		ci_string s( 300, 'x' );
+		s.append( "HELLO, LONG PATTERN!" );
+		s.append( 100, 'x' );
+		const char pattern[] = "hello, long pattern";
+
+		BOOST_CHECK_EQUAL( s.find( pattern ), size_t(300) );
+		BOOST_CHECK_EQUAL( s.rfind( pattern ), size_t(300) );
+
+		ci_string::searcher_type searcher( pattern );
+		BOOST_CHECK_EQUAL( s.find( searcher ), size_t(300) );
+		BOOST_CHECK_EQUAL( s.rfind( searcher ), size_t(300) );
+	}
+
 	//21.3.6.3 basic_string::find_first_of
 	BOOST_AUTO_TEST_CASE_TEMPLATE( test_find_first_of, string_type, t_list )
 	{
@@ -842,6 +1001,23 @@ typedef boost::mpl::list< /**std::string,/**/ gstl_string, memory_mgr_string/**/
 		BOOST_CHECK_EQUAL( test.find_last_of( 'a', 0 ), sz_null );
 	}
 
+	BOOST_AUTO_TEST_CASE_TEMPLATE( test_find_of_char_set, string_type, t_list )
+	{
+		string_type s( "key1 = value\xe9\xff; key2=\tvalue2\n" );
+		const char delims[] = " =;\t\n\xff";
+		BOOST_CHECK_EQUAL( s.find_first_of( delims ), sz_four );
+		BOOST_CHECK_EQUAL( s.find_first_of( delims, 5 ), size_t(5) );
+		BOOST_CHECK_EQUAL( s.find_first_of( delims, 7 ), size_t(13) );
+		BOOST_CHECK_EQUAL( s.find_last_of( delims ), size_t(28) );
+		BOOST_CHECK_EQUAL( s.find_last_of( delims, 22 ), size_t(21) );
+		BOOST_CHECK_EQUAL( s.find_first_not_of( delims, 4 ), size_t(7) );
+		BOOST_CHECK_EQUAL( s.find_first_not_of( delims, 13 ), size_t(16) );
+		BOOST_CHECK_EQUAL( s.find_last_not_of( delims ), size_t(27) );
+		BOOST_CHECK_EQUAL( s.find_last_not_of( delims, 15 ), size_t(12) );
+		BOOST_CHECK_EQUAL( s.find_first_of( "xyz" ), string_type::npos );
+		BOOST_CHECK_EQUAL( s.find_first_not_of( s.c_str() ), string_type::npos );
+	}
+
 	//21.3.6.5 basic_string::find_first_not_of
 	BOOST_AUTO_TEST_CASE_TEMPLATE( test_find_first_not_of, string_type, t_list )
 	{
@@ -1002,6 +1178,87 @@ typedef boost::mpl::list< /**std::string,/**/ gstl_string, memory_mgr_string/**/
 		*/
 	}
 
+	BOOST_AUTO_TEST_CASE_TEMPLATE( test_concatenation, string_type, t_list )
+	{
+		string_type host( "example.com" );
+		string_type path( "index" );
+		string_type s = "http://" + host + '/' + path + ".html";
+		BOOST_CHECK_EQUAL( s.c_str(), "http://example.com/index.html" );
+
+		s = ( host + ':' ) + ( "80" + path );
+		BOOST_CHECK_EQUAL( s.c_str(), "example.com:80index" );
+
+		//Operands may refer to the destination string
+		s = path + "." + path;
+		s = "[" + s + "]";
+		BOOST_CHECK_EQUAL( s.c_str(), "[index.index]" );
+		s = s.substr_view( 1, 5 ) + s;
+		BOOST_CHECK_EQUAL( s.c_str(), "index[index.index]" );
+		path += path + '-' + path;
+		BOOST_CHECK_EQUAL( path.c_str(), "indexindex-index" );
+
+		//The result is a string
+		BOOST_CHECK_EQUAL( ( host + ".html" ).c_str(), "example.com.html" );
+		BOOST_CHECK_EQUAL( ( host + ".html" ).size(), size_t( 16 ) );
+		BOOST_CHECK( host + ".html" == "example.com.html" );
+
+		//Moved operand is appended in place
+		string_type url( "http://" );
+		url.reserve( 100 );
+		const char* buffer = url.data();
+		s = boost::move( url ) + host;
+		BOOST_CHECK_EQUAL( s.c_str(), "http://example.com" );
+		BOOST_CHECK( s.data() == buffer );
+		s = '/' + boost::move( s );
+		s = boost::move( s ) + '/';
+		BOOST_CHECK_EQUAL( s.c_str(), "/http://example.com/" );
+		BOOST_CHECK( s.data() == buffer );
+	}
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE( test_concat_builder, string_type, t_list )
+	{
+		typedef gstl::basic_string_concat<string_type> concat_type;
+		string_type host( "example.com" );
+		string_type path( "index" );
+
+		concat_type url( "http://" );
+		url( host )( '/' )( path.substr_view( 0, 3 ) )( ".html" );
+		BOOST_CHECK_EQUAL( url.size(), size_t( 27 ) );
+		BOOST_CHECK_EQUAL( url.str().c_str(), "http://example.com/ind.html" );
+
+		//Capacity of the destination is reused
+		string_type s;
+		s.reserve( 100 );
+		const char* buffer = s.data();
+		url.assign_to( s );
+		BOOST_CHECK_EQUAL( s.c_str(), "http://example.com/ind.html" );
+		concat_type()( path )( ':' )( host ).assign_to( s );
+		BOOST_CHECK_EQUAL( s.c_str(), "index:example.com" );
+		concat_type()( '?' )( path ).append_to( s );
+		BOOST_CHECK_EQUAL( s.c_str(), "index:example.com?index" );
+		BOOST_CHECK( s.data() == buffer );
+
+		//Pieces may refer to the destination string
+		concat_type()( "[" )( s.substr_view( 0, 5 ) )( "]" ).assign_to( s );
+		BOOST_CHECK_EQUAL( s.c_str(), "[index]" );
+		concat_type()( s )( s ).append_to( s );
+		BOOST_CHECK_EQUAL( s.c_str(), "[index][index][index]" );
+
+		string_type empty( "old" );
+		concat_type().assign_to( empty );
+		BOOST_CHECK( empty.empty() );
+		concat_type()( "" ).append_to( empty );
+		BOOST_CHECK( empty.empty() );
+
+		concat_type many;
+		for( size_t i = 0; i < concat_type::max_pieces; ++i )
+		{
+			many( 'x' );
+		}
+		BOOST_CHECK_THROW( many( 'y' ), std::length_error );
+		BOOST_CHECK_EQUAL( many.str().size(), size_t( concat_type::max_pieces ) );
+	}
+
 	//21.3.7 basic_string non-member functions
 	BOOST_AUTO_TEST_CASE_TEMPLATE( test_non_member_ops, string_type, t_list )
 	{
@@ -1061,6 +1318,44 @@ typedef boost::mpl::list< /**std::string,/**/ gstl_string, memory_mgr_string/**/
 
 	}
 
+	BOOST_AUTO_TEST_CASE_TEMPLATE( test_small_string, string_type, t_list )
+	{
+		const char* short_str = "short";
+		const char* long_str = "long string, which doesn't fit the object";
+
+		string_type s( short_str );
+		const char* item = s.c_str();
+		const char* object = reinterpret_cast<const char*>( &s );
+		BOOST_CHECK( item >= object && item < object + sizeof( s ) );
+
+		string_type l( long_str );
+		item = l.c_str();
+		object = reinterpret_cast<const char*>( &l );
+		BOOST_CHECK( !( item >= object && item < object + sizeof( l ) ) );
+
+		//Local and heap strings are swapped both ways
+		s.swap( l );
+		BOOST_CHECK_EQUAL( s.c_str(), long_str );
+		BOOST_CHECK_EQUAL( l.c_str(), short_str );
+		l.swap( s );
+		BOOST_CHECK_EQUAL( s.c_str(), short_str );
+		BOOST_CHECK_EQUAL( l.c_str(), long_str );
+
+		string_type moved_short( boost::move( s ) );
+		string_type moved_long( boost::move( l ) );
+		BOOST_CHECK_EQUAL( moved_short.c_str(), short_str );
+		BOOST_CHECK_EQUAL( moved_long.c_str(), long_str );
+		BOOST_CHECK( s.empty() );
+		BOOST_CHECK( l.empty() );
+
+		//Growth out of the local buffer keeps the characters
+		moved_short.append( 20, 'x' );
+		BOOST_CHECK_EQUAL( moved_short.size(), 25u );
+		BOOST_CHECK_EQUAL( moved_short.substr( 0, 5 ).c_str(), short_str );
+		moved_short.reserve( 100 );
+		BOOST_CHECK_EQUAL( strlen( moved_short.c_str() ), 25u );
+	}
+
 	//
 	BOOST_AUTO_TEST_CASE_TEMPLATE( test_, string_type, t_list )
 	{
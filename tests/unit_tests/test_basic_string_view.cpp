@@ -0,0 +1,164 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#include "stdafx.h"
+
+#include <gstl/string_view>
+#include <gstl/string>
+#include "managers.hpp"
+
+typedef gstl::basic_string<char, gstl::char_traits<char>,
+	memory_mgr::allocator<char, off_alloc_mgr> > memory_mgr_off_string;
+
+BOOST_AUTO_TEST_SUITE( basic_string_view_test )
+
+	BOOST_AUTO_TEST_CASE( test_construction )
+	{
+		gstl::string_view empty;
+		BOOST_CHECK( empty.empty() );
+		BOOST_CHECK_EQUAL( empty.size(), size_t(0) );
+
+		const char str[] = "key=value";
+		gstl::string_view sv( str );
+		BOOST_CHECK_EQUAL( sv.size(), size_t(9) );
+		BOOST_CHECK( sv.data() == str );
+		BOOST_CHECK_EQUAL( sv.front(), 'k' );
+		BOOST_CHECK_EQUAL( sv.back(), 'e' );
+		BOOST_CHECK_EQUAL( sv[3], '=' );
+		BOOST_CHECK_THROW( sv.at( 9 ), std::out_of_range );
+
+		gstl::string_view part( str, 3 );
+		BOOST_CHECK( part == "key" );
+		BOOST_CHECK( gstl::string( part.begin(), part.end() ) == "key" );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_compare_empty )
+	{
+		//Default constructed view has null data
+		gstl::string_view null_view;
+		gstl::string_view empty( "" );
+		gstl::string_view sv( "key" );
+
+		BOOST_CHECK( null_view == "" );
+		BOOST_CHECK( "" == null_view );
+		BOOST_CHECK( null_view == empty );
+		BOOST_CHECK_EQUAL( null_view.compare( empty ), 0 );
+		BOOST_CHECK_EQUAL( empty.compare( null_view ), 0 );
+		BOOST_CHECK_EQUAL( null_view.compare( null_view ), 0 );
+
+		BOOST_CHECK( null_view.compare( sv ) < 0 );
+		BOOST_CHECK( sv.compare( null_view ) > 0 );
+		BOOST_CHECK( null_view < sv );
+		BOOST_CHECK( sv > null_view );
+		BOOST_CHECK( null_view <= empty );
+		BOOST_CHECK( null_view >= empty );
+		BOOST_CHECK( !( null_view < empty ) );
+		BOOST_CHECK( null_view != sv );
+
+		char buf[1];
+		BOOST_CHECK_EQUAL( null_view.copy( buf, 1 ), size_t(0) );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_substr_and_trim )
+	{
+		gstl::string_view sv( "  key = value  " );
+		sv.remove_prefix( sv.find_first_not_of( ' ' ) );
+		sv.remove_suffix( sv.size() - sv.find_last_not_of( ' ' ) - 1 );
+		BOOST_CHECK( sv == "key = value" );
+
+		gstl::string_view::size_type eq = sv.find( '=' );
+		gstl::string_view key = sv.substr( 0, eq );
+		gstl::string_view value = sv.substr( eq + 2 );
+		BOOST_CHECK( key == "key " );
+		BOOST_CHECK( value == "value" );
+		BOOST_CHECK( value.data() == sv.data() + eq + 2 );
+		BOOST_CHECK( key < value );
+		BOOST_CHECK_THROW( sv.substr( sv.size() + 1 ), std::out_of_range );
+
+		char buf[8] = {0};
+		BOOST_CHECK_EQUAL( value.copy( buf, 3, 1 ), size_t(3) );
+		BOOST_CHECK_EQUAL( gstl::string_view( buf ), "alu" );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_find )
+	{
+		gstl::string_view sv( "one two three one two three" );
+		BOOST_CHECK_EQUAL( sv.find( "two" ), size_t(4) );
+		BOOST_CHECK_EQUAL( sv.find( gstl::string_view( "two" ), 5 ), size_t(18) );
+		BOOST_CHECK_EQUAL( sv.rfind( "two" ), size_t(18) );
+		BOOST_CHECK_EQUAL( sv.rfind( 'o', 10 ), size_t(6) );
+		BOOST_CHECK_EQUAL( sv.find( "four" ), gstl::string_view::npos );
+		BOOST_CHECK_EQUAL( sv.find_first_of( "rw" ), size_t(5) );
+		BOOST_CHECK_EQUAL( sv.find_last_of( "rw" ), size_t(24) );
+		BOOST_CHECK_EQUAL( sv.find_first_not_of( "enot " ), size_t(5) );
+		BOOST_CHECK_EQUAL( sv.find_last_not_of( "ehr" ), size_t(22) );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_string_interoperability )
+	{
+		gstl::string s( "hello world" );
+		gstl::string_view sv = s;
+		BOOST_CHECK( sv.data() == s.c_str() );
+		BOOST_CHECK_EQUAL( sv.size(), s.size() );
+
+		gstl::string_view world = s.substr_view( 6 );
+		BOOST_CHECK( world.data() == s.c_str() + 6 );
+		BOOST_CHECK( world == "world" );
+		BOOST_CHECK( s.substr_view( 0, 5 ) == "hello" );
+		BOOST_CHECK_THROW( s.substr_view( 12 ), std::out_of_range );
+
+		BOOST_CHECK_EQUAL( s.find( world ), size_t(6) );
+		BOOST_CHECK_EQUAL( s.compare( 6, 5, world ), 0 );
+		BOOST_CHECK( s.compare( world ) < 0 );
+		BOOST_CHECK( s != world );
+		BOOST_CHECK( world == s.substr( 6 ) );
+		BOOST_CHECK( s.substr( 6 ) == world );
+
+		gstl::string copy( world );
+		BOOST_CHECK( copy == "world" );
+		copy += gstl::string_view( "!!!", 1 );
+		BOOST_CHECK( copy == "world!" );
+		copy.insert( 0, s.substr_view( 0, 6 ) );
+		BOOST_CHECK( copy == "hello world!" );
+		copy.replace( 0, 5, gstl::string_view( "bye" ) );
+		BOOST_CHECK( copy == "bye world!" );
+		copy.assign( world );
+		BOOST_CHECK( copy == "world" );
+		BOOST_CHECK( copy + gstl::string_view( "wide" ) == "worldwide" );
+		BOOST_CHECK( gstl::string_view( "hello " ) + copy == "hello world" );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_allocator_agnostic )
+	{
+		//Strings with different allocators are compared and searched through the views
+		memory_mgr_off_string shared_str( "value in shared memory" );
+		gstl::string s( "shared" );
+
+		BOOST_CHECK_EQUAL( shared_str.find( s ), size_t(9) );
+		BOOST_CHECK( shared_str.substr_view( 9, 6 ) == s );
+
+		gstl::string local( shared_str.substr_view( 0, 5 ) );
+		BOOST_CHECK( local == "value" );
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
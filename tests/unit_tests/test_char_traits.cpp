@@ -191,6 +191,37 @@ BOOST_FIXTURE_TEST_SUITE( char_traits_test, char_traits_test_fixture )
 		BOOST_CHECK( traits_type::not_eof( not_eof ) == not_eof );
 	}
 
+	BOOST_AUTO_TEST_CASE(test_high_bit_chars)
+	{
+		const char hi[] = "abc\xff";
+		const char lo[] = "abc\x01";
+		BOOST_CHECK( traits_type::compare( hi, lo, 4 ) > 0 );
+		BOOST_CHECK( traits_type::lt( lo[3], hi[3] ) );
+		BOOST_CHECK( !traits_type::lt( hi[3], lo[3] ) );
+		BOOST_CHECK( !traits_type::eq_int_type( traits_type::to_int_type( hi[3] ), traits_type::eof() ) );
+	}
+
+	BOOST_AUTO_TEST_CASE(test_wchar_traits)
+	{
+		typedef gstl::char_traits<wchar_t> wtraits_type;
+		const wchar_t ws[] = L"wide string";
+		wchar_t buf[ sizeof(ws)/sizeof(wchar_t) ];
+
+		BOOST_CHECK( wtraits_type::length( ws ) == wcslen( ws ) );
+		BOOST_CHECK( wtraits_type::find( ws, wtraits_type::length( ws ), L's' ) == ws + 5 );
+		BOOST_CHECK( wtraits_type::find( ws, wtraits_type::length( ws ), L'x' ) == 0 );
+
+		wtraits_type::copy( buf, ws, wtraits_type::length( ws ) + 1 );
+		BOOST_CHECK( wtraits_type::compare( buf, ws, wtraits_type::length( ws ) ) == 0 );
+
+		wtraits_type::move( buf, buf + 5, 7 );
+		BOOST_CHECK( wtraits_type::compare( buf, L"string", 7 ) == 0 );
+
+		wtraits_type::assign( buf, 3, L'z' );
+		BOOST_CHECK( wtraits_type::compare( buf, L"zzzing", 6 ) == 0 );
+		BOOST_CHECK( wtraits_type::compare( buf, L"zzzinh", 6 ) < 0 );
+	}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
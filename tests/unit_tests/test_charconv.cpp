@@ -0,0 +1,175 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#include "stdafx.h"
+
+#include <gstl/charconv>
+#include <gstl/string>
+#include <limits>
+#include <string.h>
+
+namespace
+{
+	template<class T>
+	std::string chars( T value )
+	{
+		char buf[64];
+		const gstl::to_chars_result result = gstl::to_chars( buf, buf + sizeof( buf ), value );
+		BOOST_REQUIRE_EQUAL( result.ec, gstl::chars_ok );
+		return std::string( buf, result.ptr );
+	}
+
+	template<class T>
+	T parse( const char* str, const char** end = 0 )
+	{
+		T value = T();
+		const gstl::from_chars_result result = gstl::from_chars( str, str + strlen( str ), value );
+		BOOST_REQUIRE_EQUAL( result.ec, gstl::chars_ok );
+		if( end != 0 )
+		{
+			*end = result.ptr;
+		}
+		return value;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE( charconv_test )
+
+	BOOST_AUTO_TEST_CASE( test_integer_to_chars )
+	{
+		BOOST_CHECK_EQUAL( chars( 0 ), "0" );
+		BOOST_CHECK_EQUAL( chars( 7 ), "7" );
+		BOOST_CHECK_EQUAL( chars( 10 ), "10" );
+		BOOST_CHECK_EQUAL( chars( -123456 ), "-123456" );
+		BOOST_CHECK_EQUAL( chars( ( std::numeric_limits<int>::min )() ), "-2147483648" );
+		BOOST_CHECK_EQUAL( chars( ( std::numeric_limits<boost::ulong_long_type>::max )() ), "18446744073709551615" );
+
+		char buf[8];
+		gstl::to_chars_result result = gstl::to_chars( buf, buf + sizeof( buf ), 255, 16 );
+		BOOST_CHECK_EQUAL( std::string( buf, result.ptr ), "ff" );
+		result = gstl::to_chars( buf, buf + sizeof( buf ), -5, 2 );
+		BOOST_CHECK_EQUAL( std::string( buf, result.ptr ), "-101" );
+
+		//Not enough space
+		result = gstl::to_chars( buf, buf + 3, 1234 );
+		BOOST_CHECK_EQUAL( result.ec, gstl::chars_value_too_large );
+		BOOST_CHECK( result.ptr == buf + 3 );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_integer_from_chars )
+	{
+		const char* end = 0;
+		BOOST_CHECK_EQUAL( parse<int>( "-2147483648" ), ( std::numeric_limits<int>::min )() );
+		BOOST_CHECK_EQUAL( parse<unsigned>( "4294967295" ), ( std::numeric_limits<unsigned>::max )() );
+		BOOST_CHECK_EQUAL( parse<int>( "123abc", &end ), 123 );
+		BOOST_CHECK_EQUAL( std::string( end ), "abc" );
+
+		int value = 42;
+		const char overflow[] = "2147483648";
+		gstl::from_chars_result result = gstl::from_chars( overflow, overflow + 10, value );
+		BOOST_CHECK_EQUAL( result.ec, gstl::chars_value_too_large );
+		BOOST_CHECK( result.ptr == overflow + 10 );
+		BOOST_CHECK_EQUAL( value, 42 );
+
+		const char negative[] = "-1";
+		unsigned u = 0;
+		result = gstl::from_chars( negative, negative + 2, u );
+		BOOST_CHECK_EQUAL( result.ec, gstl::chars_invalid_argument );
+		BOOST_CHECK( result.ptr == negative );
+
+		const char hex[] = "7FfF";
+		result = gstl::from_chars( hex, hex + 4, value, 16 );
+		BOOST_CHECK_EQUAL( result.ec, gstl::chars_ok );
+		BOOST_CHECK_EQUAL( value, 0x7fff );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_float_to_chars )
+	{
+		BOOST_CHECK_EQUAL( chars( 0.0 ), "0" );
+		BOOST_CHECK_EQUAL( chars( -0.0 ), "-0" );
+		BOOST_CHECK_EQUAL( chars( 0.1 ), "0.1" );
+		BOOST_CHECK_EQUAL( chars( 0.1f ), "0.1" );
+		BOOST_CHECK_EQUAL( chars( 1.5 ), "1.5" );
+		BOOST_CHECK_EQUAL( chars( 100.0 ), "100" );
+		BOOST_CHECK_EQUAL( chars( 0.001 ), "0.001" );
+		BOOST_CHECK_EQUAL( chars( 1e-5 ), "1e-05" );
+		BOOST_CHECK_EQUAL( chars( 1e22 ), "1e+22" );
+		BOOST_CHECK_EQUAL( chars( 123456789.0 ), "123456789" );
+		BOOST_CHECK_EQUAL( chars( ( std::numeric_limits<double>::max )() ), "1.7976931348623157e+308" );
+		BOOST_CHECK_EQUAL( chars( ( std::numeric_limits<double>::denorm_min )() ), "5e-324" );
+		BOOST_CHECK_EQUAL( chars( std::numeric_limits<double>::infinity() ), "inf" );
+		BOOST_CHECK_EQUAL( chars( -std::numeric_limits<double>::infinity() ), "-inf" );
+		BOOST_CHECK_EQUAL( chars( std::numeric_limits<double>::quiet_NaN() ), "nan" );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_float_round_trip )
+	{
+		const double values[] = { 0.1, 1.0 / 3, 2.0 / 3, 1e-300, 123.456, 5e-324, 2.2250738585072014e-308,
+			9007199254740993.0, 1.7976931348623157e308, 0.30000000000000004 };
+		for( size_t i = 0; i < sizeof( values ) / sizeof( values[0] ); ++i )
+		{
+			BOOST_CHECK_EQUAL( parse<double>( chars( values[i] ).c_str() ), values[i] );
+			BOOST_CHECK_EQUAL( parse<double>( chars( -values[i] ).c_str() ), -values[i] );
+			const float f = static_cast<float>( values[i] );
+			BOOST_CHECK_EQUAL( parse<float>( chars( f ).c_str() ), f );
+		}
+
+		//Slow path with many digits and the large exponent
+		BOOST_CHECK_EQUAL( parse<double>( "2.2250738585072011e-308" ), 2.2250738585072011e-308 );
+		BOOST_CHECK_EQUAL( parse<double>( "0.1000000000000000055511151231257827" ), 0.1 );
+		BOOST_CHECK_EQUAL( parse<double>( "1E+2" ), 100.0 );
+		BOOST_CHECK_EQUAL( parse<double>( "-Infinity" ), -std::numeric_limits<double>::infinity() );
+
+		double value = 0;
+		const char huge[] = "1e400";
+		gstl::from_chars_result result = gstl::from_chars( huge, huge + 5, value );
+		BOOST_CHECK_EQUAL( result.ec, gstl::chars_value_too_large );
+		const char text[] = "e5";
+		result = gstl::from_chars( text, text + 2, value );
+		BOOST_CHECK_EQUAL( result.ec, gstl::chars_invalid_argument );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_string_conversions )
+	{
+		BOOST_CHECK( gstl::to_string( -42 ) == "-42" );
+		BOOST_CHECK( gstl::to_string( 0.25 ) == "0.25" );
+
+		gstl::string s( "x=" );
+		gstl::append_number( s, 12 );
+		s += ", y=";
+		gstl::append_number( s, 1.5f );
+		BOOST_CHECK( s == "x=12, y=1.5" );
+
+		size_t idx = 0;
+		BOOST_CHECK_EQUAL( gstl::stoi( gstl::string( "  +17 apples" ), &idx ), 17 );
+		BOOST_CHECK_EQUAL( idx, 5u );
+		BOOST_CHECK_EQUAL( gstl::stol( gstl::string( "-ff" ), 0, 16 ), -255 );
+		BOOST_CHECK_EQUAL( gstl::stoull( gstl::string( "18446744073709551615" ) ),
+			( std::numeric_limits<boost::ulong_long_type>::max )() );
+		BOOST_CHECK_EQUAL( gstl::stod( gstl::string( "\t-2.5e-3" ) ), -2.5e-3 );
+		BOOST_CHECK_THROW( gstl::stoi( gstl::string( "apples" ) ), std::invalid_argument );
+		BOOST_CHECK_THROW( gstl::stoi( gstl::string( "99999999999" ) ), std::out_of_range );
+		BOOST_CHECK_THROW( gstl::stof( gstl::string( "1e100" ) ), std::out_of_range );
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -24,10 +24,45 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 #include "stdafx.h"
 
 #include <gstl/detail/dynamic_buffer.hpp>
+#include "operations_tracer.hpp"
 
 class dynamic_buffer_fixture
 {
-
+public:
+	typedef gstl::test::operations_tracer<int>	tracer_type;
+	typedef gstl::detail::dynamic_buffer<int, gstl::allocator<int> > int_buffer_type;
+
+	/**
+	   @brief Allocator with blocks of block_items items, which can be expanded in place
+	*/
+	template<class T>
+	class expanding_allocator
+		:public gstl::allocator<T>
+	{
+	public:
+		typedef gstl::allocator<T>				base_type;
+		typedef typename base_type::pointer		pointer;
+		typedef typename base_type::size_type	size_type;
+
+		enum{ block_items = 1000 };
+
+		template<class Other>
+		struct rebind
+		{
+			typedef expanding_allocator<Other> other;
+		};
+
+		pointer allocate( size_type count )
+		{
+			return base_type::allocate( (gstl::max)( count, size_type( block_items ) ) );
+		}
+
+		bool try_expand( pointer /*ptr*/, size_type /*old_count*/, size_type new_count )
+		{
+			return new_count <= block_items;
+		}
+	};
+	typedef gstl::detail::dynamic_buffer<int, expanding_allocator<int> > expanding_buffer_type;
 };
 
 BOOST_FIXTURE_TEST_SUITE( dynamic_sequence_test, dynamic_buffer_fixture )
@@ -37,6 +72,112 @@ BOOST_AUTO_TEST_CASE( test_constructors )
 
 }
 
+BOOST_AUTO_TEST_CASE( test_reserve_keeps_items )
+{
+	int_buffer_type buf;
+	buf.reserve( int_buffer_type::min_buff_size );
+	for( int i = 0; i < int_buffer_type::min_buff_size; ++i )
+	{
+		buf[i] = i;
+	}
+	buf.set_size( int_buffer_type::min_buff_size );
+
+	buf.reserve( 1000 );
+	BOOST_CHECK_GE( buf.capacity(), 1000u );
+	BOOST_CHECK_EQUAL( buf.size(), static_cast<size_t>( int_buffer_type::min_buff_size ) );
+	for( int i = 0; i < int_buffer_type::min_buff_size; ++i )
+	{
+		BOOST_CHECK_EQUAL( buf[i], i );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_relocate )
+{
+	gstl::allocator<tracer_type> alloc;
+	tracer_type* src = alloc.allocate( sz_three );
+	tracer_type* dst = alloc.allocate( sz_three );
+	for( int i = 0; i < 3; ++i )
+	{
+		alloc.construct( src + i, tracer_type( i ) );
+	}
+
+	tracer_type::clear();
+	gstl::detail::relocate( dst, src, sz_three );
+	//Each item is constructed in the new place and destroyed in the old one
+	BOOST_CHECK_EQUAL( tracer_type::creations(), 3 );
+	BOOST_CHECK_EQUAL( tracer_type::destructions(), 3 );
+	BOOST_CHECK_EQUAL( tracer_type::assignments(), 0 );
+	for( int i = 0; i < 3; ++i )
+	{
+		BOOST_CHECK_EQUAL( dst[i].value(), i );
+		alloc.destroy( dst + i );
+	}
+
+	alloc.deallocate( src, sz_three );
+	alloc.deallocate( dst, sz_three );
+	tracer_type::clear();
+}
+
+BOOST_AUTO_TEST_CASE( test_growth_policy )
+{
+	typedef gstl::detail::default_sequence_traits<int> traits_type;
+	typedef gstl::detail::dynamic_buffer<int, gstl::allocator<int>,
+		traits_type, gstl::double_growth> double_buffer_type;
+	typedef gstl::detail::dynamic_buffer<int, gstl::allocator<int>,
+		traits_type, gstl::fixed_growth<100> > fixed_buffer_type;
+	typedef gstl::detail::dynamic_buffer<int, gstl::allocator<int>,
+		traits_type, gstl::page_rounded_growth<> > page_buffer_type;
+
+	int_buffer_type buf;
+	buf.reserve( 10 );
+	BOOST_CHECK_EQUAL( buf.capacity(), 10u );
+	buf.reserve( 11 );
+	BOOST_CHECK_EQUAL( buf.capacity(), 15u );
+
+	double_buffer_type dbuf;
+	dbuf.reserve( 10 );
+	BOOST_CHECK_EQUAL( dbuf.capacity(), 10u );
+	dbuf.reserve( 11 );
+	BOOST_CHECK_EQUAL( dbuf.capacity(), 20u );
+	dbuf.reserve( 50 );
+	BOOST_CHECK_EQUAL( dbuf.capacity(), 50u );
+
+	fixed_buffer_type fbuf;
+	fbuf.reserve( 1 );
+	BOOST_CHECK_EQUAL( fbuf.capacity(), 100u );
+	fbuf.reserve( 101 );
+	BOOST_CHECK_EQUAL( fbuf.capacity(), 200u );
+
+	page_buffer_type pbuf;
+	pbuf.reserve( 1 );
+	BOOST_CHECK_EQUAL( pbuf.capacity(), GSTL_PAGE_SIZE / sizeof( int ) );
+	pbuf.reserve( pbuf.capacity() + 1 );
+	BOOST_CHECK_EQUAL( pbuf.capacity() % ( GSTL_PAGE_SIZE / sizeof( int ) ), 0u );
+}
+
+BOOST_AUTO_TEST_CASE( test_try_expand )
+{
+	BOOST_CHECK( ! gstl::detail::has_try_expand< gstl::allocator<int> >::value );
+	BOOST_CHECK( gstl::detail::has_try_expand< expanding_allocator<int> >::value );
+
+	expanding_buffer_type buf;
+	buf.reserve( 10 );
+	buf[0] = 42;
+	buf.set_size( 1 );
+	const int* block = buf.get_buffer();
+
+	//Block is expanded, items stay in place
+	buf.reserve( 500 );
+	BOOST_CHECK_EQUAL( buf.get_buffer(), block );
+	BOOST_CHECK_GE( buf.capacity(), 500u );
+
+	//Too large for the block, reallocated
+	buf.reserve( 5000 );
+	BOOST_CHECK_NE( buf.get_buffer(), block );
+	BOOST_CHECK_GE( buf.capacity(), 5000u );
+	BOOST_CHECK_EQUAL( buf[0], 42 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
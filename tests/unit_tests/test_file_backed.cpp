@@ -0,0 +1,153 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#include "stdafx.h"
+
+#if !defined(_WIN32)
+
+#include <gstl/file_backed>
+#include <stdio.h>
+#include <sstream>
+#include <iterator>
+#include <string>
+
+class file_backed_fixture
+{
+public:
+	typedef gstl::file_vector<int>::type	int_file_vector;
+	typedef gstl::file_string<char>::type	file_string;
+
+	file_backed_fixture()
+		:path_( "gstl_file_backed_test.bin" )
+	{
+		remove( path_ );
+	}
+
+	~file_backed_fixture()
+	{
+		remove( path_ );
+	}
+
+	const char* path_;
+};
+
+BOOST_FIXTURE_TEST_SUITE( file_backed_test, file_backed_fixture )
+
+	BOOST_AUTO_TEST_CASE( test_vector_reopen )
+	{
+		const int count = 100000;
+		const int* items = 0;
+		{
+			int_file_vector vec( path_ );
+			BOOST_CHECK( vec.empty() );
+			for( int i = 0; i < count; ++i )
+			{
+				vec.push_back( i );
+			}
+			//Growth extends the file in place
+			items = &vec.front();
+			vec.reserve( count * 2 );
+			BOOST_CHECK_EQUAL( &vec.front(), items );
+		}
+		{
+			int_file_vector vec( path_ );
+			BOOST_REQUIRE_EQUAL( vec.size(), size_t( count ) );
+			for( int i = 0; i < count; i += 101 )
+			{
+				BOOST_CHECK_EQUAL( vec[i], i );
+			}
+			vec.resize( 10 );
+		}
+		{
+			int_file_vector vec( path_ );
+			BOOST_CHECK_EQUAL( vec.size(), 10u );
+			BOOST_CHECK_EQUAL( vec.front(), 0 );
+			BOOST_CHECK_EQUAL( vec.back(), 9 );
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE( test_string_reopen )
+	{
+		{
+			file_string str( path_ );
+			str.append( "persistent " );
+			str.append( "string" );
+		}
+		{
+			file_string str( path_ );
+			BOOST_CHECK_EQUAL( str, "persistent string" );
+		}
+		{
+			//Wrong item size
+			BOOST_CHECK_THROW( int_file_vector vec( path_ ), std::runtime_error );
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE( test_vector_input_insert )
+	{
+		{
+			int_file_vector vec( path_ );
+			int arr[] = { 1, 2, 5 };
+			vec.assign( arr, GSTL_ARRAY_END( arr ) );
+
+			//The file has only one block, input items are buffered with the default allocator
+			std::istringstream input( "3 4" );
+			vec.insert( vec.begin() + 2, std::istream_iterator<int>( input ), std::istream_iterator<int>() );
+		}
+		{
+			int_file_vector vec( path_ );
+			BOOST_REQUIRE_EQUAL( vec.size(), 5u );
+			for( int i = 0; i < 5; ++i )
+			{
+				BOOST_CHECK_EQUAL( vec[i], i + 1 );
+			}
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE( test_string_self_replace )
+	{
+		const char* alphabet = "0123456789abcdefghijklmnopqrstuvwxyz";
+		{
+			file_string str( path_ );
+			str.assign( alphabet );
+			const char* chars = str.data();
+
+			//Source is the string itself, the string grows in the file
+			str.replace( str.begin() + 2, str.begin() + 4, str.begin(), str.end() );
+			BOOST_CHECK( str.data() == chars );
+			BOOST_CHECK_EQUAL( str, ( std::string( "01" ) + alphabet + ( alphabet + 4 ) ).c_str() );
+
+			str.replace( str.begin(), str.begin() + 20, str.begin() + 30, str.begin() + 32 );
+			BOOST_CHECK( str.data() == chars );
+		}
+		{
+			file_string str( path_ );
+			std::string expected = std::string( "01" ) + alphabet + ( alphabet + 4 );
+			expected.replace( 0, 20, expected, 30, 2 );
+			BOOST_CHECK_EQUAL( str, expected.c_str() );
+		}
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,106 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#include "stdafx.h"
+
+#include <gstl/hash.hpp>
+#include <boost/unordered_map.hpp>
+#include "managers.hpp"
+
+typedef gstl::basic_string<char, gstl::char_traits<char>,
+	memory_mgr::allocator<char, off_alloc_mgr> > memory_mgr_off_string;
+
+BOOST_AUTO_TEST_SUITE( hash_test )
+
+	BOOST_AUTO_TEST_CASE( test_string_hash )
+	{
+		gstl::string s( "named object in shared memory" );
+		memory_mgr_off_string shared_s( s.c_str() );
+		gstl::hash<gstl::string> hasher;
+
+		//Hash depends only on the characters
+		BOOST_CHECK_EQUAL( hasher( s ), boost::hash<gstl::string>()( s ) );
+		BOOST_CHECK_EQUAL( hasher( s ), boost::hash<memory_mgr_off_string>()( shared_s ) );
+		BOOST_CHECK_EQUAL( hasher( s ), gstl::hash<gstl::string_view>()( s.substr_view() ) );
+
+		//All lengths of the short and the long keys are hashed
+		gstl::string prefix;
+		for( int i = 0; i < 100; ++i )
+		{
+			gstl::string longer( prefix );
+			longer.push_back( 'x' );
+			BOOST_CHECK( hasher( prefix ) != hasher( longer ) );
+			BOOST_CHECK_EQUAL( hasher( longer ), hasher( gstl::string( longer ) ) );
+			prefix.push_back( static_cast<char>( 'a' + i % 26 ) );
+		}
+
+		gstl::wstring ws( L"wide" );
+		BOOST_CHECK_EQUAL( gstl::hash<gstl::wstring>()( ws ), gstl::hash<gstl::wstring>()( gstl::wstring( L"wide" ) ) );
+		BOOST_CHECK( gstl::hash<gstl::wstring>()( ws ) != gstl::hash<gstl::wstring>()( gstl::wstring( L"wida" ) ) );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_unordered_map )
+	{
+		typedef boost::unordered_map< gstl::string, int, gstl::hash<gstl::string> > map_type;
+		map_type map;
+		map["one"] = 1;
+		map["two"] = 2;
+		map["three"] = 3;
+		BOOST_CHECK_EQUAL( map.size(), size_t(3) );
+		BOOST_CHECK_EQUAL( map[gstl::string( "two" )], 2 );
+		BOOST_CHECK( map.find( gstl::string( "four" ) ) == map.end() );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_hashed_string )
+	{
+		typedef gstl::hashed_string<gstl::string> hashed_type;
+		hashed_type s( "key" );
+		BOOST_CHECK( !s.has_cached_hash() );
+
+		const std::size_t h = s.hash();
+		BOOST_CHECK( s.has_cached_hash() );
+		BOOST_CHECK_EQUAL( h, gstl::hash<gstl::string>()( s.str() ) );
+		BOOST_CHECK_EQUAL( boost::hash<hashed_type>()( s ), h );
+
+		//Modification drops the cached hash
+		s += "s";
+		BOOST_CHECK( !s.has_cached_hash() );
+		BOOST_CHECK_EQUAL( s.hash(), gstl::hash<gstl::string>()( gstl::string( "keys" ) ) );
+		s.clear();
+		BOOST_CHECK( !s.has_cached_hash() );
+		s.assign( "key" );
+		BOOST_CHECK_EQUAL( s.hash(), h );
+
+		hashed_type other( "other" );
+		other.hash();
+		BOOST_CHECK( s != other );
+		BOOST_CHECK( s == hashed_type( "key" ) );
+
+		typedef boost::unordered_map< hashed_type, int, gstl::hash<hashed_type> > map_type;
+		map_type map;
+		map[s] = 1;
+		map[other] = 2;
+		BOOST_CHECK_EQUAL( map[hashed_type( "key" )], 1 );
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -78,6 +78,46 @@ typedef boost::mpl::list< /**std_list,/**/ gstl_list/**/, memory_mgr_list/**/, m
 //#include "detail/test_construction_throw.hpp"
 //#include "detail/test_assign_throw.hpp"
 
+BOOST_AUTO_TEST_CASE( test_move_and_emplace )
+{
+	tracer_type::clear();
+	{
+		traced_container_type lst1;
+
+		//Items are constructed in place, no copies
+		lst1.emplace_back( 1 );
+		lst1.emplace_front( 2 );
+		lst1.emplace( ++lst1.begin(), 3 );
+		lst1.emplace_back();
+		BOOST_CHECK_EQUAL( tracer_type::creations(), 4 );
+		BOOST_CHECK_EQUAL( tracer_type::destructions(), 0 );
+
+		int expected[] = { 2, 3, 1, 0 };
+		BOOST_REQUIRE_EQUAL( lst1.size(), GSTL_ARRAY_LEN( expected ) );
+		int* curr = expected;
+		BOOST_FOREACH( const tracer_type& item, lst1 )
+		{
+			BOOST_CHECK_EQUAL( item.value(), *curr++ );
+		}
+
+		//Move constructor steals the nodes
+		traced_container_type lst2( boost::move( lst1 ) );
+		BOOST_CHECK( lst1.empty() );
+		BOOST_CHECK_EQUAL( lst2.size(), GSTL_ARRAY_LEN( expected ) );
+		BOOST_CHECK_EQUAL( tracer_type::creations(), 4 );
+
+		lst1.emplace_back( 5 );
+		lst1 = boost::move( lst2 );
+		BOOST_CHECK( lst2.empty() );
+		BOOST_CHECK_EQUAL( lst1.size(), GSTL_ARRAY_LEN( expected ) );
+		BOOST_CHECK_EQUAL( lst1.front().value(), 2 );
+		BOOST_CHECK_EQUAL( tracer_type::creations(), 5 );
+		BOOST_CHECK_EQUAL( tracer_type::destructions(), 1 );
+	}
+	BOOST_CHECK_EQUAL( tracer_type::creations(), tracer_type::destructions() );
+	tracer_type::clear();
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,109 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#include "stdafx.h"
+
+#include <gstl/mmap_allocator>
+#include <gstl/vector>
+#include <gstl/string>
+
+class mmap_allocator_fixture
+{
+public:
+	typedef gstl::mmap_allocator<int>				allocator_type;
+	typedef gstl::vector<int, allocator_type>		int_vector;
+	typedef gstl::basic_string<char, gstl::char_traits<char>,
+		gstl::mmap_allocator<char> >				mmap_string;
+};
+
+BOOST_FIXTURE_TEST_SUITE( mmap_allocator_test, mmap_allocator_fixture )
+
+	BOOST_AUTO_TEST_CASE( test_small_and_mapped_blocks )
+	{
+		allocator_type alloc( gstl::mmap_default, 4096 );
+
+		//operator new
+		size_t allocated = 0;
+		int* small = alloc.allocate_at_least( 10, allocated );
+		BOOST_CHECK_EQUAL( allocated, 10u );
+		BOOST_CHECK( !alloc.try_expand( small, 10, 20 ) );
+		BOOST_CHECK( !alloc.reallocate( small, 10, 20000 ) );
+		alloc.deallocate( small, 10 );
+
+		//Mapped block uses the whole pages
+		int* big = alloc.allocate_at_least( 1500, allocated );
+		BOOST_CHECK_GE( allocated, 1500u );
+		BOOST_CHECK_EQUAL( allocated * sizeof( int ) % gstl::detail::mmap_memory::page_size(), 0u );
+		for( size_t i = 0; i < allocated; ++i )
+		{
+			big[i] = static_cast<int>( i );
+		}
+		BOOST_CHECK( alloc.try_expand( big, 1500, allocated ) );
+
+		//Remapping is not available everywhere
+		int* moved = alloc.reallocate( big, allocated, allocated * 16 );
+		if( moved )
+		{
+			BOOST_CHECK_EQUAL( moved[allocated - 1], static_cast<int>( allocated - 1 ) );
+			big = moved;
+			allocated *= 16;
+		}
+		alloc.deallocate( big, allocated );
+
+		//Rebound allocator keeps the settings
+		gstl::mmap_allocator<char> char_alloc( alloc );
+		BOOST_CHECK_EQUAL( char_alloc.threshold(), 4096u );
+		BOOST_CHECK( char_alloc == alloc );
+
+		//Huge page allocators round the mappings differently
+		BOOST_CHECK( allocator_type( gstl::mmap_populate, 4096 ) == alloc );
+		BOOST_CHECK( allocator_type( gstl::mmap_huge_pages, 4096 ) != alloc );
+		BOOST_CHECK( allocator_type( gstl::mmap_default, 8192 ) != alloc );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_containers )
+	{
+		int_vector vec( allocator_type( gstl::mmap_populate | gstl::mmap_huge_pages, 64 * 1024 ) );
+		const int count = 1000000;
+		for( int i = 0; i < count; ++i )
+		{
+			vec.push_back( i );
+		}
+		BOOST_CHECK_EQUAL( vec.size(), size_t( count ) );
+		for( int i = 0; i < count; i += 997 )
+		{
+			BOOST_CHECK_EQUAL( vec[i], i );
+		}
+		vec.reserve( count * 4 );
+		BOOST_CHECK_EQUAL( vec.back(), count - 1 );
+
+		mmap_string str( gstl::mmap_allocator<char>( gstl::mmap_default, 4096 ) );
+		for( int i = 0; i < 1000; ++i )
+		{
+			str.append( "0123456789" );
+		}
+		BOOST_CHECK_EQUAL( str.size(), 10000u );
+		BOOST_CHECK_EQUAL( str.substr( 9990 ), "0123456789" );
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,109 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#include "stdafx.h"
+
+#include <gstl/segmented_vector>
+#include "operations_tracer.hpp"
+#include "test_class.hpp"
+#include "managers.hpp"
+
+class segmented_vector_fixture
+{
+public:
+	typedef gstl::test::operations_tracer<int>	tracer_type;
+	typedef gstl::segmented_vector<tracer_type, gstl::allocator<tracer_type>, 4>	traced_container_type;
+};
+
+BOOST_FIXTURE_TEST_SUITE( segmented_vector_test, segmented_vector_fixture )
+
+	typedef test_class test_value_type;
+	typedef gstl::segmented_vector<test_value_type>	gstl_segmented_vector;
+	typedef gstl::segmented_vector<test_value_type,
+		memory_mgr::allocator<test_value_type, ptr_alloc_mgr>, 2 >		memory_mgr_segmented_vector;
+	typedef gstl::segmented_vector<test_value_type,
+		memory_mgr::allocator<test_value_type, off_alloc_mgr>, 4 >		memory_mgr_off_segmented_vector;
+
+	typedef boost::mpl::list< gstl_segmented_vector, memory_mgr_segmented_vector,
+		memory_mgr_off_segmented_vector > t_list;
+
+	#include "detail/test_construction.hpp"
+	#include "detail/test_assign_operator.hpp"
+	#include "detail/test_clear.hpp"
+	#include "detail/test_empty.hpp"
+	#include "detail/test_resize.hpp"
+	#include "detail/test_begin_end.hpp"
+	#include "detail/test_swap.hpp"
+	#include "detail/test_compare_operators.hpp"
+	#include "detail/test_push_pop_back.hpp"
+	#include "detail/test_back.hpp"
+	#include "detail/test_front.hpp"
+
+	#include "detail/test_access_operators.hpp"
+	#include "detail/test_reserve.hpp"
+
+	#include "detail/test_iterator.hpp"
+
+	BOOST_AUTO_TEST_CASE( test_stable_addresses )
+	{
+		tracer_type::clear();
+		{
+			traced_container_type vec;
+			vec.push_back( tracer_type( 0 ) );
+			const tracer_type* first = &vec.front();
+			traced_container_type::iterator first_iter = vec.begin();
+
+			//Growth never copies the items
+			long creations = tracer_type::creations();
+			for( int i = 1; i < 1000; ++i )
+			{
+				vec.emplace_back( i );
+			}
+			BOOST_CHECK_EQUAL( tracer_type::creations(), creations + 999 );
+			BOOST_CHECK_EQUAL( &vec.front(), first );
+			BOOST_CHECK( first_iter == vec.begin() );
+
+			//4 + 8 + ... + 1024 items
+			BOOST_CHECK_EQUAL( vec.block_count(), 8u );
+			BOOST_CHECK_EQUAL( vec.capacity(), 1020u );
+			for( int i = 0; i < 1000; ++i )
+			{
+				BOOST_CHECK_EQUAL( vec[i].value(), i );
+			}
+
+			//Random access iterators
+			BOOST_CHECK_EQUAL( vec.end() - vec.begin(), 1000 );
+			BOOST_CHECK_EQUAL( ( vec.begin() + 500 )->value(), 500 );
+			BOOST_CHECK_EQUAL( ( vec.end() - 1 )->value(), 999 );
+			BOOST_CHECK( gstl::find( vec.begin(), vec.end(), tracer_type( 77 ) ) == vec.begin() + 77 );
+
+			vec.resize( 10 );
+			vec.shrink_to_fit();
+			BOOST_CHECK_EQUAL( vec.block_count(), 2u );
+			BOOST_CHECK_EQUAL( &vec.front(), first );
+		}
+		BOOST_CHECK_EQUAL( tracer_type::creations(), tracer_type::destructions() );
+		tracer_type::clear();
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,175 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#include "stdafx.h"
+
+#include <gstl/string_serialization.hpp>
+#include <gstl/vector_serialization.hpp>
+#include <sstream>
+#include <vector>
+#include <boost/mpl/list.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
+
+namespace
+{
+	struct point
+	{
+		int x;
+		int y;
+
+		point( int x_ = 0, int y_ = 0 )
+			:x( x_ ), y( y_ )
+		{}
+
+		template<class Archive>
+		void serialize( Archive& ar, const unsigned int /*version*/ )
+		{
+			ar & x & y;
+		}
+	};
+
+	bool operator==( const point& lhs, const point& rhs )
+	{
+		return lhs.x == rhs.x && lhs.y == rhs.y;
+	}
+
+	template<class OArchive, class IArchive>
+	struct archives
+	{
+		typedef OArchive oarchive;
+		typedef IArchive iarchive;
+	};
+
+	typedef archives<boost::archive::text_oarchive, boost::archive::text_iarchive> text_archives;
+	typedef archives<boost::archive::binary_oarchive, boost::archive::binary_iarchive> binary_archives;
+
+	template<class Archives, class T>
+	std::string save( const T& value )
+	{
+		std::stringstream stream;
+		{
+			typename Archives::oarchive ar( stream );
+			ar << value;
+		}
+		return stream.str();
+	}
+
+	template<class Archives, class T>
+	void load( const std::string& data, T& value )
+	{
+		std::stringstream stream( data );
+		typename Archives::iarchive ar( stream );
+		ar >> value;
+	}
+}
+
+//Item version is written for the class types
+BOOST_CLASS_VERSION( point, 2 )
+
+typedef boost::mpl::list< text_archives, binary_archives > archive_list;
+
+BOOST_AUTO_TEST_SUITE( serialization_test )
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE( test_string, archive_type, archive_list )
+	{
+		gstl::string str( "key = value" );
+		gstl::string loaded( "old" );
+		load<archive_type>( save<archive_type>( str ), loaded );
+		BOOST_CHECK( loaded == str );
+
+		gstl::string empty;
+		load<archive_type>( save<archive_type>( empty ), loaded );
+		BOOST_CHECK( loaded.empty() );
+
+		//Same format as std::string
+		BOOST_CHECK( save<archive_type>( str ) == save<archive_type>( std::string( "key = value" ) ) );
+		std::string std_loaded;
+		load<archive_type>( save<archive_type>( str ), std_loaded );
+		BOOST_CHECK_EQUAL( std_loaded, "key = value" );
+	}
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE( test_wstring, archive_type, archive_list )
+	{
+		gstl::wstring str( L"wide value" );
+		gstl::wstring loaded;
+		load<archive_type>( save<archive_type>( str ), loaded );
+		BOOST_CHECK( loaded == str );
+		BOOST_CHECK( save<archive_type>( str ) == save<archive_type>( std::wstring( L"wide value" ) ) );
+	}
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE( test_arithmetic_vector, archive_type, archive_list )
+	{
+		gstl::vector<int> vec;
+		std::vector<int> std_vec;
+		for( int i = 0; i < 100; ++i )
+		{
+			vec.push_back( i * 3 - 50 );
+			std_vec.push_back( i * 3 - 50 );
+		}
+
+		gstl::vector<int> loaded( 5, 1 );
+		load<archive_type>( save<archive_type>( vec ), loaded );
+		BOOST_CHECK( loaded == vec );
+
+		//Same format as std::vector
+		BOOST_CHECK( save<archive_type>( vec ) == save<archive_type>( std_vec ) );
+		std::vector<int> std_loaded;
+		load<archive_type>( save<archive_type>( vec ), std_loaded );
+		BOOST_CHECK( std_loaded == std_vec );
+
+		gstl::vector<int> empty;
+		load<archive_type>( save<archive_type>( empty ), loaded );
+		BOOST_CHECK( loaded.empty() );
+	}
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE( test_class_vector, archive_type, archive_list )
+	{
+		gstl::vector<point> vec;
+		std::vector<point> std_vec;
+		for( int i = 0; i < 10; ++i )
+		{
+			vec.push_back( point( i, -i ) );
+			std_vec.push_back( point( i, -i ) );
+		}
+
+		gstl::vector<point> loaded;
+		load<archive_type>( save<archive_type>( vec ), loaded );
+		BOOST_CHECK( loaded == vec );
+
+		//Same format as std::vector, including the item version
+		BOOST_CHECK( save<archive_type>( vec ) == save<archive_type>( std_vec ) );
+		std::vector<point> std_loaded;
+		load<archive_type>( save<archive_type>( vec ), std_loaded );
+		BOOST_CHECK( std_loaded == std_vec );
+		loaded.clear();
+		load<archive_type>( save<archive_type>( std_vec ), loaded );
+		BOOST_CHECK( loaded == vec );
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,229 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#include "stdafx.h"
+
+#include <gstl/small_vector>
+#include "operations_tracer.hpp"
+#include "test_class.hpp"
+#include "managers.hpp"
+#include <map>
+
+namespace
+{
+	/**
+	   @brief Allocator, which checks that blocks are freed by the allocator with the same id
+	*/
+	template<class T>
+	class tagged_allocator
+		:public std::allocator<T>
+	{
+	public:
+		typedef typename std::allocator<T>::pointer		pointer;
+		typedef typename std::allocator<T>::size_type	size_type;
+
+		template<class Other>
+		struct rebind
+		{
+			typedef tagged_allocator<Other> other;
+		};
+
+		explicit tagged_allocator( int id = 0 )
+			:id_( id )
+		{}
+
+		template<class Other>
+		tagged_allocator( const tagged_allocator<Other>& rhs )
+			:id_( rhs.id() )
+		{}
+
+		pointer allocate( size_type count )
+		{
+			pointer ptr = std::allocator<T>::allocate( count );
+			owners()[ptr] = id_;
+			return ptr;
+		}
+
+		void deallocate( pointer ptr, size_type count )
+		{
+			BOOST_CHECK_EQUAL( owners()[ptr], id_ );
+			owners().erase( ptr );
+			std::allocator<T>::deallocate( ptr, count );
+		}
+
+		int id() const
+		{
+			return id_;
+		}
+
+		static std::map<const void*, int>& owners()
+		{
+			static std::map<const void*, int> blocks;
+			return blocks;
+		}
+
+	private:
+		int id_;
+	};
+
+	template<class T, class U>
+	bool operator==( const tagged_allocator<T>& lhs, const tagged_allocator<U>& rhs )
+	{
+		return lhs.id() == rhs.id();
+	}
+}
+
+class small_vector_fixture
+{
+public:
+	typedef gstl::test::operations_tracer<int>	tracer_type;
+	typedef gstl::small_vector<tracer_type, 4>	traced_container_type;
+
+	template<class Container>
+	static bool is_inside( const Container& cont )
+	{
+		const char* item = reinterpret_cast<const char*>( &*cont.begin() );
+		const char* object = reinterpret_cast<const char*>( &cont );
+		return item >= object && item < object + sizeof( cont );
+	}
+};
+
+BOOST_FIXTURE_TEST_SUITE( small_vector_test, small_vector_fixture )
+
+	typedef test_class test_value_type;
+	typedef gstl::small_vector<test_value_type, 4>	gstl_small_vector;
+	typedef gstl::small_vector<test_value_type, 2,
+		memory_mgr::allocator<test_value_type, ptr_alloc_mgr> >			memory_mgr_small_vector;
+	typedef gstl::small_vector<test_value_type, 8,
+		memory_mgr::allocator<test_value_type, off_alloc_mgr> >	memory_mgr_off_small_vector;
+
+	typedef boost::mpl::list< gstl_small_vector, memory_mgr_small_vector,
+		memory_mgr_off_small_vector > t_list;
+
+	#include "detail/test_construction.hpp"
+	#include "detail/test_assign_operator.hpp"
+	#include "detail/test_clear.hpp"
+	#include "detail/test_empty.hpp"
+	#include "detail/test_resize.hpp"
+	#include "detail/test_begin_end.hpp"
+	#include "detail/test_swap.hpp"
+	#include "detail/test_erase_iter.hpp"
+	#include "detail/test_erase_range.hpp"
+	#include "detail/test_compare_operators.hpp"
+	#include "detail/test_push_pop_back.hpp"
+	#include "detail/test_back.hpp"
+	#include "detail/test_front.hpp"
+
+	#include "detail/test_access_operators.hpp"
+	#include "detail/test_reserve.hpp"
+
+	#include "detail/test_iterator.hpp"
+
+	BOOST_AUTO_TEST_CASE( test_inline_storage )
+	{
+		traced_container_type vec;
+		BOOST_CHECK( vec.is_inline() );
+		BOOST_CHECK_EQUAL( vec.capacity(), size_t( traced_container_type::inline_capacity ) );
+
+		for( int i = 0; i < traced_container_type::inline_capacity; ++i )
+		{
+			vec.push_back( i );
+		}
+		BOOST_CHECK( vec.is_inline() );
+		BOOST_CHECK( is_inside( vec ) );
+
+		//Spill to the heap
+		vec.push_back( 4 );
+		BOOST_CHECK( !vec.is_inline() );
+		BOOST_CHECK( !is_inside( vec ) );
+		BOOST_CHECK_GT( vec.capacity(), size_t( traced_container_type::inline_capacity ) );
+		for( int i = 0; i < 5; ++i )
+		{
+			BOOST_CHECK_EQUAL( vec[i].value(), i );
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE( test_move_inline_and_heap )
+	{
+		tracer_type::clear();
+		{
+			traced_container_type small( 2, tracer_type( 1 ) );
+			traced_container_type big( 10, tracer_type( 2 ) );
+			BOOST_REQUIRE( small.is_inline() );
+			BOOST_REQUIRE( !big.is_inline() );
+
+			//Heap buffer is taken without touching the items
+			long creations = tracer_type::creations();
+			traced_container_type big2( boost::move( big ) );
+			BOOST_CHECK_EQUAL( tracer_type::creations(), creations );
+			BOOST_CHECK( big.empty() );
+			BOOST_CHECK( big.is_inline() );
+			BOOST_CHECK_EQUAL( big2.size(), 10u );
+
+			//Inline items are moved one by one
+			traced_container_type small2( boost::move( small ) );
+			BOOST_CHECK( small.empty() );
+			BOOST_CHECK( small2.is_inline() );
+			BOOST_REQUIRE_EQUAL( small2.size(), 2u );
+			BOOST_CHECK_EQUAL( small2[1].value(), 1 );
+
+			small2.swap( big2 );
+			BOOST_CHECK_EQUAL( small2.size(), 10u );
+			BOOST_CHECK_EQUAL( big2.size(), 2u );
+			BOOST_CHECK( big2.is_inline() );
+			BOOST_CHECK( is_inside( big2 ) );
+		}
+		BOOST_CHECK_EQUAL( tracer_type::creations(), tracer_type::destructions() );
+		tracer_type::clear();
+	}
+
+	BOOST_AUTO_TEST_CASE( test_move_assign_allocator )
+	{
+		typedef gstl::small_vector<int, 2, tagged_allocator<int> > tagged_vector;
+		{
+			tagged_vector first( tagged_allocator<int>( 1 ) );
+			tagged_vector second( tagged_allocator<int>( 2 ) );
+			for( int i = 0; i < 10; ++i )
+			{
+				first.push_back( i );
+				second.push_back( -i );
+			}
+
+			//Heap block of first is freed by its own allocator,
+			//the block of second comes with the allocator of second
+			first = boost::move( second );
+			BOOST_CHECK_EQUAL( first.get_allocator().base_allocator().id(), 2 );
+			BOOST_REQUIRE_EQUAL( first.size(), 10u );
+			BOOST_CHECK_EQUAL( first[9], -9 );
+			BOOST_CHECK( second.is_inline() );
+
+			//Grows by the taken allocator
+			for( int i = 0; i < 100; ++i )
+			{
+				first.push_back( i );
+			}
+		}
+		BOOST_CHECK( tagged_allocator<int>::owners().empty() );
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,115 @@
+/* 
+Generic STL (genericstl)
+http://genericstl.sourceforge.net/
+Copyright (c) 2007, 2008 Anton (shikin) Matosov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3, 29 June 2007 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA <http://fsf.org/>
+
+
+Please feel free to contact me via e-mail: shikin at users.sourceforge.net
+*/
+
+#include "stdafx.h"
+
+#include <gstl/utf8>
+#include <string.h>
+
+namespace
+{
+	//"hello, ", Russian "privet", Chinese "world" and U+1F600 emoji in UTF-8
+	const char sample[] = "hello, \xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82, \xE4\xB8\x96\xE7\x95\x8C, \xF0\x9F\x98\x80";
+
+	bool valid( const char* str )
+	{
+		return gstl::utf8_validate( str, str + strlen( str ) );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE( utf8_test )
+
+	BOOST_AUTO_TEST_CASE( test_validate )
+	{
+		BOOST_CHECK( valid( "" ) );
+		BOOST_CHECK( valid( "plain ASCII text longer than one SIMD block of 32 bytes" ) );
+		BOOST_CHECK( valid( sample ) );
+		BOOST_CHECK( valid( "\xF4\x8F\xBF\xBF" ) );	//U+10FFFF
+
+		BOOST_CHECK( !valid( "\xC0\xAF" ) );			//overlong '/'
+		BOOST_CHECK( !valid( "\xE0\x80\xAF" ) );		//overlong '/'
+		BOOST_CHECK( !valid( "\xED\xA0\x80" ) );		//surrogate U+D800
+		BOOST_CHECK( !valid( "\xF4\x90\x80\x80" ) );	//U+110000
+		BOOST_CHECK( !valid( "\xE4\xB8" ) );			//truncated
+		BOOST_CHECK( !valid( "\x80" ) );				//stray continuation
+
+		const char text[] = "0123456789abcdefghijklmnopqrstuvwxyz\xFF tail";
+		BOOST_CHECK( gstl::utf8_find_invalid( text, text + sizeof( text ) - 1 ) == text + 36 );
+
+		BOOST_CHECK( gstl::utf8_validate( gstl::string( sample ) ) );
+		BOOST_CHECK( !gstl::utf8_validate( gstl::string_view( "\xFE" ) ) );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_utf16_utf32 )
+	{
+		const char* last = sample + strlen( sample );
+		const size_t length16 = gstl::utf8_to_utf16_length( sample, last );
+		const size_t length32 = gstl::utf8_to_utf32_length( sample, last );
+		//The emoji takes two UTF-16 code units
+		BOOST_CHECK_EQUAL( length16, 21u );
+		BOOST_CHECK_EQUAL( length32, 20u );
+
+		boost::uint16_t utf16[32];
+		BOOST_CHECK( gstl::utf8_to_utf16( sample, last, utf16 ) == utf16 + length16 );
+		BOOST_CHECK_EQUAL( utf16[7], 0x041F );
+		BOOST_CHECK_EQUAL( utf16[19], 0xD83D );
+		BOOST_CHECK_EQUAL( utf16[20], 0xDE00 );
+
+		boost::uint32_t utf32[32];
+		BOOST_CHECK( gstl::utf8_to_utf32( sample, last, utf32 ) == utf32 + length32 );
+		BOOST_CHECK_EQUAL( utf32[19], 0x1F600u );
+
+		char utf8[64];
+		BOOST_CHECK_EQUAL( gstl::utf16_to_utf8_length( utf16, utf16 + length16 ), strlen( sample ) );
+		BOOST_CHECK( std::string( utf8, gstl::utf16_to_utf8( utf16, utf16 + length16, utf8 ) ) == sample );
+		BOOST_CHECK( std::string( utf8, gstl::utf32_to_utf8( utf32, utf32 + length32, utf8 ) ) == sample );
+
+		const boost::uint16_t unpaired[] = { 'a', 0xDC00, 'b' };
+		BOOST_CHECK_THROW( gstl::utf16_to_utf8_length( unpaired, unpaired + 3 ), std::range_error );
+		const char bad[] = "ab\xC3";
+		BOOST_CHECK_THROW( gstl::utf8_to_utf32_length( bad, bad + 3 ), std::range_error );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_wide_strings )
+	{
+		const gstl::wstring wide = gstl::utf8_to_wide( sample );
+		BOOST_CHECK_EQUAL( wide.size(), sizeof( wchar_t ) == 2 ? 21u : 20u );
+		BOOST_CHECK( wide.substr( 0, 7 ) == L"hello, " );
+		BOOST_CHECK( gstl::wide_to_utf8( wide ) == sample );
+
+		gstl::string narrow( "old content" );
+		gstl::wide_to_utf8( wide.data(), wide.data() + wide.size(), narrow );
+		BOOST_CHECK( narrow == sample );
+
+		gstl::detail::wchar_buffer wbuf;
+		gstl::utf8_to_wide( sample, sample + strlen( sample ), wbuf );
+		BOOST_CHECK( wide == wbuf.get() );
+
+		gstl::detail::char_buffer buf;
+		gstl::wide_to_utf8( wide.data(), wide.data() + wide.size(), buf );
+		BOOST_CHECK_EQUAL( strcmp( buf.get(), sample ), 0 );
+
+		BOOST_CHECK_THROW( gstl::utf8_to_wide( gstl::string_view( "\xC3\x28" ) ), std::range_error );
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -25,10 +25,62 @@ Please feel free to contact me via e-mail: shikin at users.sourceforge.net
 
 #include <gstl/vector>
 #include <vector>
+#include <sstream>
+#include <iterator>
 #include "operations_tracer.hpp"
 #include "test_class.hpp"
 #include "managers.hpp"
 
+namespace
+{
+	/**
+	   @brief Counts copies, moves of the items are not counted
+	*/
+	class copy_counter
+	{
+		BOOST_COPYABLE_AND_MOVABLE( copy_counter )
+	public:
+		static long copies;
+
+		explicit copy_counter( int value = 0 )
+			:value_( value )
+		{}
+
+		copy_counter( const copy_counter& rhs )
+			:value_( rhs.value_ )
+		{
+			++copies;
+		}
+
+		copy_counter( BOOST_RV_REF( copy_counter ) rhs )
+			:value_( rhs.value_ )
+		{}
+
+		copy_counter& operator=( BOOST_COPY_ASSIGN_REF( copy_counter ) rhs )
+		{
+			value_ = rhs.value_;
+			++copies;
+			return *this;
+		}
+
+		copy_counter& operator=( BOOST_RV_REF( copy_counter ) rhs )
+		{
+			value_ = rhs.value_;
+			return *this;
+		}
+
+		int value() const
+		{
+			return value_;
+		}
+
+	private:
+		int value_;
+	};
+
+	long copy_counter::copies = 0;
+}
+
 class vector_fixture
 {
 public:
@@ -145,6 +197,263 @@ BOOST_FIXTURE_TEST_SUITE( vector_test, vector_fixture )
 		tracer_type::clear();
 	}
 
+	BOOST_AUTO_TEST_CASE( test_move_and_emplace )
+	{
+		tracer_type::clear();
+		{
+			traced_container_type vec1;
+			vec1.reserve( 4 );
+
+			//Items are constructed in place, no copies
+			vec1.emplace_back( 1 );
+			vec1.emplace_back();
+			vec1.emplace( vec1.end(), 3 );
+			BOOST_CHECK_EQUAL( tracer_type::creations(), 3 );
+			BOOST_CHECK_EQUAL( tracer_type::destructions(), 0 );
+
+			vec1.emplace( vec1.begin(), 7 );
+			BOOST_REQUIRE_EQUAL( vec1.size(), 4u );
+			BOOST_CHECK_EQUAL( vec1[0].value(), 7 );
+			BOOST_CHECK_EQUAL( vec1[1].value(), 1 );
+			BOOST_CHECK_EQUAL( vec1[2].value(), 0 );
+			BOOST_CHECK_EQUAL( vec1[3].value(), 3 );
+
+			//Move constructor steals the buffer
+			long creations = tracer_type::creations();
+			long destructions = tracer_type::destructions();
+			traced_container_type vec2( boost::move( vec1 ) );
+			BOOST_CHECK( vec1.empty() );
+			BOOST_CHECK_EQUAL( vec2.size(), 4u );
+			BOOST_CHECK_EQUAL( tracer_type::creations(), creations );
+			BOOST_CHECK_EQUAL( tracer_type::destructions(), destructions );
+
+			//Move assignment destroys old items only
+			vec1.emplace_back( 5 );
+			creations += 1;
+			vec1 = boost::move( vec2 );
+			destructions += 1;
+			BOOST_CHECK( vec2.empty() );
+			BOOST_REQUIRE_EQUAL( vec1.size(), 4u );
+			BOOST_CHECK_EQUAL( vec1[0].value(), 7 );
+			BOOST_CHECK_EQUAL( tracer_type::creations(), creations );
+			BOOST_CHECK_EQUAL( tracer_type::destructions(), destructions );
+
+			//Emplace of own item during reallocation
+			vec1.emplace_back( vec1[0] );
+			BOOST_REQUIRE_EQUAL( vec1.size(), 5u );
+			BOOST_CHECK_EQUAL( vec1[4].value(), 7 );
+		}
+		BOOST_CHECK_EQUAL( tracer_type::creations(), tracer_type::destructions() );
+		tracer_type::clear();
+	}
+
+	BOOST_AUTO_TEST_CASE( test_erase_moves )
+	{
+		gstl::vector<copy_counter> vec;
+		vec.reserve( 6 );
+		for( int i = 0; i < 6; ++i )
+		{
+			vec.emplace_back( i );
+		}
+
+		//Tail is shifted by move assignments
+		copy_counter::copies = 0;
+		vec.erase( vec.begin() + 1, vec.begin() + 3 );
+		vec.erase( vec.begin() );
+		BOOST_CHECK_EQUAL( copy_counter::copies, 0 );
+
+		int expected[] = { 3, 4, 5 };
+		BOOST_REQUIRE_EQUAL( vec.size(), GSTL_ARRAY_LEN( expected ) );
+		for( size_t i = 0; i < vec.size(); ++i )
+		{
+			BOOST_CHECK_EQUAL( vec[i].value(), expected[i] );
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE( test_insert_in_place )
+	{
+		typedef traced_container_type::value_type value_type;
+		value_type arr[] = { 1, 2, 3, 4, 5 };
+		value_type arr2[] = { 7, 8, 9 };
+
+		traced_container_type vec;
+		vec.reserve( 20 );
+		vec.assign( arr, GSTL_ARRAY_END( arr ) );
+
+		//Suffix is longer than the inserted range
+		tracer_type::clear();
+		vec.insert( vec.begin() + 1, arr2, arr2 + 2 );
+		BOOST_CHECK_EQUAL( tracer_type::creations(), 2 );
+		BOOST_CHECK_EQUAL( tracer_type::assignments(), 4 );
+		BOOST_CHECK_EQUAL( tracer_type::destructions(), 0 );
+
+		int expected1[] = { 1, 7, 8, 2, 3, 4, 5 };
+		BOOST_REQUIRE_EQUAL( vec.size(), GSTL_ARRAY_LEN( expected1 ) );
+		for( size_t i = 0; i < vec.size(); ++i )
+		{
+			BOOST_CHECK_EQUAL( vec[i].value(), expected1[i] );
+		}
+
+		//Suffix is shorter than the inserted range
+		tracer_type::clear();
+		vec.insert( vec.end() - 2, arr2, GSTL_ARRAY_END( arr2 ) );
+		BOOST_CHECK_EQUAL( tracer_type::creations(), 3 );
+		BOOST_CHECK_EQUAL( tracer_type::assignments(), 2 );
+		BOOST_CHECK_EQUAL( tracer_type::destructions(), 0 );
+
+		//Inserted item is a part of the shifted suffix
+		vec.insert( vec.begin(), vec.back() );
+
+		int expected2[] = { 5, 1, 7, 8, 2, 3, 7, 8, 9, 4, 5 };
+		BOOST_REQUIRE_EQUAL( vec.size(), GSTL_ARRAY_LEN( expected2 ) );
+		for( size_t i = 0; i < vec.size(); ++i )
+		{
+			BOOST_CHECK_EQUAL( vec[i].value(), expected2[i] );
+		}
+		tracer_type::clear();
+	}
+
+	BOOST_AUTO_TEST_CASE( test_insert_self_range_in_place )
+	{
+		traced_container_type vec;
+		vec.reserve( 40 );
+		for( int i = 0; i < 10; ++i )
+		{
+			vec.push_back( tracer_type( i ) );
+		}
+
+		//Source range is a part of the shifted suffix
+		vec.insert( vec.begin() + 1, vec.begin() + 5, vec.begin() + 7 );
+		int expected1[] = { 0, 5, 6, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		BOOST_REQUIRE_EQUAL( vec.size(), GSTL_ARRAY_LEN( expected1 ) );
+		for( size_t i = 0; i < vec.size(); ++i )
+		{
+			BOOST_CHECK_EQUAL( vec[i].value(), expected1[i] );
+		}
+
+		//Source range crosses the position, the suffix is shorter than the range
+		vec.insert( vec.end() - 2, vec.begin() + 7, vec.end() );
+		int expected2[] = { 0, 5, 6, 1, 2, 3, 4, 5, 6, 7, 5, 6, 7, 8, 9, 8, 9 };
+		BOOST_REQUIRE_EQUAL( vec.size(), GSTL_ARRAY_LEN( expected2 ) );
+		for( size_t i = 0; i < vec.size(); ++i )
+		{
+			BOOST_CHECK_EQUAL( vec[i].value(), expected2[i] );
+		}
+		BOOST_CHECK( vec.capacity() >= 40u );
+
+		//Items before the position are not shifted
+		gstl::vector<int> ints;
+		ints.reserve( 20 );
+		for( int i = 0; i < 10; ++i )
+		{
+			ints.push_back( i );
+		}
+		ints.insert( ints.begin() + 8, ints.begin() + 1, ints.begin() + 3 );
+		int expected3[] = { 0, 1, 2, 3, 4, 5, 6, 7, 1, 2, 8, 9 };
+		BOOST_CHECK_EQUAL_COLLECTIONS( ints.begin(), ints.end(), expected3, GSTL_ARRAY_END( expected3 ) );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_insert_input_range )
+	{
+		gstl::vector<int> ints;
+		ints.reserve( 20 );
+		for( int i = 0; i < 5; ++i )
+		{
+			ints.push_back( i );
+		}
+		const int* buffer = &ints[0];
+
+		//Items are buffered and moved into the gap once
+		std::istringstream input( "10 11 12" );
+		ints.insert( ints.begin() + 2, std::istream_iterator<int>( input ), std::istream_iterator<int>() );
+		int expected[] = { 0, 1, 10, 11, 12, 2, 3, 4 };
+		BOOST_CHECK_EQUAL_COLLECTIONS( ints.begin(), ints.end(), expected, GSTL_ARRAY_END( expected ) );
+		BOOST_CHECK( &ints[0] == buffer );
+
+		std::istringstream empty( "" );
+		ints.insert( ints.begin(), std::istream_iterator<int>( empty ), std::istream_iterator<int>() );
+		BOOST_CHECK_EQUAL( ints.size(), GSTL_ARRAY_LEN( expected ) );
+	}
+
+	BOOST_AUTO_TEST_CASE( test_append_uninitialized )
+	{
+		typedef gstl::vector<int> int_vector;
+		int arr[] = { 1, 2, 3 };
+
+		int_vector vec( arr, GSTL_ARRAY_END( arr ) );
+		int* appended = vec.append_uninitialized( 100 );
+		BOOST_CHECK_EQUAL( vec.size(), 103u );
+		BOOST_CHECK_EQUAL( appended, &vec[3] );
+		BOOST_CHECK_EQUAL_COLLECTIONS( vec.begin(), vec.begin() + 3, arr, GSTL_ARRAY_END( arr ) );
+
+		for( int i = 0; i < 100; ++i )
+		{
+			appended[i] = i;
+		}
+		BOOST_CHECK_EQUAL( vec.back(), 99 );
+
+		vec.resize_default_init( 2 );
+		BOOST_CHECK_EQUAL( vec.size(), 2u );
+		vec.resize_default_init( 50 );
+		BOOST_CHECK_EQUAL( vec.size(), 50u );
+		BOOST_CHECK_EQUAL( vec[1], 2 );
+	}
+
+	namespace
+	{
+		struct sequence_producer
+		{
+			int next_;
+			size_t limit_;
+
+			sequence_producer( int next, size_t limit )
+				:next_( next ),
+				limit_( limit )
+			{}
+
+			size_t operator()( int* dst, size_t n )
+			{
+				size_t count = (gstl::min)( n, limit_ );
+				for( size_t i = 0; i < count; ++i )
+				{
+					new( dst + i ) int( next_++ );
+				}
+				return count;
+			}
+		};
+	}
+
+	BOOST_AUTO_TEST_CASE( test_append )
+	{
+		typedef gstl::vector<int> int_vector;
+		int arr[] = { 1, 2, 3, 4, 5 };
+
+		int_vector vec;
+		vec.append( arr, GSTL_ARRAY_END( arr ) );
+		BOOST_CHECK_EQUAL_COLLECTIONS( vec.begin(), vec.end(), arr, GSTL_ARRAY_END( arr ) );
+
+		//Own items
+		vec.append( vec.begin(), vec.end() );
+		BOOST_CHECK_EQUAL( vec.size(), 10u );
+		BOOST_CHECK_EQUAL_COLLECTIONS( vec.begin() + 5, vec.end(), arr, GSTL_ARRAY_END( arr ) );
+
+		//Integral arguments mean count and value
+		vec.append( 3, 7 );
+		BOOST_CHECK_EQUAL( vec.size(), 13u );
+		BOOST_CHECK_EQUAL( vec.back(), 7 );
+
+		size_t produced = vec.append_with( 10, sequence_producer( 100, 4 ) );
+		BOOST_CHECK_EQUAL( produced, 4u );
+		BOOST_CHECK_EQUAL( vec.size(), 17u );
+		BOOST_CHECK_EQUAL( vec[13], 100 );
+		BOOST_CHECK_EQUAL( vec.back(), 103 );
+		BOOST_CHECK( vec.capacity() >= 23u );
+
+		produced = vec.append_with( 2, sequence_producer( 0, 10 ) );
+		BOOST_CHECK_EQUAL( produced, 2u );
+		BOOST_CHECK_EQUAL( vec.back(), 1 );
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 